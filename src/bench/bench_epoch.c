@@ -0,0 +1,124 @@
+//standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+//system headers
+#include <pthread.h>
+#include <sched.h>
+
+//test target headers
+#include "../lib/cmore.h"
+
+
+
+/*
+ *  [PIN OVERHEAD]
+ *
+ *     Every thread pins & unpins a fixed number of
+ *     times; with retirement on, each pinned section
+ *     also retires one allocation.
+ *     Usage: bench_epoch [pins per thread]
+ */
+
+
+
+//defaults
+#define BENCH_N       (1 << 22)
+#define BENCH_MAX_THR 64
+
+//globals
+static cm_epoch e;
+static int per_thread;
+static volatile bool go;
+
+struct _bench_arg {
+
+    bool retire;
+};
+
+
+
+/*
+ *  --- [THREADS] ---
+ */
+
+static void * _pinner(void * arg) {
+
+    cm_epoch_thr thr;
+    struct _bench_arg * a = arg;
+
+
+    cm_epoch_reg(&e, &thr);
+    while (!go) sched_yield();
+
+    for (int i = 0; i < per_thread; ++i) {
+
+        cm_epoch_pin(&thr);
+        if (a->retire) cm_epoch_rtr(&thr, malloc(sizeof(int)), free);
+        cm_epoch_unpin(&thr);
+    }
+
+    cm_epoch_rcl(&thr);
+    cm_epoch_unreg(&thr);
+
+    return NULL;
+}
+
+
+
+/*
+ *  --- [DRIVER] ---
+ */
+
+//returns nanoseconds per pin & unpin pair
+static double _run(const int threads, const int total, const bool retire) {
+
+    struct timespec start, end;
+    struct _bench_arg arg = {.retire = retire};
+    pthread_t pinners[BENCH_MAX_THR];
+
+
+    per_thread = total / threads;
+    go = false;
+
+    for (int i = 0; i < threads; ++i) {
+        pthread_create(&pinners[i], NULL, _pinner, &arg);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    go = true;
+
+    for (int i = 0; i < threads; ++i) pthread_join(pinners[i], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return ((end.tv_sec - start.tv_sec) * 1e9
+            + (end.tv_nsec - start.tv_nsec)) / per_thread;
+}
+
+
+
+int main(int argc, char ** argv) {
+
+    int ret, total;
+
+
+    total = argc > 1 ? atoi(argv[1]) : BENCH_N;
+
+    ret = cm_new_epoch(&e);
+    if (ret != 0) {
+        cm_perror("bench_epoch");
+        return -1;
+    }
+
+    printf("%8s %16s %16s\n", "threads", "pin (ns)", "pin+retire (ns)");
+    for (int threads = 1; threads <= BENCH_MAX_THR; threads *= 2) {
+
+        printf("%8d %16.1f", threads, _run(threads, total, false));
+        printf(" %16.1f\n", _run(threads, total, true));
+    }
+
+    cm_del_epoch(&e);
+
+    return 0;
+}
@@ -0,0 +1,163 @@
+//standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+//system headers
+#include <pthread.h>
+#include <sched.h>
+
+//test target headers
+#include "../lib/cmore.h"
+
+
+
+/*
+ *  [MPMC SCALING]
+ *
+ *     Equal numbers of producers & consumers move 
+ *     a fixed number of elements through one queue.
+ *     Usage: bench_que [total elements] [slots]
+ */
+
+
+
+//defaults
+#define BENCH_N       (1 << 22)
+#define BENCH_SLOTS   1024
+#define BENCH_MAX_THR 64
+#define BENCH_BATCH   16
+
+//globals
+static cm_mpmc q;
+static int per_thread;
+static volatile bool go;
+
+struct _bench_arg {
+
+    bool batch;
+};
+
+
+
+/*
+ *  --- [THREADS] ---
+ */
+
+static void * _producer(void * arg) {
+
+    int ret, buf[BENCH_BATCH];
+    struct _bench_arg * a = arg;
+
+
+    while (!go) sched_yield();
+
+    for (int i = 0; i < per_thread; ) {
+
+        if (a->batch) {
+            for (int j = 0; j < BENCH_BATCH; ++j) buf[j] = i + j;
+            ret = cm_mpmc_enq_n(&q, buf, per_thread - i < BENCH_BATCH
+                                         ? per_thread - i : BENCH_BATCH);
+            if (ret == 0) sched_yield();
+            i += ret;
+        } else {
+            cm_mpmc_enq_w(&q, &i);
+            ++i;
+        }
+    }
+
+    return NULL;
+}
+
+
+
+static void * _consumer(void * arg) {
+
+    int ret, buf[BENCH_BATCH];
+    struct _bench_arg * a = arg;
+
+
+    while (!go) sched_yield();
+
+    for (int i = 0; i < per_thread; ) {
+
+        if (a->batch) {
+            ret = cm_mpmc_deq_n(&q, buf, per_thread - i < BENCH_BATCH
+                                         ? per_thread - i : BENCH_BATCH);
+            if (ret == 0) sched_yield();
+            i += ret;
+        } else {
+            cm_mpmc_deq_w(&q, buf);
+            ++i;
+        }
+    }
+
+    return NULL;
+}
+
+
+
+/*
+ *  --- [DRIVER] ---
+ */
+
+//returns elements per second
+static double _run(const int threads, const int total, const bool batch) {
+
+    int pairs;
+    struct timespec start, end;
+    struct _bench_arg arg = {.batch = batch};
+    pthread_t producers[BENCH_MAX_THR / 2], consumers[BENCH_MAX_THR / 2];
+
+
+    pairs = threads / 2;
+    per_thread = total / pairs;
+    go = false;
+
+    for (int i = 0; i < pairs; ++i) {
+        pthread_create(&producers[i], NULL, _producer, &arg);
+        pthread_create(&consumers[i], NULL, _consumer, &arg);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    go = true;
+
+    for (int i = 0; i < pairs; ++i) {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return (double) (per_thread * pairs)
+           / ((end.tv_sec - start.tv_sec)
+              + (end.tv_nsec - start.tv_nsec) / 1e9);
+}
+
+
+
+int main(int argc, char ** argv) {
+
+    int ret, total, slots;
+
+
+    total = argc > 1 ? atoi(argv[1]) : BENCH_N;
+    slots = argc > 2 ? atoi(argv[2]) : BENCH_SLOTS;
+
+    ret = cm_new_mpmc(&q, sizeof(int), slots);
+    if (ret != 0) {
+        cm_perror("bench_que");
+        return -1;
+    }
+
+    printf("%8s %16s %16s\n", "threads", "single (op/s)", "batch (op/s)");
+    //threads run in producer & consumer pairs
+    for (int threads = 2; threads <= BENCH_MAX_THR; threads *= 2) {
+
+        printf("%8d %16.0f", threads, _run(threads, total, false));
+        printf(" %16.0f\n", _run(threads, total, true));
+    }
+
+    cm_del_mpmc(&q);
+
+    return 0;
+}
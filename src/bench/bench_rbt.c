@@ -0,0 +1,154 @@
+//standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+//test target headers
+#include "../lib/cmore.h"
+#include "../lib/cmore_tmpl.h"
+
+
+
+/*
+ *  [KEY KINDS]
+ *
+ *     Random lookups into a tree of 64-bit keys, 
+ *     compared through a compare() function,
+ *     through the built-in integer key kind &
+ *     through a CM_DEFINE_RBT() tree.
+ *     Usage: bench_rbt [keys] [lookups]
+ */
+
+
+
+//defaults
+#define BENCH_KEYS    (1 << 20)
+#define BENCH_LOOKUPS (1 << 22)
+
+CM_DEFINE_RBT(i64, int64_t, int64_t, CM_TMPL_CMP)
+
+
+
+/*
+ *  --- [HELPERS] ---
+ */
+
+static enum cm_rbt_side _compare(const void * a, const void * b) {
+
+    int64_t x = *(int64_t *) a, y = *(int64_t *) b;
+
+    if (x < y) return CM_RBT_LESS;
+    if (x > y) return CM_RBT_MORE;
+    return CM_RBT_EQUAL;
+}
+
+
+
+//xorshift, so both trees see the same key sequence
+static uint64_t _next(uint64_t * state) {
+
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+
+    return *state;
+}
+
+
+
+/*
+ *  --- [DRIVER] ---
+ */
+
+//returns nanoseconds per lookup
+static double _run(cm_rbt * tree, const int keys, const int lookups) {
+
+    int64_t key;
+    uint64_t state;
+    volatile int found = 0;
+    struct timespec start, end;
+
+
+    state = 88172645463325252ull;
+    for (int i = 0; i < keys; ++i) {
+        key = (int64_t) (_next(&state) % ((uint64_t) keys * 2));
+        cm_rbt_set(tree, &key, &key);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int i = 0; i < lookups; ++i) {
+        key = (int64_t) (_next(&state) % ((uint64_t) keys * 2));
+        if (cm_rbt_get_p(tree, &key) != NULL) ++found;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return ((end.tv_sec - start.tv_sec) * 1e9
+            + (end.tv_nsec - start.tv_nsec)) / lookups;
+}
+
+
+
+//as above, through the typed functions
+static double _run_tmpl(cm_rbt_i64 * tree, const int keys, const int lookups) {
+
+    int64_t key;
+    uint64_t state;
+    volatile int found = 0;
+    struct timespec start, end;
+
+
+    state = 88172645463325252ull;
+    for (int i = 0; i < keys; ++i) {
+        key = (int64_t) (_next(&state) % ((uint64_t) keys * 2));
+        cm_rbt_i64_set(tree, &key, &key);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int i = 0; i < lookups; ++i) {
+        key = (int64_t) (_next(&state) % ((uint64_t) keys * 2));
+        if (cm_rbt_i64_get_p(tree, &key) != NULL) ++found;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return ((end.tv_sec - start.tv_sec) * 1e9
+            + (end.tv_nsec - start.tv_nsec)) / lookups;
+}
+
+
+
+int main(int argc, char ** argv) {
+
+    int ret, keys, lookups;
+    cm_rbt fn_tree, kind_tree;
+    cm_rbt_i64 tmpl_tree;
+
+
+    keys    = argc > 1 ? atoi(argv[1]) : BENCH_KEYS;
+    lookups = argc > 2 ? atoi(argv[2]) : BENCH_LOOKUPS;
+
+    cm_new_rbt(&fn_tree, sizeof(int64_t), sizeof(int64_t), _compare);
+    ret = cm_new_rbt_k(&kind_tree, CM_RBT_KEY_I64, 
+                       sizeof(int64_t), sizeof(int64_t));
+    if (ret != 0) {
+        cm_perror("bench_rbt");
+        return -1;
+    }
+    cm_new_rbt_i64(&tmpl_tree);
+
+    printf("%16s %16s %16s\n", 
+           "compare (ns)", "key kind (ns)", "typed (ns)");
+    printf("%16.1f", _run(&fn_tree, keys, lookups));
+    printf(" %16.1f", _run(&kind_tree, keys, lookups));
+    printf(" %16.1f\n", _run_tmpl(&tmpl_tree, keys, lookups));
+
+    cm_del_rbt(&fn_tree);
+    cm_del_rbt(&kind_tree);
+    cm_del_rbt_i64(&tmpl_tree);
+
+    return 0;
+}
@@ -1,9 +1,287 @@
 //standard library
 #include <stdint.h>
+#include <string.h>
+#include <math.h>
 
 //local headers
 #include "cmore.h"
 #include "debug.h"
+#include "alg.h"
+#include "cpu.h"
+
+//SIMD intrinsics
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+
+
+//kernels selected for this CPU
+static struct _alg_kernels _alg_kern;
+
+
+
+/*
+ *  --- [INTERNAL] ---
+ */
+
+/*
+ *  Scalar kernels. These are the fallback when no vector extension is 
+ *  available and also process the tail left over by vector kernels.
+ *
+ *  Clamping evaluates `min(upper, max(lower, value))` such that a NaN 
+ *  passes through unchanged, matching the vector kernels. Min/max 
+ *  kernels accumulate into `min` & `max` and skip NaNs.
+ */
+
+#define ALG_DEF_SCALAR(sfx, type)                                            \
+DBG_STATIC                                                                   \
+void _alg_clamp_##sfx##_scalar(type * arr, const size_t len,                 \
+                               const type lower, const type upper) {         \
+                                                                             \
+    type value;                                                              \
+                                                                             \
+    for (size_t i = 0; i < len; ++i) {                                       \
+        value = arr[i];                                                      \
+        value = lower > value ? lower : value;                               \
+        arr[i] = upper < value ? upper : value;                              \
+    }                                                                        \
+                                                                             \
+    return;                                                                  \
+}                                                                            \
+                                                                             \
+DBG_STATIC                                                                   \
+void _alg_minmax_##sfx##_scalar(const type * arr, const size_t len,          \
+                                type * min, type * max) {                    \
+                                                                             \
+    for (size_t i = 0; i < len; ++i) {                                       \
+        if (arr[i] < *min) *min = arr[i];                                    \
+        if (arr[i] > *max) *max = arr[i];                                    \
+    }                                                                        \
+                                                                             \
+    return;                                                                  \
+}
+
+ALG_DEF_SCALAR(i32, int32_t)
+ALG_DEF_SCALAR(i64, int64_t)
+ALG_DEF_SCALAR(f32, float)
+ALG_DEF_SCALAR(f64, double)
+
+
+
+#ifdef CPU_X86
+
+/*
+ *  Vector kernels, instantiated once per instruction set. Every kernel 
+ *  processes whole vectors with unaligned loads, then hands the tail to 
+ *  the scalar kernel.
+ *
+ *  Operand order matters for floating point: the vector min & max 
+ *  instructions return their second operand if either is NaN. Clamping
+ *  passes the value second so that NaNs propagate; min/max pass the 
+ *  accumulator second so that NaNs are skipped. Accumulators start at the
+ *  identity so a NaN never enters.
+ */
+
+#define ALG_DEF_VECTOR(isa, attr, sfx, type, vec, lanes, loadu, storeu,      \
+                       set1, vmin, vmax, type_min, type_max)                 \
+attr                                                                         \
+DBG_STATIC                                                                   \
+void _alg_clamp_##sfx##_##isa(type * arr, const size_t len,                  \
+                              const type lower, const type upper) {          \
+                                                                             \
+    size_t i;                                                                \
+    vec value;                                                               \
+    const vec lower_v = set1(lower);                                         \
+    const vec upper_v = set1(upper);                                         \
+                                                                             \
+    for (i = 0; i + (lanes) <= len; i += (lanes)) {                          \
+        value = loadu((void *) (arr + i));                                   \
+        value = vmin(upper_v, vmax(lower_v, value));                         \
+        storeu((void *) (arr + i), value);                                   \
+    }                                                                        \
+                                                                             \
+    _alg_clamp_##sfx##_scalar(arr + i, len - i, lower, upper);               \
+                                                                             \
+    return;                                                                  \
+}                                                                            \
+                                                                             \
+attr                                                                         \
+DBG_STATIC                                                                   \
+void _alg_minmax_##sfx##_##isa(const type * arr, const size_t len,           \
+                               type * min, type * max) {                     \
+                                                                             \
+    size_t i;                                                                \
+    vec value;                                                               \
+    vec min_v = set1(type_max);                                              \
+    vec max_v = set1(type_min);                                              \
+    type min_lane[lanes], max_lane[lanes];                                   \
+                                                                             \
+    for (i = 0; i + (lanes) <= len; i += (lanes)) {                          \
+        value = loadu((void *) (arr + i));                                   \
+        min_v = vmin(value, min_v);                                          \
+        max_v = vmax(value, max_v);                                          \
+    }                                                                        \
+                                                                             \
+    /* reduce the tail, then the lanes */                                    \
+    _alg_minmax_##sfx##_scalar(arr + i, len - i, min, max);                  \
+    storeu((void *) min_lane, min_v);                                        \
+    storeu((void *) max_lane, max_v);                                        \
+    for (i = 0; i < (lanes); ++i) {                                          \
+        if (min_lane[i] < *min) *min = min_lane[i];                          \
+        if (max_lane[i] > *max) *max = max_lane[i];                          \
+    }                                                                        \
+                                                                             \
+    return;                                                                  \
+}
+
+
+//integer min/max missing from the base instruction sets
+CPU_TARGET_SSE2
+static inline __m128i _alg_min_epi32_sse2(__m128i a, __m128i b) {
+    __m128i gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+}
+
+CPU_TARGET_SSE2
+static inline __m128i _alg_max_epi32_sse2(__m128i a, __m128i b) {
+    __m128i gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+}
+
+CPU_TARGET_AVX2
+static inline __m256i _alg_min_epi64_avx2(__m256i a, __m256i b) {
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+}
+
+CPU_TARGET_AVX2
+static inline __m256i _alg_max_epi64_avx2(__m256i a, __m256i b) {
+    return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+}
+
+
+//SSE2 (64-bit integers have no usable compare, they stay scalar)
+ALG_DEF_VECTOR(sse2, CPU_TARGET_SSE2, i32, int32_t, __m128i, 4,
+               _mm_loadu_si128, _mm_storeu_si128, _mm_set1_epi32,
+               _alg_min_epi32_sse2, _alg_max_epi32_sse2,
+               INT32_MIN, INT32_MAX)
+ALG_DEF_VECTOR(sse2, CPU_TARGET_SSE2, f32, float, __m128, 4,
+               _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps,
+               _mm_min_ps, _mm_max_ps, -INFINITY, INFINITY)
+ALG_DEF_VECTOR(sse2, CPU_TARGET_SSE2, f64, double, __m128d, 2,
+               _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd,
+               _mm_min_pd, _mm_max_pd, -INFINITY, INFINITY)
+
+//AVX2
+ALG_DEF_VECTOR(avx2, CPU_TARGET_AVX2, i32, int32_t, __m256i, 8,
+               _mm256_loadu_si256, _mm256_storeu_si256, _mm256_set1_epi32,
+               _mm256_min_epi32, _mm256_max_epi32, INT32_MIN, INT32_MAX)
+ALG_DEF_VECTOR(avx2, CPU_TARGET_AVX2, i64, int64_t, __m256i, 4,
+               _mm256_loadu_si256, _mm256_storeu_si256, _mm256_set1_epi64x,
+               _alg_min_epi64_avx2, _alg_max_epi64_avx2,
+               INT64_MIN, INT64_MAX)
+ALG_DEF_VECTOR(avx2, CPU_TARGET_AVX2, f32, float, __m256, 8,
+               _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps,
+               _mm256_min_ps, _mm256_max_ps, -INFINITY, INFINITY)
+ALG_DEF_VECTOR(avx2, CPU_TARGET_AVX2, f64, double, __m256d, 4,
+               _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd,
+               _mm256_min_pd, _mm256_max_pd, -INFINITY, INFINITY)
+
+//AVX-512
+ALG_DEF_VECTOR(avx512, CPU_TARGET_AVX512, i32, int32_t, __m512i, 16,
+               _mm512_loadu_si512, _mm512_storeu_si512, _mm512_set1_epi32,
+               _mm512_min_epi32, _mm512_max_epi32, INT32_MIN, INT32_MAX)
+ALG_DEF_VECTOR(avx512, CPU_TARGET_AVX512, i64, int64_t, __m512i, 8,
+               _mm512_loadu_si512, _mm512_storeu_si512, _mm512_set1_epi64,
+               _mm512_min_epi64, _mm512_max_epi64, INT64_MIN, INT64_MAX)
+ALG_DEF_VECTOR(avx512, CPU_TARGET_AVX512, f32, float, __m512, 16,
+               _mm512_loadu_ps, _mm512_storeu_ps, _mm512_set1_ps,
+               _mm512_min_ps, _mm512_max_ps, -INFINITY, INFINITY)
+ALG_DEF_VECTOR(avx512, CPU_TARGET_AVX512, f64, double, __m512d, 8,
+               _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd,
+               _mm512_min_pd, _mm512_max_pd, -INFINITY, INFINITY)
+
+#endif
+
+
+
+//point the kernel table at the variants for an instruction set level
+DBG_STATIC
+void _alg_dispatch(const enum cm_cpu_lvl lvl) {
+
+    //scalar kernels work everywhere
+    _alg_kern.clamp_i32  = _alg_clamp_i32_scalar;
+    _alg_kern.clamp_i64  = _alg_clamp_i64_scalar;
+    _alg_kern.clamp_f32  = _alg_clamp_f32_scalar;
+    _alg_kern.clamp_f64  = _alg_clamp_f64_scalar;
+    _alg_kern.minmax_i32 = _alg_minmax_i32_scalar;
+    _alg_kern.minmax_i64 = _alg_minmax_i64_scalar;
+    _alg_kern.minmax_f32 = _alg_minmax_f32_scalar;
+    _alg_kern.minmax_f64 = _alg_minmax_f64_scalar;
+
+#ifdef CPU_X86
+    if (lvl >= CM_CPU_SSE2) {
+        _alg_kern.clamp_i32  = _alg_clamp_i32_sse2;
+        _alg_kern.clamp_f32  = _alg_clamp_f32_sse2;
+        _alg_kern.clamp_f64  = _alg_clamp_f64_sse2;
+        _alg_kern.minmax_i32 = _alg_minmax_i32_sse2;
+        _alg_kern.minmax_f32 = _alg_minmax_f32_sse2;
+        _alg_kern.minmax_f64 = _alg_minmax_f64_sse2;
+    }
+
+    if (lvl >= CM_CPU_AVX2) {
+        _alg_kern.clamp_i32  = _alg_clamp_i32_avx2;
+        _alg_kern.clamp_i64  = _alg_clamp_i64_avx2;
+        _alg_kern.clamp_f32  = _alg_clamp_f32_avx2;
+        _alg_kern.clamp_f64  = _alg_clamp_f64_avx2;
+        _alg_kern.minmax_i32 = _alg_minmax_i32_avx2;
+        _alg_kern.minmax_i64 = _alg_minmax_i64_avx2;
+        _alg_kern.minmax_f32 = _alg_minmax_f32_avx2;
+        _alg_kern.minmax_f64 = _alg_minmax_f64_avx2;
+    }
+
+    if (lvl >= CM_CPU_AVX512) {
+        _alg_kern.clamp_i32  = _alg_clamp_i32_avx512;
+        _alg_kern.clamp_i64  = _alg_clamp_i64_avx512;
+        _alg_kern.clamp_f32  = _alg_clamp_f32_avx512;
+        _alg_kern.clamp_f64  = _alg_clamp_f64_avx512;
+        _alg_kern.minmax_i32 = _alg_minmax_i32_avx512;
+        _alg_kern.minmax_i64 = _alg_minmax_i64_avx512;
+        _alg_kern.minmax_f32 = _alg_minmax_f32_avx512;
+        _alg_kern.minmax_f64 = _alg_minmax_f64_avx512;
+    }
+#endif
+
+    return;
+}
+
+
+
+__attribute__((constructor))
+DBG_STATIC
+void _alg_init() {
+
+    _cpu_register(_alg_dispatch);
+
+    return;
+}
+
+
+
+//size of an element of each array type
+DBG_STATIC DBG_INLINE
+size_t _alg_type_sz(const enum cm_alg_type type) {
+
+    switch (type) {
+        case CM_ALG_I32: return sizeof(int32_t);
+        case CM_ALG_I64: return sizeof(int64_t);
+        case CM_ALG_F32: return sizeof(float);
+        case CM_ALG_F64: return sizeof(double);
+    }
+
+    return 0;
+}
+
 
 
 /*
@@ -16,3 +294,252 @@ long cm_clamp(const long value, const long lower, const long upper) {
     if (value > upper) return upper;
     return value;
 }
+
+
+
+// [clamp]
+
+void cm_clamp_i32(int32_t * arr, const size_t len,
+                  const int32_t lower, const int32_t upper) {
+
+    _alg_kern.clamp_i32(arr, len, lower, upper);
+    return;
+}
+
+
+
+void cm_clamp_i64(int64_t * arr, const size_t len,
+                  const int64_t lower, const int64_t upper) {
+
+    _alg_kern.clamp_i64(arr, len, lower, upper);
+    return;
+}
+
+
+
+void cm_clamp_f32(float * arr, const size_t len,
+                  const float lower, const float upper) {
+
+    _alg_kern.clamp_f32(arr, len, lower, upper);
+    return;
+}
+
+
+
+void cm_clamp_f64(double * arr, const size_t len,
+                  const double lower, const double upper) {
+
+    _alg_kern.clamp_f64(arr, len, lower, upper);
+    return;
+}
+
+
+
+// [min & max]
+
+void cm_minmax_i32(const int32_t * arr, const size_t len,
+                   int32_t * min, int32_t * max) {
+
+    *min = INT32_MAX;
+    *max = INT32_MIN;
+    _alg_kern.minmax_i32(arr, len, min, max);
+
+    return;
+}
+
+
+
+void cm_minmax_i64(const int64_t * arr, const size_t len,
+                   int64_t * min, int64_t * max) {
+
+    *min = INT64_MAX;
+    *max = INT64_MIN;
+    _alg_kern.minmax_i64(arr, len, min, max);
+
+    return;
+}
+
+
+
+void cm_minmax_f32(const float * arr, const size_t len,
+                   float * min, float * max) {
+
+    *min = INFINITY;
+    *max = -INFINITY;
+    _alg_kern.minmax_f32(arr, len, min, max);
+
+    return;
+}
+
+
+
+void cm_minmax_f64(const double * arr, const size_t len,
+                   double * min, double * max) {
+
+    *min = INFINITY;
+    *max = -INFINITY;
+    _alg_kern.minmax_f64(arr, len, min, max);
+
+    return;
+}
+
+
+
+int32_t cm_min_i32(const int32_t * arr, const size_t len) {
+
+    int32_t min, max;
+
+    cm_minmax_i32(arr, len, &min, &max);
+    return min;
+}
+
+
+
+int64_t cm_min_i64(const int64_t * arr, const size_t len) {
+
+    int64_t min, max;
+
+    cm_minmax_i64(arr, len, &min, &max);
+    return min;
+}
+
+
+
+float cm_min_f32(const float * arr, const size_t len) {
+
+    float min, max;
+
+    cm_minmax_f32(arr, len, &min, &max);
+    return min;
+}
+
+
+
+double cm_min_f64(const double * arr, const size_t len) {
+
+    double min, max;
+
+    cm_minmax_f64(arr, len, &min, &max);
+    return min;
+}
+
+
+
+int32_t cm_max_i32(const int32_t * arr, const size_t len) {
+
+    int32_t min, max;
+
+    cm_minmax_i32(arr, len, &min, &max);
+    return max;
+}
+
+
+
+int64_t cm_max_i64(const int64_t * arr, const size_t len) {
+
+    int64_t min, max;
+
+    cm_minmax_i64(arr, len, &min, &max);
+    return max;
+}
+
+
+
+float cm_max_f32(const float * arr, const size_t len) {
+
+    float min, max;
+
+    cm_minmax_f32(arr, len, &min, &max);
+    return max;
+}
+
+
+
+double cm_max_f64(const double * arr, const size_t len) {
+
+    double min, max;
+
+    cm_minmax_f64(arr, len, &min, &max);
+    return max;
+}
+
+
+
+// [vector]
+
+int cm_clamp_vct(cm_vct * vector, const enum cm_alg_type type,
+                 const void * lower, const void * upper) {
+
+    //elements must be of the requested type
+    if (vector->data_sz != _alg_type_sz(type)) {
+        cm_errno = CM_ERR_USER_TYPE;
+        return -1;
+    }
+
+    switch (type) {
+        case CM_ALG_I32:
+            cm_clamp_i32(vector->data, (size_t) vector->len,
+                         *(const int32_t *) lower, *(const int32_t *) upper);
+            break;
+        case CM_ALG_I64:
+            cm_clamp_i64(vector->data, (size_t) vector->len,
+                         *(const int64_t *) lower, *(const int64_t *) upper);
+            break;
+        case CM_ALG_F32:
+            cm_clamp_f32(vector->data, (size_t) vector->len,
+                         *(const float *) lower, *(const float *) upper);
+            break;
+        case CM_ALG_F64:
+            cm_clamp_f64(vector->data, (size_t) vector->len,
+                         *(const double *) lower, *(const double *) upper);
+            break;
+    }
+
+    return 0;
+}
+
+
+
+int cm_minmax_vct(const cm_vct * vector, const enum cm_alg_type type,
+                  void * min, void * max) {
+
+    cm_byte min_buf[sizeof(int64_t)], max_buf[sizeof(int64_t)];
+
+
+    //elements must be of the requested type
+    if (vector->data_sz != _alg_type_sz(type)) {
+        cm_errno = CM_ERR_USER_TYPE;
+        return -1;
+    }
+
+    //an empty vector has no minimum or maximum
+    if (vector->len == 0) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return -1;
+    }
+
+    switch (type) {
+        case CM_ALG_I32:
+            cm_minmax_i32(vector->data, (size_t) vector->len,
+                          (int32_t *) min_buf, (int32_t *) max_buf);
+            break;
+        case CM_ALG_I64:
+            cm_minmax_i64(vector->data, (size_t) vector->len,
+                          (int64_t *) min_buf, (int64_t *) max_buf);
+            break;
+        case CM_ALG_F32:
+            cm_minmax_f32(vector->data, (size_t) vector->len,
+                          (float *) min_buf, (float *) max_buf);
+            break;
+        case CM_ALG_F64:
+            cm_minmax_f64(vector->data, (size_t) vector->len,
+                          (double *) min_buf, (double *) max_buf);
+            break;
+    }
+
+    //either result may be omitted
+    if (min != NULL) memcpy(min, min_buf, vector->data_sz);
+    if (max != NULL) memcpy(max, max_buf, vector->data_sz);
+
+    return 0;
+}
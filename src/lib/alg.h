@@ -1,6 +1,9 @@
 #ifndef ALG_H
 #define ALG_H
 
+//standard library
+#include <stdint.h>
+
 //local headers
 #include "cmore.h"
 #include "debug.h"
@@ -8,7 +11,79 @@
 
 // -- [algorithms]
 
+//array kernels selected at load time
+struct _alg_kernels {
+
+    void (* clamp_i32)(int32_t *, const size_t, const int32_t, const int32_t);
+    void (* clamp_i64)(int64_t *, const size_t, const int64_t, const int64_t);
+    void (* clamp_f32)(float *, const size_t, const float, const float);
+    void (* clamp_f64)(double *, const size_t, const double, const double);
+
+    void (* minmax_i32)(const int32_t *, const size_t, int32_t *, int32_t *);
+    void (* minmax_i64)(const int64_t *, const size_t, int64_t *, int64_t *);
+    void (* minmax_f32)(const float *, const size_t, float *, float *);
+    void (* minmax_f64)(const double *, const size_t, double *, double *);
+};
+
+
+#ifdef CM_DEBUG
+//internal
+void _alg_clamp_i32_scalar(int32_t * arr, const size_t len,
+                           const int32_t lower, const int32_t upper);
+void _alg_clamp_i64_scalar(int64_t * arr, const size_t len,
+                           const int64_t lower, const int64_t upper);
+void _alg_clamp_f32_scalar(float * arr, const size_t len,
+                           const float lower, const float upper);
+void _alg_clamp_f64_scalar(double * arr, const size_t len,
+                           const double lower, const double upper);
+void _alg_minmax_i32_scalar(const int32_t * arr, const size_t len,
+                            int32_t * min, int32_t * max);
+void _alg_minmax_i64_scalar(const int64_t * arr, const size_t len,
+                            int64_t * min, int64_t * max);
+void _alg_minmax_f32_scalar(const float * arr, const size_t len,
+                            float * min, float * max);
+void _alg_minmax_f64_scalar(const double * arr, const size_t len,
+                            double * min, double * max);
+void _alg_dispatch(const enum cm_cpu_lvl lvl);
+void _alg_init();
+size_t _alg_type_sz(const enum cm_alg_type type);
+#endif
+
+
 //external
 long cm_clamp(const long value, const long lower, const long upper);
 
+void cm_clamp_i32(int32_t * arr, const size_t len,
+                  const int32_t lower, const int32_t upper);
+void cm_clamp_i64(int64_t * arr, const size_t len,
+                  const int64_t lower, const int64_t upper);
+void cm_clamp_f32(float * arr, const size_t len,
+                  const float lower, const float upper);
+void cm_clamp_f64(double * arr, const size_t len,
+                  const double lower, const double upper);
+
+void cm_minmax_i32(const int32_t * arr, const size_t len,
+                   int32_t * min, int32_t * max);
+void cm_minmax_i64(const int64_t * arr, const size_t len,
+                   int64_t * min, int64_t * max);
+void cm_minmax_f32(const float * arr, const size_t len,
+                   float * min, float * max);
+void cm_minmax_f64(const double * arr, const size_t len,
+                   double * min, double * max);
+
+int32_t cm_min_i32(const int32_t * arr, const size_t len);
+int64_t cm_min_i64(const int64_t * arr, const size_t len);
+float cm_min_f32(const float * arr, const size_t len);
+double cm_min_f64(const double * arr, const size_t len);
+
+int32_t cm_max_i32(const int32_t * arr, const size_t len);
+int64_t cm_max_i64(const int64_t * arr, const size_t len);
+float cm_max_f32(const float * arr, const size_t len);
+double cm_max_f64(const double * arr, const size_t len);
+
+int cm_clamp_vct(cm_vct * vector, const enum cm_alg_type type,
+                 const void * lower, const void * upper);
+int cm_minmax_vct(const cm_vct * vector, const enum cm_alg_type type,
+                  void * min, void * max);
+
 #endif
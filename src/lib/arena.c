@@ -0,0 +1,143 @@
+//standard library
+#include <stdlib.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "arena.h"
+
+
+
+/*
+ *  --- [ARENA - INTERNAL] ---
+ */
+
+DBG_STATIC DBG_INLINE
+size_t _arena_align(const size_t sz) {
+
+    return (sz + (ARENA_ALIGN - 1)) & ~((size_t) ARENA_ALIGN - 1);
+}
+
+
+
+DBG_STATIC
+cm_arena_blk * _arena_new_blk(const size_t sz) {
+
+    //allocate the header & the usable space together
+    cm_arena_blk * blk = aligned_alloc(ARENA_ALIGN, ARENA_HDR_SZ + sz);
+    if (blk == NULL) {
+        cm_errno = CM_ERR_MALLOC;
+        return NULL;
+    }
+
+    blk->next = NULL;
+    blk->sz   = sz;
+
+    return blk;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+void * _arena_blk_data(const cm_arena_blk * blk) {
+
+    return (cm_byte *) blk + ARENA_HDR_SZ;
+}
+
+
+
+/*
+ *  --- [ARENA - EXTERNAL] ---
+ */
+
+void * cm_arena_alloc(cm_arena * arena, const size_t sz) {
+
+    void * data;
+    size_t align_sz;
+    cm_arena_blk * blk;
+
+
+    align_sz = _arena_align(sz);
+
+    //allocate from the current block if there is space
+    if (arena->off + align_sz <= arena->cur->sz) {
+
+        data = (cm_byte *) _arena_blk_data(arena->cur) + arena->off;
+        arena->off += align_sz;
+
+        return data;
+    }
+
+    //reuse the next block if it was kept from before a reset
+    if (arena->cur->next != NULL && arena->cur->next->sz >= align_sz) {
+
+        blk = arena->cur->next;
+
+    //else link in a new block after the current one
+    } else {
+
+        blk = _arena_new_blk(align_sz > arena->blk_sz 
+                             ? align_sz : arena->blk_sz);
+        if (blk == NULL) return NULL;
+
+        blk->next = arena->cur->next;
+        arena->cur->next = blk;
+    }
+
+    arena->cur = blk;
+    arena->off = align_sz;
+
+    return _arena_blk_data(blk);
+}
+
+
+
+void cm_arena_rst(cm_arena * arena) {
+
+    arena->cur = arena->head;
+    arena->off = 0;
+
+    return;
+}
+
+
+
+int cm_new_arena(cm_arena * arena, const size_t blk_sz) {
+
+    arena->blk_sz = _arena_align(blk_sz);
+
+    //allocate the first block
+    arena->head = _arena_new_blk(arena->blk_sz);
+    if (arena->head == NULL) return -1;
+
+    arena->cur = arena->head;
+    arena->off = 0;
+    arena->is_init = true;
+
+    return 0;
+}
+
+
+
+void cm_del_arena(cm_arena * arena) {
+
+    cm_arena_blk * blk, * next_blk;
+
+
+    //free every block
+    blk = arena->head;
+    while (blk != NULL) {
+
+        next_blk = blk->next;
+        free(blk);
+        blk = next_blk;
+    }
+
+    arena->head = arena->cur = NULL;
+    arena->is_init = false;
+
+    return;
+}
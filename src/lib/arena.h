@@ -0,0 +1,37 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+
+
+// -- [arena]
+
+//alignment of every allocation
+#define ARENA_ALIGN 16
+
+//size of a block header, rounded up to the allocation alignment
+#define ARENA_HDR_SZ \
+    ((sizeof(cm_arena_blk) + (ARENA_ALIGN - 1)) & ~((size_t) ARENA_ALIGN - 1))
+
+
+#ifdef CM_DEBUG
+//internal
+size_t _arena_align(const size_t sz);
+cm_arena_blk * _arena_new_blk(const size_t sz);
+void * _arena_blk_data(const cm_arena_blk * blk);
+#endif
+
+
+//external
+void * cm_arena_alloc(cm_arena * arena, const size_t sz);
+void cm_arena_rst(cm_arena * arena);
+
+int cm_new_arena(cm_arena * arena, const size_t blk_sz);
+void cm_del_arena(cm_arena * arena);
+
+#endif
@@ -7,10 +7,15 @@ extern "C"{
 
 //standard library
 #include <stdbool.h>
+#include <stdint.h>
 #include <limits.h>
+#ifdef CM_CHECK_BOUNDS
+#include <assert.h>
+#endif
 
 //system headers
 #include <unistd.h>
+#include <pthread.h>
 #include <linux/limits.h>
 
 
@@ -25,6 +30,34 @@ typedef unsigned char cm_byte;
 
 
 
+// [iteration]
+//largest batch handed to batched list & tree iteration callbacks
+#define CM_ITER_BATCH 32
+
+/*
+ *  Batched iteration amortises the callback over many elements: vectors 
+ *  pass contiguous spans, lists & trees pass arrays of up to CM_ITER_BATCH
+ *  data (& key) pointers, gathered in order before each call.
+ */
+
+
+
+// [deferred free]
+typedef struct {
+
+    void (* retire)(void * ctx, void * ptr, void (* del)(void *));
+    void * ctx;
+
+} cm_del_hook;
+
+/*
+ *  Lists & trees free removed nodes immediately unless their `del_hook`
+ *  is set. Then each node is passed to retire(), which must call del(ptr)
+ *  once no thread can still reach it. cm_epoch provides such a hook.
+ */
+
+
+
 // [list]
 struct _cm_lst_node {
 
@@ -41,6 +74,7 @@ typedef struct {
     int len;
     size_t data_sz;
     cm_lst_node * head;
+    const cm_del_hook * del_hook;   //NULL frees nodes immediately
     bool is_init;
 
 } cm_lst;
@@ -58,6 +92,196 @@ typedef struct {
 
 } cm_vct;
 
+/*
+ *  cm_vct_iter_par() & cm_vct_rdc_par() split vectors longer than `grain`
+ *  into chunks run on cm_pool_def(); callbacks run concurrently & in no
+ *  particular order. For reductions `acc` must hold the identity on entry:
+ *  each chunk folds its elements into a copy of it with `map`, then the 
+ *  copies are folded into `acc` with `combine`, in vector order.
+ */
+
+
+
+// [deque]
+typedef struct {
+
+    int len;       //number of elements used
+    size_t sz;     //number of elements allocated, a power of two
+    size_t data_sz;
+    size_t head;   //slot of the front element
+    void * data;
+    bool is_init;
+
+} cm_deq;
+
+/*
+ *  Deques are ring buffers. Indeces follow the same convention as 
+ *  vectors: negative indeces count back from the back of the deque. Bulk
+ *  pushes & pops keep the order of elements in the buffer passed, e.g. 
+ *  after cm_deq_psh_f_n() the first element of `data` is at the front.
+ */
+
+
+
+// [concurrent queues]
+#define CM_CACHE_LINE 64
+
+typedef struct {
+
+    //consumer's line
+    size_t head __attribute__((aligned(CM_CACHE_LINE)));
+    size_t tail_cache; //consumer's last seen `tail`
+
+    //producer's line
+    size_t tail __attribute__((aligned(CM_CACHE_LINE)));
+    size_t head_cache; //producer's last seen `head`
+
+    //read-only after creation
+    size_t sz __attribute__((aligned(CM_CACHE_LINE))); //power of two
+    size_t data_sz;
+    void * data;
+    bool is_init;
+
+} cm_spsc;
+
+/*
+ *  A cm_spsc is a bounded ring safe for exactly one producer thread & one
+ *  consumer thread. The producer may call only the enq & rsv/cmt family,
+ *  the consumer only the deq & pek/rls family.
+ *
+ *  Zero-copy access hands out contiguous runs of slots: cm_spsc_rsv() & 
+ *  cm_spsc_pek() may return fewer slots than requested when the run 
+ *  reaches the end of the ring; call them again for the remainder. Slots
+ *  become visible to the other side only on cm_spsc_cmt() / cm_spsc_rls().
+ */
+
+
+typedef struct {
+
+    size_t enq_pos __attribute__((aligned(CM_CACHE_LINE)));
+    size_t deq_pos __attribute__((aligned(CM_CACHE_LINE)));
+
+    //futex words & sleeper counts for the blocking calls
+    uint32_t not_empty __attribute__((aligned(CM_CACHE_LINE)));
+    uint32_t deq_wait;
+    uint32_t not_full __attribute__((aligned(CM_CACHE_LINE)));
+    uint32_t enq_wait;
+
+    //read-only after creation
+    size_t sz __attribute__((aligned(CM_CACHE_LINE))); //power of two
+    size_t data_sz;
+    size_t slot_sz;    //data_sz plus the slot's sequence number
+    void * slots;
+    bool is_init;
+
+} cm_mpmc;
+
+/*
+ *  A cm_mpmc is a bounded ring safe for any number of producer & consumer
+ *  threads. Elements are stored inline next to a per-slot sequence number.
+ *  cm_mpmc_enq() & cm_mpmc_deq() fail immediately when the queue is full or
+ *  empty, the _w variants sleep until they succeed. Bulk calls transfer as
+ *  many elements as are available, up to `n`, & never block for long.
+ */
+
+
+
+// [thread pool]
+typedef struct {
+
+    uint32_t pending;  //outstanding tasks
+    bool failed;       //a task returned non-zero
+
+} cm_pool_grp;
+
+
+typedef struct {
+
+    int (* fn)(void * ctx);
+    void * ctx;
+    cm_pool_grp * grp;
+
+} cm_pool_task;
+
+
+struct _cm_pool_worker;
+
+typedef struct {
+
+    //futex word & sleeper count of idle workers
+    uint32_t wake __attribute__((aligned(CM_CACHE_LINE)));
+    uint32_t idle;
+    bool stop;
+
+    //read-only after creation
+    int workers_n __attribute__((aligned(CM_CACHE_LINE)));
+    struct _cm_pool_worker * workers;
+    cm_mpmc /* <cm_pool_task *> */ inject; //tasks spawned by non-workers
+    bool is_init;
+
+} cm_pool;
+
+/*
+ *  A cm_pool runs fork/join tasks on worker threads that steal from each
+ *  other's deques. cm_pool_spawn() queues `fn(ctx)` as part of a group; the
+ *  caller owns `task` & must keep it alive until cm_pool_sync() on its 
+ *  group returns. cm_pool_sync() runs queued tasks while it waits, so 
+ *  tasks may spawn & sync groups of their own.
+ *
+ *  Passing 0 workers to cm_new_pool() sizes the pool with cm_pool_cpus(),
+ *  the number of CPUs this process may use, including any cgroup CPU quota.
+ *  cm_pool_def() returns a pool of that size shared by the library's 
+ *  parallel algorithms, created on first use.
+ */
+
+
+
+// [epoch reclamation]
+struct _cm_epoch;
+
+struct _cm_epoch_thr {
+
+    uint64_t local __attribute__((aligned(CM_CACHE_LINE))); //pinned epoch
+    int pins;                        //nested pins
+
+    cm_vct /* <struct _cm_epoch_entry> */ retired;
+    struct _cm_epoch * epoch;
+    struct _cm_epoch_thr * next;      //registered threads of the domain
+    struct _cm_epoch_thr * self_next; //this thread's other domains
+};
+typedef struct _cm_epoch_thr cm_epoch_thr;
+
+
+typedef struct _cm_epoch {
+
+    uint64_t global __attribute__((aligned(CM_CACHE_LINE)));
+    cm_del_hook hook;                //retires into this domain
+
+    //registry
+    pthread_mutex_t lock __attribute__((aligned(CM_CACHE_LINE)));
+    cm_epoch_thr * thrs;
+    cm_vct /* <struct _cm_epoch_entry> */ orphans;
+    bool is_init;
+
+} cm_epoch;
+
+/*
+ *  A cm_epoch is a domain for epoch-based reclamation. Each thread
+ *  registers a cm_epoch_thr with it & wraps every access to shared nodes
+ *  in cm_epoch_pin() & cm_epoch_unpin(); pins nest. A node unlinked by
+ *  a writer is passed to cm_epoch_rtr() & freed once every thread that
+ *  could have seen it has unpinned. Threads reclaim in batches, or
+ *  whenever they call cm_epoch_rcl() outside a pinned section.
+ *
+ *  Point a list's or tree's `del_hook` at the domain's `hook` to have 
+ *  its removed nodes retired instead of freed. Threads that retire
+ *  without registering hand their nodes to the domain.
+ *
+ *  A cm_epoch_thr must be unregistered by the thread that registered it,
+ *  & every thread must unregister before the domain is destroyed. Don't
+ *  move a cm_epoch after creating it.
+ */
+
 
 
 // [red-black tree]
@@ -67,7 +291,56 @@ enum cm_rbt_side {CM_RBT_LESS,
                   CM_RBT_MORE,
                   CM_RBT_ROOT};
 
+//how keys are compared, see cm_new_rbt_k()
+enum cm_rbt_key {
+
+    CM_RBT_KEY_FN,  //user compare() function
+    CM_RBT_KEY_I32, //int32_t
+    CM_RBT_KEY_U32, //uint32_t
+    CM_RBT_KEY_I64, //int64_t
+    CM_RBT_KEY_U64, //uint64_t
+    CM_RBT_KEY_F64, //double, NaN keys are not ordered
+    CM_RBT_KEY_MEM  //`key_sz` bytes ordered by memcmp()
+};
+
+
+/*
+ *  Building with CM_RBT_COMPACT packs the colour & parent side into the
+ *  low bits of the parent pointer, & stores the key & data in the same
+ *  allocation as the node. The header shrinks from 56 to 40 bytes & each
+ *  node takes one allocation instead of three. Read the packed fields
+ *  through the CM_RBT_PARENT(), CM_RBT_SIDE() & CM_RBT_COLOUR() macros,
+ *  which work with either layout. `make install` & `make package` write
+ *  the define into the copied header, so programs built against it agree
+ *  with the library on the node layout.
+ */
+
+#ifdef CM_RBT_COMPACT
+struct _cm_rbt_node {
+
+    void * key;
+    void * data;
+
+    struct _cm_rbt_node * left;
+    struct _cm_rbt_node * right;
+
+    uintptr_t parent_bits; //parent | parent side << 1 | colour
+};
+
+#define CM_RBT_COLOUR_MASK ((uintptr_t) 0x1)
+#define CM_RBT_SIDE_MASK   ((uintptr_t) 0x6)
+#define CM_RBT_SIDE_SHIFT  1
+#define CM_RBT_PARENT_MASK (~(uintptr_t) 0x7)
 
+#define CM_RBT_PARENT(node) \
+    ((struct _cm_rbt_node *) ((node)->parent_bits & CM_RBT_PARENT_MASK))
+#define CM_RBT_SIDE(node) \
+    ((enum cm_rbt_side) (((node)->parent_bits & CM_RBT_SIDE_MASK) \
+                         >> CM_RBT_SIDE_SHIFT))
+#define CM_RBT_COLOUR(node) \
+    ((enum cm_rbt_colour) ((node)->parent_bits & CM_RBT_COLOUR_MASK))
+
+#else
 struct _cm_rbt_node {
 
     void * key;
@@ -81,6 +354,11 @@ struct _cm_rbt_node {
 
     enum cm_rbt_colour colour; 
 };
+
+#define CM_RBT_PARENT(node) ((node)->parent)
+#define CM_RBT_SIDE(node)   ((node)->parent_side)
+#define CM_RBT_COLOUR(node) ((node)->colour)
+#endif
 typedef struct _cm_rbt_node cm_rbt_node;
 
 
@@ -90,9 +368,11 @@ typedef struct {
     size_t key_sz;
     size_t data_sz;
     cm_rbt_node * root;
+    const cm_del_hook * del_hook;   //NULL frees nodes immediately
+    enum cm_rbt_key key_kind;
     bool is_init;
 
-    enum cm_rbt_side (*compare)(const void *, const void *);
+    enum cm_rbt_side (*compare)(const void *, const void *); //NULL if built-in
 
 } cm_rbt;
 
@@ -110,12 +390,203 @@ typedef struct {
 
 
 
+// [concurrent red-black tree]
+struct _cm_crbt_slot;
+
+typedef struct {
+
+    uint32_t seq __attribute__((aligned(CM_CACHE_LINE))); //odd during writes
+    uint32_t parity;                //grace period new readers enter under
+    cm_rbt tree;
+    struct _cm_crbt_slot * slots;   //readers in the tree, per thread group
+
+    //writer only
+    pthread_mutex_t lock __attribute__((aligned(CM_CACHE_LINE)));
+    cm_vct /* <cm_rbt_node *> */ retired;
+    bool is_init;
+
+} cm_crbt;
+
+/*
+ *  A cm_crbt wraps a red-black tree for many reader threads & any number
+ *  of writer threads. Readers never lock: cm_crbt_get() walks the tree &
+ *  retries if a write overlapped it. Writers serialise on a mutex. Removed
+ *  nodes are freed in batches, once every reader that could still see 
+ *  them has left; cm_crbt_rcl() frees them immediately.
+ *
+ *  `buf` of cm_crbt_get() may be overwritten even if the key is missing.
+ *  Don't access the inner `tree` directly while other threads use it.
+ */
+
+
+
+// [persistent red-black tree]
+struct _cm_prbt_node {
+
+    void * key;
+    void * data;
+
+    struct _cm_prbt_node * left;
+    struct _cm_prbt_node * right;
+
+    uint32_t refs;                  //versions & nodes pointing here
+    enum cm_rbt_colour colour;
+};
+typedef struct _cm_prbt_node cm_prbt_node;
+
+
+typedef struct {
+
+    cm_prbt_node * root __attribute__((aligned(CM_CACHE_LINE))); //published
+    uint32_t parity;                //grace period new readers enter under
+    struct _cm_crbt_slot * slots;   //readers taking a snapshot
+
+    size_t key_sz;
+    size_t data_sz;
+    enum cm_rbt_side (*compare)(const void *, const void *);
+
+    //publishers only
+    pthread_mutex_t lock __attribute__((aligned(CM_CACHE_LINE)));
+    bool is_init;
+
+} cm_prbt;
+
+/*
+ *  A cm_prbt holds immutable versions of a red-black tree. A version is
+ *  its root node; NULL is the empty version. cm_prbt_set() & 
+ *  cm_prbt_rmv() copy only the root-to-leaf path & return a new version
+ *  that shares every other node with the old one, which stays intact.
+ *
+ *  Readers take the published version with cm_prbt_snp() & never block;
+ *  a writer builds a new version from a snapshot, possibly over many
+ *  updates, & publishes it at once with cm_prbt_pub(). Every version
+ *  returned to you is a reference you must cm_prbt_rls(); nodes are 
+ *  freed once no version uses them.
+ *
+ *  Concurrent publishers don't see each other's updates; serialise 
+ *  writers if each must build on the last published version.
+ */
+
+
+
+// [heap]
+typedef struct {
+
+    cm_vct data;
+    int arity;   //children per node
+    void * tmp;  //scratch space for one element
+    bool is_init;
+
+    enum cm_rbt_side (*compare)(const void *, const void *);
+
+} cm_heap;
+
+/*
+ *  Heaps use the same compare() function as red-black trees. The element
+ *  for which compare() returns LESS against every other element is at 
+ *  the top, so a compare() that orders ascending gives a min-heap.
+ *
+ *  An arity above 2 gives a shallower heap whose children share cache 
+ *  lines; 4 is a good choice for large heaps.
+ */
+
+
+typedef struct {
+
+    cm_vct data;  //elements, indexed by handle
+    cm_vct order; //<int> handles in heap order
+    cm_vct pos;   //<int> position of each handle in `order`, -1 if free
+    cm_vct free;  //<int> released handles
+    int arity;
+    void * tmp;   //scratch space for one element
+    bool is_init;
+
+    enum cm_rbt_side (*compare)(const void *, const void *);
+
+} cm_iheap;
+
+/*
+ *  An indexed heap returns a handle for every element pushed. The handle
+ *  stays valid until its element is popped or removed, and is then 
+ *  reused. Elements can be updated or removed by handle in O(log n).
+ */
+
+
+
+// [cpu dispatch]
+enum cm_cpu_lvl {
+
+    CM_CPU_SCALAR,
+    CM_CPU_SSE2,
+    CM_CPU_AVX2,
+    CM_CPU_AVX512 //AVX-512F & AVX-512BW
+};
+
+/*
+ *  Kernels with vector implementations are selected once, when the 
+ *  library is loaded, for the highest instruction set the CPU supports.
+ *  Setting the `CM_CPU` environment variable to `scalar`, `sse2` or 
+ *  `avx2` caps the level. cm_cpu_set() changes it at runtime, up to that
+ *  cap; it must not race with calls into the library from other threads.
+ */
+
+
+
+// [algorithms]
+enum cm_alg_type {
+
+    CM_ALG_I32, //int32_t
+    CM_ALG_I64, //int64_t
+    CM_ALG_F32, //float
+    CM_ALG_F64  //double
+};
+
+/*
+ *  Array kernels have SSE2, AVX2 & AVX-512 implementations, see 
+ *  [cpu dispatch].
+ *
+ *  Clamping leaves NaNs unchanged. Minimum & maximum skip NaNs, and for 
+ *  an empty array (or one holding only NaNs) return the largest & 
+ *  smallest value of the type respectively (infinities for floats).
+ */
+
+
+
+// [arena]
+struct _cm_arena_blk {
+
+    struct _cm_arena_blk * next;
+    size_t sz;   //usable bytes following the header
+
+};
+typedef struct _cm_arena_blk cm_arena_blk;
+
+
+typedef struct {
+
+    size_t blk_sz;       //default block size
+    size_t off;          //bytes used in the current block
+    cm_arena_blk * head;
+    cm_arena_blk * cur;
+    bool is_init;
+
+} cm_arena;
+
+/*
+ *  Arenas hand out memory from a chain of blocks. Individual allocations
+ *  are never freed; instead the whole arena is reset in O(1), after which
+ *  its blocks are reused. Blocks are only released by cm_del_arena().
+ */
+
+
+
 // [meta type]
 typedef struct {
 
     int type_id;
     size_t sz;
     void * data;
+    bool is_view; //data is borrowed, not owned
     bool is_init;
 
 } cm_meta_type;
@@ -123,16 +594,62 @@ typedef struct {
 
 
 // [monad]
+typedef struct {
+
+    unsigned long calls;
+    unsigned long fails;
+    unsigned long reallocs;
+    unsigned long long ns;
+
+} cm_monad_stat;
+
+
+typedef struct {
+
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long evictions;
+
+} cm_monad_cache_stat;
+
+
+typedef struct {
+
+    int len;     //number of slots used
+    int sz;      //number of slots allocated
+    int hand;    //next slot considered for eviction
+
+    cm_rbt /* <struct _monad_cache_key, int> */ index;
+    cm_vct /* <struct _monad_cache_slot> */ slots;
+    cm_monad_cache_stat stat;
+
+} cm_monad_cache;
+
+
 typedef struct {
 
     //function list
     cm_lst /* <cm_meta_type * (*)(cm_meta_type *, void *)> */ thunk;
+
+    //per-stage instrumentation
+    cm_vct /* <cm_monad_stat> */ stats;
+    bool is_prof;
+
+    //memoised results
+    cm_monad_cache cache;
+    bool is_cache;
+
+    //scratch memory for stages, reset after each evaluation
+    cm_arena * arena;
+
     bool is_init;
 
 } cm_monad;
 
 #define CM_MONAD_FAIL_TYPE 0
 
+enum cm_monad_fmt {CM_MONAD_FMT_TEXT, CM_MONAD_FMT_JSON};
+
 /*
  *  Meta types store metadata about a type relevant to the monad. The
  *  monad stores a list of functions that process data as a pipeline, 
@@ -142,12 +659,78 @@ typedef struct {
  *  with each type the monad may interact with.
  */
 
+/*
+ *  A meta type created with cm_meta_type_view() borrows its data instead
+ *  of owning it. Stages may modify a view in place. If a stage resizes a
+ *  view with cm_meta_type_upd(), the meta type allocates storage of its 
+ *  own and stops being a view.
+ */
+
+/*
+ *  Profiling is opt-in. While enabled, each evaluation records per-stage
+ *  call counts, failures, reallocations performed by cm_meta_type_upd()
+ *  and cumulative wall time in nanoseconds. While disabled, evaluation
+ *  does not touch the instrumentation at all.
+ */
+
+/*
+ *  Caching is opt-in and only valid for pure pipelines. Results are keyed 
+ *  by the input's type ID and a hash of its bytes; a hit skips every stage
+ *  and writes the cached result into the value passed to cm_monad_eval().
+ *  While caching, the result of a miss is also left in that value, even if
+ *  a stage returned a different meta type. The cache holds a fixed number 
+ *  of entries and evicts using the CLOCK algorithm.
+ */
+
+/*
+ *  cm_monad_eval_fd() streams fixed-size records from `in_fd` through the
+ *  monad and writes each successful result to `out_fd`. Records are read 
+ *  in large blocks into a fixed buffer and each is evaluated in place 
+ *  through a reused view, so memory use does not depend on input size.
+ *  Records whose evaluation fails are skipped without an error: nothing
+ *  is written for them & they are not counted in the return value, so
+ *  the number skipped is the number of records read less that count.
+ *  `rec_sz` must not be 0.
+ */
+
+/*
+ *  A monad with an attached arena makes that arena available to its stages
+ *  for the duration of each evaluation. Stages allocate intermediate meta
+ *  types with cm_monad_new_meta_type() and scratch memory with 
+ *  cm_monad_alloc(); neither is freed by the stage. Views resized with 
+ *  cm_meta_type_upd() during evaluation are also moved into the arena.
+ *  Once evaluation completes, the result is copied into the value passed
+ *  to cm_monad_eval() if it lives in the arena, and the arena is reset.
+ *
+ *  The arena is found through a thread-local set for the duration of the
+ *  evaluation, so the stage signature stays the same with or without one.
+ *  The allocators must be called from the thread running the evaluation;
+ *  a stage handing work to another thread can't allocate from there.
+ *  Evaluations of different monads may run concurrently on different
+ *  threads, but two threads must not evaluate monads sharing one arena.
+ */
+
 
 
 /*
  *  --- [FUNCTIONS] ---
  */
 
+/*
+ *  NOTE: Functions defined `static inline` below are unchecked: they do
+ *        not normalise negative indices or set cm_errno, & are compiled
+ *        into the caller. Building with CM_CHECK_BOUNDS makes them assert
+ *        their arguments instead.
+ */
+
+#ifdef CM_CHECK_BOUNDS
+#define CM_ASSERT_BOUNDS(cond) assert(cond)
+#else
+#define CM_ASSERT_BOUNDS(cond) ((void) 0)
+#endif
+
+
+
 // [list]
 //0 = success, -1 = error, see cm_errno
 extern int cm_lst_get(const cm_lst * list, const int index, void * buf);
@@ -191,6 +774,10 @@ extern void cm_lst_mov(cm_lst * dst_list, cm_lst * src_list);
 extern int cm_lst_iter(const cm_lst * list,
                        int (* callback)(const cm_lst_node * node, void * ctx),
                        void * ctx);
+extern int cm_lst_iter_bat(const cm_lst * list,
+                           int (* callback)(void * const * data,
+                                            const int len, void * ctx),
+                           void * ctx);
 
 //void return
 extern void cm_new_lst(cm_lst * list, const size_t data_sz);
@@ -199,6 +786,21 @@ extern void cm_del_lst(cm_lst * list);
 //void return
 void cm_del_lst_node(cm_lst_node * node);
 
+//pointer return, unchecked
+static inline cm_lst_node * cm_lst_nxt(const cm_lst_node * node) {
+
+    CM_ASSERT_BOUNDS(node != NULL);
+
+    return node->next;
+}
+
+static inline cm_lst_node * cm_lst_prv(const cm_lst_node * node) {
+
+    CM_ASSERT_BOUNDS(node != NULL);
+
+    return node->prev;
+}
+
 
 
 // [vector]
@@ -221,16 +823,159 @@ extern int cm_vct_cpy(cm_vct * dst_vector, const cm_vct * src_vector);
 //void return
 extern void cm_vct_mov(cm_vct * dst_vector, cm_vct * src_vector);
 
+//index = success, -1 = error, see cm_errno
+extern int cm_vct_fnd(const cm_vct * vector, const void * data);
+//void return
+extern void cm_vct_fil(cm_vct * vector, const void * data);
+
 //0 = success, -1 = error, see cm_errno
 extern int cm_vct_iter(const cm_vct * vector,
                        int (* callback)(const void * data, void * ctx),
                        void * ctx);
+extern int cm_vct_iter_spn(const cm_vct * vector,
+                           int (* callback)(const void * data,
+                                            const int len, void * ctx),
+                           void * ctx, const int span);
+extern int cm_vct_iter_par(const cm_vct * vector,
+                           int (* callback)(const void * data, void * ctx),
+                           void * ctx, const int grain);
+extern int cm_vct_rdc_par(const cm_vct * vector,
+                          void * acc, const size_t acc_sz,
+                          int (* map)(const void * data,
+                                      void * partial, void * ctx),
+                          int (* combine)(void * acc,
+                                          const void * partial, void * ctx),
+                          void * ctx, const int grain);
 
 //0 = success, -1 = error, see cm_errno
 extern int cm_new_vct(cm_vct * vector, const size_t data_sz);
 //void return
 extern void cm_del_vct(cm_vct * vector);
 
+//pointer return, unchecked
+static inline void * cm_vct_get_u(const cm_vct * vector, const int index) {
+
+    CM_ASSERT_BOUNDS(index >= 0 && index < vector->len);
+
+    return (cm_byte *) vector->data + vector->data_sz * (size_t) index;
+}
+
+//pointer to the first element, with the length in `len`
+static inline void * cm_vct_dat(const cm_vct * vector, int * len) {
+
+    *len = vector->len;
+
+    return vector->data;
+}
+
+
+
+// [deque]
+//0 = success, -1 = error, see cm_errno
+extern int cm_deq_get(const cm_deq * deque, const int index, void * buf);
+//pointer = success, NULL = error, see cm_errno
+extern void * cm_deq_get_p(const cm_deq * deque, const int index);
+//0 = success, -1 = error, see cm_errno
+extern int cm_deq_set(cm_deq * deque, const int index, const void * data);
+
+extern int cm_deq_psh_f(cm_deq * deque, const void * data);
+extern int cm_deq_psh_b(cm_deq * deque, const void * data);
+extern int cm_deq_pop_f(cm_deq * deque, void * buf);
+extern int cm_deq_pop_b(cm_deq * deque, void * buf);
+
+extern int cm_deq_psh_f_n(cm_deq * deque, const void * data, const int n);
+extern int cm_deq_psh_b_n(cm_deq * deque, const void * data, const int n);
+extern int cm_deq_pop_f_n(cm_deq * deque, void * buf, const int n);
+extern int cm_deq_pop_b_n(cm_deq * deque, void * buf, const int n);
+//void return
+extern void cm_deq_emp(cm_deq * deque);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_new_deq(cm_deq * deque, const size_t data_sz);
+//void return
+extern void cm_del_deq(cm_deq * deque);
+
+
+
+// [concurrent queues]
+//0 = success, -1 = error, see cm_errno
+extern int cm_spsc_enq(cm_spsc * spsc, const void * data);
+extern int cm_spsc_deq(cm_spsc * spsc, void * buf);
+//number of elements transferred
+extern int cm_spsc_enq_n(cm_spsc * spsc, const void * data, const int n);
+extern int cm_spsc_deq_n(cm_spsc * spsc, void * buf, const int n);
+
+//number of contiguous slots available
+extern int cm_spsc_rsv(cm_spsc * spsc, void ** slots, const int n);
+extern int cm_spsc_pek(cm_spsc * spsc, void ** slots, const int n);
+//void return
+extern void cm_spsc_cmt(cm_spsc * spsc, const int n);
+extern void cm_spsc_rls(cm_spsc * spsc, const int n);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_new_spsc(cm_spsc * spsc, const size_t data_sz, const int slots);
+//void return
+extern void cm_del_spsc(cm_spsc * spsc);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_mpmc_enq(cm_mpmc * mpmc, const void * data);
+extern int cm_mpmc_deq(cm_mpmc * mpmc, void * buf);
+//void return
+extern void cm_mpmc_enq_w(cm_mpmc * mpmc, const void * data);
+extern void cm_mpmc_deq_w(cm_mpmc * mpmc, void * buf);
+//number of elements transferred
+extern int cm_mpmc_enq_n(cm_mpmc * mpmc, const void * data, const int n);
+extern int cm_mpmc_deq_n(cm_mpmc * mpmc, void * buf, const int n);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_new_mpmc(cm_mpmc * mpmc, const size_t data_sz, const int slots);
+//void return
+extern void cm_del_mpmc(cm_mpmc * mpmc);
+
+
+
+// [thread pool]
+//void return
+extern void cm_pool_spawn(cm_pool * pool, cm_pool_grp * grp,
+                          cm_pool_task * task,
+                          int (* fn)(void * ctx), void * ctx);
+//0 = success, -1 = error, see cm_errno
+extern int cm_pool_sync(cm_pool * pool, cm_pool_grp * grp);
+//void return
+extern void cm_new_pool_grp(cm_pool_grp * grp);
+
+//number of CPUs
+extern int cm_pool_cpus();
+//pointer = success, NULL = error, see cm_errno
+extern cm_pool * cm_pool_def();
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_new_pool(cm_pool * pool, const int workers);
+//void return
+extern void cm_del_pool(cm_pool * pool);
+
+
+
+// [epoch reclamation]
+//0 = success, -1 = error, see cm_errno
+extern int cm_epoch_reg(cm_epoch * epoch, cm_epoch_thr * thr);
+//void return
+extern void cm_epoch_unreg(cm_epoch_thr * thr);
+
+//void return
+extern void cm_epoch_pin(cm_epoch_thr * thr);
+extern void cm_epoch_unpin(cm_epoch_thr * thr);
+
+//void return
+extern void cm_epoch_rtr(cm_epoch_thr * thr,
+                         void * ptr, void (* del)(void *));
+extern void cm_epoch_rcl(cm_epoch_thr * thr);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_new_epoch(cm_epoch * epoch);
+//void return
+extern void cm_del_epoch(cm_epoch * epoch);
+
 
 
 // [red-black tree]
@@ -254,6 +999,21 @@ extern cm_rbt_node * cm_rbt_idx_get_n(const cm_rbt * tree, const int idx);
 //pointer = success, NULL = error, see cm_errno
 extern cm_rbt_node * cm_rbt_set(cm_rbt * tree, 
                                 const void * key, const void * data);
+
+/*
+ *  NOTE: cm_rbt_set_h() starts its search from `hint`, a node of the same
+ *        tree or NULL; pass the node it last returned to insert near-
+ *        sorted keys in O(1) comparisons each. cm_rbt_set_bat() inserts
+ *        `len` keys & data packed in arrays, sorting them first; on equal
+ *        keys the later entry wins.
+ */
+
+//pointer = success, NULL = error, see cm_errno
+extern cm_rbt_node * cm_rbt_set_h(cm_rbt * tree, cm_rbt_node * hint,
+                                  const void * key, const void * data);
+//0 = success, -1 = error, see cm_errno
+extern int cm_rbt_set_bat(cm_rbt * tree, const void * keys,
+                          const void * data, const int len);
 //0 = success, -1 = error, see cm_errno
 extern int cm_rbt_rmv(cm_rbt * tree, const void * key);
 //pointer = success, NULL = error, see cm_errno
@@ -265,23 +1025,225 @@ extern int cm_rbt_cpy(cm_rbt * dst_tree, const cm_rbt * src_tree);
 //void return
 extern void cm_rbt_mov(cm_rbt * dst_tree, cm_rbt * src_tree);
 
+/*
+ *  NOTE: cm_rbt_split() & cm_rbt_join() relink nodes in O(log n). Split
+ *        leaves keys less than `key` in `left_tree` & the rest in
+ *        `right_tree`, initialising both & emptying `tree`; counting the
+ *        new sizes visits the smaller side. Join requires every key of 
+ *        `left_tree` to be less than every key of `right_tree`, & moves
+ *        all nodes into `left_tree`.
+ */
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_rbt_split(cm_rbt * tree, const void * key,
+                        cm_rbt * left_tree, cm_rbt * right_tree);
+extern int cm_rbt_join(cm_rbt * left_tree, cm_rbt * right_tree);
+
+/*
+ *  NOTE: cm_rbt_uni(), cm_rbt_isc() & cm_rbt_dif() leave the union,
+ *        intersection or difference of both trees in `tree`, in 
+ *        O(n + m) with one allocation. The nodes of `tree` are reused &
+ *        the tree is rebuilt balanced. A union moves the nodes of `other`
+ *        into `tree`, emptying it; on equal keys it keeps `other`'s data,
+ *        as cm_rbt_set() would.
+ */
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_rbt_uni(cm_rbt * tree, cm_rbt * other);
+extern int cm_rbt_isc(cm_rbt * tree, const cm_rbt * other);
+extern int cm_rbt_dif(cm_rbt * tree, const cm_rbt * other);
+
 //0 = success, -1 = errpr, see cm_errno
 extern int cm_rbt_iter(const cm_rbt * tree,
                        int (* callback)(const cm_rbt_node * node, void * ctx),
                        void * ctx);
+extern int cm_rbt_iter_bat(const cm_rbt * tree,
+                           int (* callback)(void * const * keys,
+                                            void * const * data,
+                                            const int len, void * ctx),
+                           void * ctx);
 
 //void return
 extern void cm_new_rbt(cm_rbt * tree, const size_t key_sz, const size_t data_sz,
                        enum cm_rbt_side (*compare)(const void *, const void *));
+
+/*
+ *  NOTE: cm_new_rbt_k() creates a tree with a built-in key kind, compared
+ *        inline during traversal instead of through a compare() call. 
+ *        `key_sz` must match the kind, or be the byte length for 
+ *        CM_RBT_KEY_MEM.
+ */
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_new_rbt_k(cm_rbt * tree, const enum cm_rbt_key key_kind,
+                        const size_t key_sz, const size_t data_sz);
+//void return
 extern void cm_del_rbt(cm_rbt * tree);
 extern void cm_del_rbt_node(cm_rbt_node * node);
 
 
 
+// [concurrent red-black tree]
+//0 = success, -1 = error, see cm_errno
+extern int cm_crbt_get(cm_crbt * tree, const void * key, void * buf);
+extern int cm_crbt_set(cm_crbt * tree, const void * key, const void * data);
+extern int cm_crbt_rmv(cm_crbt * tree, const void * key);
+//void return
+extern void cm_crbt_rcl(cm_crbt * tree);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_new_crbt(cm_crbt * tree,
+                       const size_t key_sz, const size_t data_sz,
+                       enum cm_rbt_side (*compare)(const void *,
+                                                   const void *));
+//void return
+extern void cm_del_crbt(cm_crbt * tree);
+
+
+
+// [persistent red-black tree]
+//0 = success, -1 = error, see cm_errno
+extern int cm_prbt_get(const cm_prbt * tree, const cm_prbt_node * ver,
+                       const void * key, void * buf);
+//pointer = success, NULL = error, see cm_errno
+extern void * cm_prbt_get_p(const cm_prbt * tree, const cm_prbt_node * ver,
+                            const void * key);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_prbt_set(const cm_prbt * tree, cm_prbt_node * ver,
+                       const void * key, const void * data,
+                       cm_prbt_node ** new_ver);
+extern int cm_prbt_rmv(const cm_prbt * tree, cm_prbt_node * ver,
+                       const void * key, cm_prbt_node ** new_ver);
+
+//pointer = version, NULL = empty version
+extern cm_prbt_node * cm_prbt_snp(cm_prbt * tree);
+//void return
+extern void cm_prbt_pub(cm_prbt * tree, cm_prbt_node * ver);
+extern void cm_prbt_rls(cm_prbt_node * ver);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_new_prbt(cm_prbt * tree,
+                       const size_t key_sz, const size_t data_sz,
+                       enum cm_rbt_side (*compare)(const void *,
+                                                   const void *));
+//void return
+extern void cm_del_prbt(cm_prbt * tree);
+
+
+
+// [heap]
+//0 = success, -1 = error, see cm_errno
+extern int cm_heap_pek(const cm_heap * heap, void * buf);
+//pointer = success, NULL = error, see cm_errno
+extern void * cm_heap_pek_p(const cm_heap * heap);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_heap_psh(cm_heap * heap, const void * data);
+extern int cm_heap_pop(cm_heap * heap, void * buf);
+extern int cm_heap_rpl(cm_heap * heap, const void * data, void * buf);
+//void return
+extern void cm_heap_emp(cm_heap * heap);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_new_heap(cm_heap * heap, const size_t data_sz, const int arity,
+                       enum cm_rbt_side (*compare)(const void *,
+                                                   const void *));
+extern int cm_new_heap_vct(cm_heap * heap, cm_vct * vector, const int arity,
+                           enum cm_rbt_side (*compare)(const void *,
+                                                       const void *));
+//void return
+extern void cm_del_heap(cm_heap * heap);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_iheap_get(const cm_iheap * iheap, const int handle, void * buf);
+//pointer = success, NULL = error, see cm_errno
+extern void * cm_iheap_get_p(const cm_iheap * iheap, const int handle);
+//handle = success, -1 = error, see cm_errno
+extern int cm_iheap_pek(const cm_iheap * iheap, void * buf);
+
+//handle = success, -1 = error, see cm_errno
+extern int cm_iheap_psh(cm_iheap * iheap, const void * data);
+extern int cm_iheap_pop(cm_iheap * iheap, void * buf);
+//0 = success, -1 = error, see cm_errno
+extern int cm_iheap_upd(cm_iheap * iheap,
+                        const int handle, const void * data);
+extern int cm_iheap_rmv(cm_iheap * iheap, const int handle);
+//void return
+extern void cm_iheap_emp(cm_iheap * iheap);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_new_iheap(cm_iheap * iheap, const size_t data_sz,
+                        const int arity,
+                        enum cm_rbt_side (*compare)(const void *,
+                                                    const void *));
+//void return
+extern void cm_del_iheap(cm_iheap * iheap);
+
+
+
+// [cpu dispatch]
+//instruction set level return
+extern enum cm_cpu_lvl cm_cpu_get();
+//0 = success, -1 = error, see cm_errno
+extern int cm_cpu_set(const enum cm_cpu_lvl lvl);
+
+
+
 // [algorithms]
 //clamped value return
 extern long cm_clamp(const long value, const long lower, const long upper);
 
+//void return
+extern void cm_clamp_i32(int32_t * arr, const size_t len,
+                         const int32_t lower, const int32_t upper);
+extern void cm_clamp_i64(int64_t * arr, const size_t len,
+                         const int64_t lower, const int64_t upper);
+extern void cm_clamp_f32(float * arr, const size_t len,
+                         const float lower, const float upper);
+extern void cm_clamp_f64(double * arr, const size_t len,
+                         const double lower, const double upper);
+
+extern void cm_minmax_i32(const int32_t * arr, const size_t len,
+                          int32_t * min, int32_t * max);
+extern void cm_minmax_i64(const int64_t * arr, const size_t len,
+                          int64_t * min, int64_t * max);
+extern void cm_minmax_f32(const float * arr, const size_t len,
+                          float * min, float * max);
+extern void cm_minmax_f64(const double * arr, const size_t len,
+                          double * min, double * max);
+
+//minimum value return
+extern int32_t cm_min_i32(const int32_t * arr, const size_t len);
+extern int64_t cm_min_i64(const int64_t * arr, const size_t len);
+extern float cm_min_f32(const float * arr, const size_t len);
+extern double cm_min_f64(const double * arr, const size_t len);
+
+//maximum value return
+extern int32_t cm_max_i32(const int32_t * arr, const size_t len);
+extern int64_t cm_max_i64(const int64_t * arr, const size_t len);
+extern float cm_max_f32(const float * arr, const size_t len);
+extern double cm_max_f64(const double * arr, const size_t len);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_clamp_vct(cm_vct * vector, const enum cm_alg_type type,
+                        const void * lower, const void * upper);
+extern int cm_minmax_vct(const cm_vct * vector, const enum cm_alg_type type,
+                         void * min, void * max);
+
+
+
+// [arena]
+//pointer = success, NULL = error, see cm_errno
+extern void * cm_arena_alloc(cm_arena * arena, const size_t sz);
+//void return
+extern void cm_arena_rst(cm_arena * arena);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_new_arena(cm_arena * arena, const size_t blk_sz);
+//void return
+extern void cm_del_arena(cm_arena * arena);
+
 
 
 // [meta type]
@@ -297,6 +1259,9 @@ extern int cm_meta_type_cpy(cm_meta_type * dst_value,
 extern int cm_new_meta_type(cm_meta_type * value, const int type_id,
                             const void * data, const size_t sz);
 //void return
+extern void cm_meta_type_view(cm_meta_type * value, const int type_id,
+                              void * data, const size_t sz);
+//void return
 extern void cm_del_meta_type(cm_meta_type * meta_value);
 
 
@@ -307,6 +1272,38 @@ extern int cm_monad_compose(cm_monad * monad,
                             cm_meta_type * (* cb)(cm_meta_type *, void * ctx));
 extern int cm_monad_eval(cm_monad * monad,
                          cm_meta_type * value, void * ctx);
+//records written = success, -1 = error, see cm_errno
+extern ssize_t cm_monad_eval_fd(cm_monad * monad, const int in_fd,
+                                const int out_fd, const int type_id,
+                                const size_t rec_sz, void * ctx);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_monad_prof_on(cm_monad * monad);
+//void return
+extern void cm_monad_prof_off(cm_monad * monad);
+extern void cm_monad_prof_rst(cm_monad * monad);
+//0 = success, -1 = error, see cm_errno
+extern int cm_monad_prof_get(const cm_monad * monad,
+                             const int stage, cm_monad_stat * buf);
+extern int cm_monad_prof_dump(const cm_monad * monad,
+                              const int fd, const enum cm_monad_fmt fmt);
+
+//void return
+extern void cm_monad_set_arena(cm_monad * monad, cm_arena * arena);
+//pointer = success, NULL = error, see cm_errno
+extern cm_meta_type * cm_monad_new_meta_type(const int type_id,
+                                             const void * data,
+                                             const size_t sz);
+extern void * cm_monad_alloc(const size_t sz);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_monad_cache_on(cm_monad * monad, const int slots);
+//void return
+extern void cm_monad_cache_off(cm_monad * monad);
+extern void cm_monad_cache_emp(cm_monad * monad);
+//0 = success, -1 = error, see cm_errno
+extern int cm_monad_cache_get(const cm_monad * monad,
+                              cm_monad_cache_stat * buf);
 
 //void return
 extern void cm_new_monad(cm_monad * monad);
@@ -334,6 +1331,14 @@ extern __thread int cm_errno;
 #define CM_ERR_USER_INDEX       1100
 #define CM_ERR_USER_KEY         1101
 #define CM_ERR_CALLBACK         1102
+#define CM_ERR_USER_TRUNC       1103
+#define CM_ERR_USER_ARENA       1104
+#define CM_ERR_USER_TYPE        1105
+#define CM_ERR_USER_CPU         1106
+#define CM_ERR_USER_VALUE       1107
+#define CM_ERR_USER_ARG         1108
+#define CM_ERR_USER_FULL        1109
+#define CM_ERR_USER_EMPTY       1110
 
 // 2XX - internal errors
 #define CM_ERR_INTERNAL_INDEX   1200
@@ -342,6 +1347,9 @@ extern __thread int cm_errno;
 // 3XX - environment errors
 #define CM_ERR_MALLOC           1300
 #define CM_ERR_REALLOC          1301
+#define CM_ERR_WRITE            1302
+#define CM_ERR_READ             1303
+#define CM_ERR_THREAD           1304
 
 
 // [error code messages]
@@ -350,6 +1358,14 @@ extern __thread int cm_errno;
 #define CM_ERR_USER_INDEX_MSG       "Index out of range.\n"
 #define CM_ERR_USER_KEY_MSG         "Key not present in tree.\n"
 #define CM_ERR_CALLBACK_MSG         "Callback returned an error.\n"
+#define CM_ERR_USER_TRUNC_MSG       "Input ended partway through a record.\n"
+#define CM_ERR_USER_ARENA_MSG       "No arena is attached to the evaluation.\n"
+#define CM_ERR_USER_TYPE_MSG        "Element size does not match the type.\n"
+#define CM_ERR_USER_CPU_MSG         "CPU does not support the instruction set.\n"
+#define CM_ERR_USER_VALUE_MSG       "Value not present in vector.\n"
+#define CM_ERR_USER_ARG_MSG         "Invalid argument.\n"
+#define CM_ERR_USER_FULL_MSG        "Queue is full.\n"
+#define CM_ERR_USER_EMPTY_MSG       "Queue is empty.\n"
 
 // 2XX - internal errors
 #define CM_ERR_INTERNAL_INDEX_MSG   "Internal indexing error.\n"
@@ -358,6 +1374,9 @@ extern __thread int cm_errno;
 // 3XX - environmental errors
 #define CM_ERR_MALLOC_MSG           "Internal malloc() failed.\n"
 #define CM_ERR_REALLOC_MSG          "Internal realloc() failed.\n"
+#define CM_ERR_WRITE_MSG            "Failed to write output.\n"
+#define CM_ERR_READ_MSG             "Failed to read input.\n"
+#define CM_ERR_THREAD_MSG           "Failed to create a thread.\n"
 
 
 #ifdef __cplusplus
@@ -0,0 +1,393 @@
+#ifndef CMORE_TMPL_H
+#define CMORE_TMPL_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+//standard library
+#include <string.h>
+
+//local headers
+#include "cmore.h"
+
+
+
+/*
+ *  --- [TYPED CONTAINERS] ---
+ */
+
+/*
+ *  CM_DEFINE_VCT() & CM_DEFINE_RBT() generate a vector or red-black tree
+ *  type specialised for one element type, with the usual functions named
+ *  after it:
+ *
+ *      CM_DEFINE_VCT(int, int)
+ *          -> cm_vct_int, cm_vct_int_get(), cm_new_vct_int(), ...
+ *
+ *      CM_DEFINE_RBT(u64_ptr, uint64_t, void *, CM_TMPL_CMP)
+ *          -> cm_rbt_u64_ptr, cm_rbt_u64_ptr_set(), cm_new_rbt_u64_ptr(), ...
+ *
+ *  Use each at most once per name, at file scope. The functions take &
+ *  return the element types in place of `void *`, & follow the return
+ *  conventions of the untyped functions they are named after.
+ *
+ *  Lookups, element access & appends are defined inline with sizes known
+ *  at compile time, so the compiler can fold them into the caller. The
+ *  remaining operations call the untyped library. The untyped container
+ *  is the first member of the generated type; pass its address to use
+ *  any other function of cmore.h.
+ *
+ *  `cmp(a, b)` is a function or function-like macro taking two keys by
+ *  value & returning an int less than, equal to or greater than zero.
+ *  CM_TMPL_CMP() orders any arithmetic type.
+ */
+
+#define CM_TMPL_CMP(a, b) (((a) > (b)) - ((a) < (b)))
+
+
+
+// [vector]
+#define CM_DEFINE_VCT(name, type)                                            \
+                                                                             \
+typedef struct {                                                             \
+                                                                             \
+    cm_vct vct;                                                              \
+                                                                             \
+} cm_vct_##name;                                                             \
+                                                                             \
+                                                                             \
+/* pointer = success, NULL = error, see cm_errno */                          \
+static inline                                                                \
+type * cm_vct_##name##_get_p(const cm_vct_##name * vector, int index) {      \
+                                                                             \
+    if (index < 0) index += vector->vct.len;                                 \
+                                                                             \
+    if (index >= vector->vct.len || index < 0) {                             \
+        cm_errno = CM_ERR_USER_INDEX;                                        \
+        return NULL;                                                         \
+    }                                                                        \
+                                                                             \
+    return (type *) vector->vct.data + index;                                \
+}                                                                            \
+                                                                             \
+                                                                             \
+/* pointer return, unchecked */                                              \
+static inline                                                                \
+type * cm_vct_##name##_get_u(const cm_vct_##name * vector,                   \
+                             const int index) {                              \
+                                                                             \
+    CM_ASSERT_BOUNDS(index >= 0 && index < vector->vct.len);                 \
+                                                                             \
+    return (type *) vector->vct.data + index;                                \
+}                                                                            \
+                                                                             \
+                                                                             \
+/* 0 = success, -1 = error, see cm_errno */                                  \
+static inline                                                                \
+int cm_vct_##name##_get(const cm_vct_##name * vector,                        \
+                        const int index, type * buf) {                       \
+                                                                             \
+    type * data = cm_vct_##name##_get_p(vector, index);                      \
+    if (data == NULL) return -1;                                             \
+                                                                             \
+    *buf = *data;                                                            \
+                                                                             \
+    return 0;                                                                \
+}                                                                            \
+                                                                             \
+                                                                             \
+static inline                                                                \
+int cm_vct_##name##_set(cm_vct_##name * vector,                              \
+                        const int index, type const * data) {                \
+                                                                             \
+    type * index_data = cm_vct_##name##_get_p(vector, index);                \
+    if (index_data == NULL) return -1;                                       \
+                                                                             \
+    *index_data = *data;                                                     \
+                                                                             \
+    return 0;                                                                \
+}                                                                            \
+                                                                             \
+                                                                             \
+static inline                                                                \
+int cm_vct_##name##_ins(cm_vct_##name * vector,                              \
+                        const int index, type const * data) {                \
+                                                                             \
+    return cm_vct_ins(&vector->vct, index, data);                            \
+}                                                                            \
+                                                                             \
+                                                                             \
+static inline                                                                \
+int cm_vct_##name##_apd(cm_vct_##name * vector, type const * data) {         \
+                                                                             \
+    /* growing is left to the library */                                     \
+    if ((size_t) vector->vct.len == vector->vct.sz) {                        \
+        return cm_vct_apd(&vector->vct, data);                               \
+    }                                                                        \
+                                                                             \
+    ((type *) vector->vct.data)[vector->vct.len] = *data;                    \
+    ++vector->vct.len;                                                       \
+                                                                             \
+    return 0;                                                                \
+}                                                                            \
+                                                                             \
+                                                                             \
+static inline                                                                \
+int cm_vct_##name##_rmv(cm_vct_##name * vector, const int index) {           \
+                                                                             \
+    return cm_vct_rmv(&vector->vct, index);                                  \
+}                                                                            \
+                                                                             \
+                                                                             \
+static inline                                                                \
+int cm_vct_##name##_fit(cm_vct_##name * vector) {                            \
+                                                                             \
+    return cm_vct_fit(&vector->vct);                                         \
+}                                                                            \
+                                                                             \
+                                                                             \
+static inline                                                                \
+int cm_vct_##name##_rsz(cm_vct_##name * vector, const int entries) {         \
+                                                                             \
+    return cm_vct_rsz(&vector->vct, entries);                                \
+}                                                                            \
+                                                                             \
+                                                                             \
+/* void return */                                                            \
+static inline                                                                \
+void cm_vct_##name##_emp(cm_vct_##name * vector) {                           \
+                                                                             \
+    cm_vct_emp(&vector->vct);                                                \
+                                                                             \
+    return;                                                                  \
+}                                                                            \
+                                                                             \
+                                                                             \
+/* 0 = success, -1 = error, see cm_errno */                                  \
+static inline                                                                \
+int cm_vct_##name##_cpy(cm_vct_##name * dst_vector,                          \
+                        const cm_vct_##name * src_vector) {                  \
+                                                                             \
+    return cm_vct_cpy(&dst_vector->vct, &src_vector->vct);                   \
+}                                                                            \
+                                                                             \
+                                                                             \
+/* void return */                                                            \
+static inline                                                                \
+void cm_vct_##name##_mov(cm_vct_##name * dst_vector,                         \
+                         cm_vct_##name * src_vector) {                       \
+                                                                             \
+    cm_vct_mov(&dst_vector->vct, &src_vector->vct);                          \
+                                                                             \
+    return;                                                                  \
+}                                                                            \
+                                                                             \
+                                                                             \
+/* 0 = success, -1 = error, see cm_errno */                                  \
+static inline                                                                \
+int cm_new_vct_##name(cm_vct_##name * vector) {                              \
+                                                                             \
+    return cm_new_vct(&vector->vct, sizeof(type));                           \
+}                                                                            \
+                                                                             \
+                                                                             \
+/* void return */                                                            \
+static inline                                                                \
+void cm_del_vct_##name(cm_vct_##name * vector) {                             \
+                                                                             \
+    cm_del_vct(&vector->vct);                                                \
+                                                                             \
+    return;                                                                  \
+}
+
+
+
+// [red-black tree]
+#define CM_DEFINE_RBT(name, key_type, data_type, cmp)                        \
+                                                                             \
+typedef struct {                                                             \
+                                                                             \
+    cm_rbt tree;                                                             \
+                                                                             \
+} cm_rbt_##name;                                                             \
+                                                                             \
+                                                                             \
+/* compare() for the library */                                              \
+static inline                                                                \
+enum cm_rbt_side _cm_rbt_##name##_compare(const void * a, const void * b) {  \
+                                                                             \
+    int order;                                                               \
+    key_type key_a, key_b;                                                   \
+                                                                             \
+                                                                             \
+    memcpy(&key_a, a, sizeof(key_type));                                     \
+    memcpy(&key_b, b, sizeof(key_type));                                     \
+                                                                             \
+    order = cmp(key_a, key_b);                                               \
+    if (order < 0) return CM_RBT_LESS;                                       \
+    if (order > 0) return CM_RBT_MORE;                                       \
+    return CM_RBT_EQUAL;                                                     \
+}                                                                            \
+                                                                             \
+                                                                             \
+/* return the node holding `key`, or the parent of its empty slot */         \
+static inline                                                                \
+cm_rbt_node * _cm_rbt_##name##_find(const cm_rbt_##name * tree,              \
+                                    key_type const key, int * order) {       \
+                                                                             \
+    key_type node_key;                                                       \
+    cm_rbt_node * node, * next;                                              \
+                                                                             \
+                                                                             \
+    *order = -1;                                                             \
+                                                                             \
+    node = tree->tree.root;                                                  \
+    while (node != NULL) {                                                   \
+                                                                             \
+        memcpy(&node_key, node->key, sizeof(key_type));                      \
+        *order = cmp(key, node_key);                                         \
+        if (*order == 0) return node;                                        \
+                                                                             \
+        next = *order < 0 ? node->left : node->right;                        \
+        if (next == NULL) return node;                                       \
+        node = next;                                                         \
+    }                                                                        \
+                                                                             \
+    return NULL;                                                             \
+}                                                                            \
+                                                                             \
+                                                                             \
+/* pointer = success, NULL = error, see cm_errno */                          \
+static inline                                                                \
+cm_rbt_node * cm_rbt_##name##_get_n(const cm_rbt_##name * tree,              \
+                                    key_type const * key) {                  \
+                                                                             \
+    int order;                                                               \
+    cm_rbt_node * node = _cm_rbt_##name##_find(tree, *key, &order);          \
+                                                                             \
+    if (node == NULL || order != 0) {                                        \
+        cm_errno = CM_ERR_USER_KEY;                                          \
+        return NULL;                                                         \
+    }                                                                        \
+                                                                             \
+    return node;                                                             \
+}                                                                            \
+                                                                             \
+                                                                             \
+static inline                                                                \
+data_type * cm_rbt_##name##_get_p(const cm_rbt_##name * tree,                \
+                                  key_type const * key) {                    \
+                                                                             \
+    cm_rbt_node * node = cm_rbt_##name##_get_n(tree, key);                   \
+    if (node == NULL) return NULL;                                           \
+                                                                             \
+    return (data_type *) node->data;                                         \
+}                                                                            \
+                                                                             \
+                                                                             \
+/* 0 = success, -1 = error, see cm_errno */                                  \
+static inline                                                                \
+int cm_rbt_##name##_get(const cm_rbt_##name * tree,                          \
+                        key_type const * key, data_type * buf) {             \
+                                                                             \
+    cm_rbt_node * node = cm_rbt_##name##_get_n(tree, key);                   \
+    if (node == NULL) return -1;                                             \
+                                                                             \
+    memcpy(buf, node->data, sizeof(data_type));                              \
+                                                                             \
+    return 0;                                                                \
+}                                                                            \
+                                                                             \
+                                                                             \
+/* pointer = success, NULL = error, see cm_errno */                          \
+static inline                                                                \
+cm_rbt_node * cm_rbt_##name##_set(cm_rbt_##name * tree,                      \
+                                  key_type const * key,                      \
+                                  data_type const * data) {                  \
+                                                                             \
+    int order;                                                               \
+    cm_rbt_node * node = _cm_rbt_##name##_find(tree, *key, &order);          \
+                                                                             \
+    if (node != NULL && order == 0) {                                        \
+        memcpy(node->data, data, sizeof(data_type));                         \
+        return node;                                                         \
+    }                                                                        \
+                                                                             \
+    /* the parent found above lets the library link the node directly */     \
+    return cm_rbt_set_h(&tree->tree, node, key, data);                       \
+}                                                                            \
+                                                                             \
+                                                                             \
+/* 0 = success, -1 = error, see cm_errno */                                  \
+static inline                                                                \
+int cm_rbt_##name##_rmv(cm_rbt_##name * tree, key_type const * key) {        \
+                                                                             \
+    return cm_rbt_rmv(&tree->tree, key);                                     \
+}                                                                            \
+                                                                             \
+                                                                             \
+/* pointer = success, NULL = error, see cm_errno */                          \
+static inline                                                                \
+cm_rbt_node * cm_rbt_##name##_uln(cm_rbt_##name * tree,                      \
+                                  key_type const * key) {                    \
+                                                                             \
+    return cm_rbt_uln(&tree->tree, key);                                     \
+}                                                                            \
+                                                                             \
+                                                                             \
+/* void return */                                                            \
+static inline                                                                \
+void cm_rbt_##name##_emp(cm_rbt_##name * tree) {                             \
+                                                                             \
+    cm_rbt_emp(&tree->tree);                                                 \
+                                                                             \
+    return;                                                                  \
+}                                                                            \
+                                                                             \
+                                                                             \
+/* 0 = success, -1 = error, see cm_errno */                                  \
+static inline                                                                \
+int cm_rbt_##name##_cpy(cm_rbt_##name * dst_tree,                            \
+                        const cm_rbt_##name * src_tree) {                    \
+                                                                             \
+    return cm_rbt_cpy(&dst_tree->tree, &src_tree->tree);                     \
+}                                                                            \
+                                                                             \
+                                                                             \
+/* void return */                                                            \
+static inline                                                                \
+void cm_rbt_##name##_mov(cm_rbt_##name * dst_tree,                           \
+                         cm_rbt_##name * src_tree) {                         \
+                                                                             \
+    cm_rbt_mov(&dst_tree->tree, &src_tree->tree);                            \
+                                                                             \
+    return;                                                                  \
+}                                                                            \
+                                                                             \
+                                                                             \
+static inline                                                                \
+void cm_new_rbt_##name(cm_rbt_##name * tree) {                               \
+                                                                             \
+    cm_new_rbt(&tree->tree, sizeof(key_type), sizeof(data_type),             \
+               _cm_rbt_##name##_compare);                                    \
+                                                                             \
+    return;                                                                  \
+}                                                                            \
+                                                                             \
+                                                                             \
+static inline                                                                \
+void cm_del_rbt_##name(cm_rbt_##name * tree) {                               \
+                                                                             \
+    cm_del_rbt(&tree->tree);                                                 \
+                                                                             \
+    return;                                                                  \
+}
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,124 @@
+//standard library
+#include <stdlib.h>
+#include <string.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "cpu.h"
+
+
+
+//highest level allowed on this CPU & the level in use
+static enum cm_cpu_lvl _cpu_max_lvl;
+static enum cm_cpu_lvl _cpu_lvl;
+static bool _cpu_is_init;
+
+//dispatch callbacks of every module
+static void (* _cpu_dispatch[CPU_DISPATCH_MAX])(const enum cm_cpu_lvl lvl);
+static int _cpu_dispatch_len;
+
+
+
+/*
+ *  --- [INTERNAL] ---
+ */
+
+DBG_STATIC
+enum cm_cpu_lvl _cpu_detect() {
+
+#ifdef CPU_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f") 
+        && __builtin_cpu_supports("avx512bw")) return CM_CPU_AVX512;
+    if (__builtin_cpu_supports("avx2")) return CM_CPU_AVX2;
+    if (__builtin_cpu_supports("sse2")) return CM_CPU_SSE2;
+#endif
+
+    return CM_CPU_SCALAR;
+}
+
+
+
+/*
+ *  Runs on first use rather than from a constructor of its own, since 
+ *  constructors of other modules may register before it would run.
+ */
+
+DBG_STATIC
+void _cpu_init() {
+
+    const char * env;
+
+
+    _cpu_max_lvl = _cpu_detect();
+
+    //the environment may cap the level
+    env = getenv(CPU_ENV);
+    if (env != NULL) {
+
+        if (strcmp(env, "scalar") == 0) _cpu_max_lvl = CM_CPU_SCALAR;
+        if (strcmp(env, "sse2") == 0 && _cpu_max_lvl > CM_CPU_SSE2) 
+            _cpu_max_lvl = CM_CPU_SSE2;
+        if (strcmp(env, "avx2") == 0 && _cpu_max_lvl > CM_CPU_AVX2) 
+            _cpu_max_lvl = CM_CPU_AVX2;
+    }
+
+    _cpu_lvl = _cpu_max_lvl;
+    _cpu_is_init = true;
+
+    return;
+}
+
+
+
+/*
+ *  --- [SHARED] ---
+ */
+
+void _cpu_register(void (* dispatch)(const enum cm_cpu_lvl lvl)) {
+
+    if (!_cpu_is_init) _cpu_init();
+
+    if (_cpu_dispatch_len < CPU_DISPATCH_MAX) {
+        _cpu_dispatch[_cpu_dispatch_len] = dispatch;
+        ++_cpu_dispatch_len;
+    }
+
+    dispatch(_cpu_lvl);
+
+    return;
+}
+
+
+
+/*
+ *  --- [EXTERNAL] ---
+ */
+
+enum cm_cpu_lvl cm_cpu_get() {
+
+    if (!_cpu_is_init) _cpu_init();
+
+    return _cpu_lvl;
+}
+
+
+
+int cm_cpu_set(const enum cm_cpu_lvl lvl) {
+
+    if (!_cpu_is_init) _cpu_init();
+
+    //the CPU must support the level & the environment must allow it
+    if (lvl > _cpu_max_lvl) {
+        cm_errno = CM_ERR_USER_CPU;
+        return -1;
+    }
+
+    //re-select every module's kernels
+    _cpu_lvl = lvl;
+    for (int i = 0; i < _cpu_dispatch_len; ++i) _cpu_dispatch[i](lvl);
+
+    return 0;
+}
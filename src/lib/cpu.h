@@ -0,0 +1,53 @@
+#ifndef CPU_H
+#define CPU_H
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+
+
+// -- [cpu dispatch]
+
+//vector kernels are only built for x86
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_X86
+#endif
+
+//target attributes for multi-versioned kernels
+#define CPU_TARGET_SSE2   __attribute__((target("sse2")))
+#define CPU_TARGET_AVX2   __attribute__((target("avx2")))
+#define CPU_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+
+//shared between translation units, but not exported from the library
+#define CPU_HIDDEN __attribute__((visibility("hidden")))
+
+//environment variable that caps the instruction set at load time
+#define CPU_ENV "CM_CPU"
+
+//maximum number of modules with multi-versioned kernels
+#define CPU_DISPATCH_MAX 8
+
+
+#ifdef CM_DEBUG
+//internal
+enum cm_cpu_lvl _cpu_detect();
+void _cpu_init();
+#endif
+
+
+/*
+ *  Modules register a dispatch callback from a constructor; it is called 
+ *  immediately with the active instruction set level and again whenever 
+ *  the level changes, and must point the module's kernels at the right 
+ *  variants.
+ */
+
+//shared
+CPU_HIDDEN void _cpu_register(void (* dispatch)(const enum cm_cpu_lvl lvl));
+
+
+//external
+enum cm_cpu_lvl cm_cpu_get();
+int cm_cpu_set(const enum cm_cpu_lvl lvl);
+
+#endif
@@ -0,0 +1,322 @@
+//standard library
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+//system headers
+#include <unistd.h>
+#include <pthread.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "que.h"
+#include "crbt.h"
+
+
+
+//reader slot of this thread, shared by every tree
+static __thread int _crbt_slot_idx = -1;
+static uint32_t _crbt_next_slot;
+
+
+
+/*
+ *  --- [INTERNAL] ---
+ */
+
+/*
+ *  Optimistic lookup. Links may be mid-rotation, so the walk is bounded;
+ *  the caller discards the result unless the sequence counter held.
+ *  Returns 1 on a hit, 0 on a miss, -1 if the walk went astray.
+ */
+
+DBG_STATIC
+int _crbt_find(const cm_crbt * tree, const void * key, void * buf) {
+
+    enum cm_rbt_side side;
+    cm_rbt_node * node;
+
+
+    node = __atomic_load_n(&tree->tree.root, __ATOMIC_RELAXED);
+    for (int i = 0; node != NULL; ++i) {
+
+        if (i == CRBT_MAX_DEPTH) return -1;
+
+        side = tree->tree.compare(key, node->key);
+        if (side == CM_RBT_EQUAL) {
+            memcpy(buf, node->data, tree->tree.data_sz);
+            return 1;
+        }
+
+        node = side == CM_RBT_LESS 
+               ? __atomic_load_n(&node->left, __ATOMIC_RELAXED)
+               : __atomic_load_n(&node->right, __ATOMIC_RELAXED);
+    }
+
+    return 0;
+}
+
+
+
+//make the sequence counter odd while the tree is modified
+DBG_STATIC DBG_INLINE
+void _crbt_write_begin(cm_crbt * tree) {
+
+    __atomic_store_n(&tree->seq, tree->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    return;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+void _crbt_write_end(cm_crbt * tree) {
+
+    __atomic_store_n(&tree->seq, tree->seq + 1, __ATOMIC_RELEASE);
+
+    return;
+}
+
+
+
+//wait for a grace period, then free every retired node
+DBG_STATIC
+void _crbt_reclaim(cm_crbt * tree) {
+
+    cm_rbt_node ** nodes;
+
+
+    _crbt_sync(tree->slots, &tree->parity);
+
+    nodes = tree->retired.data;
+    for (int i = 0; i < tree->retired.len; ++i) cm_del_rbt_node(nodes[i]);
+    cm_vct_emp(&tree->retired);
+
+    return;
+}
+
+
+
+/*
+ *  --- [SHARED] ---
+ */
+
+/*
+ *  Readers announce themselves in a slot counter for the current grace 
+ *  period parity. To wait out a grace period, the writer flips the parity
+ *  & waits for every slot's counter of the old parity to drain; readers 
+ *  that enter after the flip can't reach anything unlinked before it.
+ *
+ *  A reader that loads the parity, then increments its counter only
+ *  after a writer has flipped & scanned it, would sit unseen in the old
+ *  parity. The reader re-reads the parity after the increment & retries
+ *  if it changed; once it holds, the next flip is sure to see it.
+ */
+
+struct _cm_crbt_slot * _crbt_enter(struct _cm_crbt_slot * slots,
+                                   uint32_t * parity_word, uint32_t * parity) {
+
+    struct _cm_crbt_slot * slot;
+
+
+    if (_crbt_slot_idx == -1) {
+        _crbt_slot_idx = (int) (__atomic_fetch_add(&_crbt_next_slot, 1, 
+                                    __ATOMIC_RELAXED) % CRBT_SLOTS);
+    }
+    slot = &slots[_crbt_slot_idx];
+
+    for (;;) {
+
+        *parity = __atomic_load_n(parity_word, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&slot->readers[*parity], 1, __ATOMIC_SEQ_CST);
+
+        if (__atomic_load_n(parity_word, __ATOMIC_SEQ_CST) == *parity) break;
+        __atomic_sub_fetch(&slot->readers[*parity], 1, __ATOMIC_RELEASE);
+    }
+
+    return slot;
+}
+
+
+
+void _crbt_exit(struct _cm_crbt_slot * slot, const uint32_t parity) {
+
+    __atomic_sub_fetch(&slot->readers[parity], 1, __ATOMIC_RELEASE);
+
+    return;
+}
+
+
+
+void _crbt_sync(struct _cm_crbt_slot * slots, uint32_t * parity_word) {
+
+    uint32_t old;
+
+
+    old = *parity_word;
+    __atomic_store_n(parity_word, old ^ 1, __ATOMIC_SEQ_CST);
+
+    for (int i = 0; i < CRBT_SLOTS; ++i) {
+        for (int j = 0; __atomic_load_n(&slots[i].readers[old],
+                                        __ATOMIC_ACQUIRE) != 0; ++j) {
+            _que_relax(j);
+        }
+    }
+
+    return;
+}
+
+
+
+/*
+ *  --- [EXTERNAL] ---
+ */
+
+int cm_crbt_get(cm_crbt * tree, const void * key, void * buf) {
+
+    int ret;
+    uint32_t seq, parity;
+    struct _cm_crbt_slot * slot;
+
+
+    slot = _crbt_enter(tree->slots, &tree->parity, &parity);
+
+    //retry until a walk overlaps no write
+    do {
+
+        for (int i = 0; 
+             (seq = __atomic_load_n(&tree->seq, __ATOMIC_ACQUIRE)) & 1; ++i) {
+            _que_relax(i);
+        }
+
+        ret = _crbt_find(tree, key, buf);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    } while (ret == -1 || __atomic_load_n(&tree->seq, __ATOMIC_RELAXED) != seq);
+
+    _crbt_exit(slot, parity);
+
+    if (ret == 0) {
+        cm_errno = CM_ERR_USER_KEY;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+
+int cm_crbt_set(cm_crbt * tree, const void * key, const void * data) {
+
+    cm_rbt_node * node;
+
+
+    pthread_mutex_lock(&tree->lock);
+
+    _crbt_write_begin(tree);
+    node = cm_rbt_set(&tree->tree, key, data);
+    _crbt_write_end(tree);
+
+    pthread_mutex_unlock(&tree->lock);
+
+    return node == NULL ? -1 : 0;
+}
+
+
+
+int cm_crbt_rmv(cm_crbt * tree, const void * key) {
+
+    int ret;
+    cm_rbt_node * node;
+
+
+    pthread_mutex_lock(&tree->lock);
+
+    _crbt_write_begin(tree);
+    node = cm_rbt_uln(&tree->tree, key);
+    _crbt_write_end(tree);
+
+    if (node == NULL) {
+        pthread_mutex_unlock(&tree->lock);
+        return -1;
+    }
+
+    //readers may still be on the node
+    ret = cm_vct_apd(&tree->retired, &node);
+    if (ret != 0 || tree->retired.len >= CRBT_RETIRE_MAX) {
+        _crbt_reclaim(tree);
+    }
+
+    //could not retire the node, free it after the grace period
+    if (ret != 0) cm_del_rbt_node(node);
+
+    pthread_mutex_unlock(&tree->lock);
+
+    return 0;
+}
+
+
+
+void cm_crbt_rcl(cm_crbt * tree) {
+
+    pthread_mutex_lock(&tree->lock);
+    _crbt_reclaim(tree);
+    pthread_mutex_unlock(&tree->lock);
+
+    return;
+}
+
+
+
+int cm_new_crbt(cm_crbt * tree, const size_t key_sz, const size_t data_sz,
+                enum cm_rbt_side (*compare)(const void *, const void *)) {
+
+    int ret;
+
+
+    tree->slots = aligned_alloc(CM_CACHE_LINE, 
+                                sizeof(struct _cm_crbt_slot) * CRBT_SLOTS);
+    if (tree->slots == NULL) {
+        cm_errno = CM_ERR_MALLOC;
+        return -1;
+    }
+    memset(tree->slots, 0, sizeof(struct _cm_crbt_slot) * CRBT_SLOTS);
+
+    ret = cm_new_vct(&tree->retired, sizeof(cm_rbt_node *));
+    if (ret != 0) {
+        free(tree->slots);
+        return -1;
+    }
+
+    cm_new_rbt(&tree->tree, key_sz, data_sz, compare);
+    pthread_mutex_init(&tree->lock, NULL);
+
+    tree->seq     = 0;
+    tree->parity  = 0;
+    tree->is_init = true;
+
+    return 0;
+}
+
+
+
+void cm_del_crbt(cm_crbt * tree) {
+
+    cm_rbt_node ** nodes;
+
+
+    //no readers may remain
+    nodes = tree->retired.data;
+    for (int i = 0; i < tree->retired.len; ++i) cm_del_rbt_node(nodes[i]);
+
+    cm_del_vct(&tree->retired);
+    cm_del_rbt(&tree->tree);
+    pthread_mutex_destroy(&tree->lock);
+    free(tree->slots);
+
+    tree->is_init = false;
+
+    return;
+}
@@ -0,0 +1,64 @@
+#ifndef CRBT_H
+#define CRBT_H
+
+//standard library
+#include <stdint.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "cpu.h"
+
+
+// -- [concurrent red-black tree]
+
+//reader slots; threads share slots when there are more readers
+#define CRBT_SLOTS 32
+
+//retired nodes held before the writer waits for a grace period
+#define CRBT_RETIRE_MAX 64
+
+//steps before a reader assumes it followed a half-rotated link
+#define CRBT_MAX_DEPTH 128
+
+
+//readers inside the tree, for each grace period parity
+struct _cm_crbt_slot {
+
+    uint32_t readers[2];
+
+} __attribute__((aligned(CM_CACHE_LINE)));
+
+
+#ifdef CM_DEBUG
+//internal
+int _crbt_find(const cm_crbt * tree, const void * key, void * buf);
+void _crbt_write_begin(cm_crbt * tree);
+void _crbt_write_end(cm_crbt * tree);
+void _crbt_reclaim(cm_crbt * tree);
+#endif
+
+
+//shared
+CPU_HIDDEN struct _cm_crbt_slot * _crbt_enter(struct _cm_crbt_slot * slots,
+                                              uint32_t * parity_word,
+                                              uint32_t * parity);
+CPU_HIDDEN void _crbt_exit(struct _cm_crbt_slot * slot, const uint32_t parity);
+CPU_HIDDEN void _crbt_sync(struct _cm_crbt_slot * slots,
+                           uint32_t * parity_word);
+
+
+//external
+int cm_crbt_get(cm_crbt * tree, const void * key, void * buf);
+int cm_crbt_set(cm_crbt * tree, const void * key, const void * data);
+int cm_crbt_rmv(cm_crbt * tree, const void * key);
+void cm_crbt_rcl(cm_crbt * tree);
+
+int cm_new_crbt(cm_crbt * tree, const size_t key_sz, const size_t data_sz,
+                enum cm_rbt_side (*compare)(const void *, const void *));
+void cm_del_crbt(cm_crbt * tree);
+
+#endif
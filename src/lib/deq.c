@@ -0,0 +1,313 @@
+//standard library
+#include <stdlib.h>
+#include <string.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "deq.h"
+
+
+
+/*
+ *  --- [DEQUE - INTERNAL] ---
+ */
+
+//physical slot of a logical index
+DBG_STATIC DBG_INLINE
+size_t _deq_phys(const cm_deq * deque, const size_t index) {
+
+    return (deque->head + index) & (deque->sz - 1);
+}
+
+
+
+DBG_STATIC DBG_INLINE
+void * _deq_traverse(const cm_deq * deque, const size_t index) {
+
+    return deque->data + (deque->data_sz * _deq_phys(deque, index));
+}
+
+
+
+//negative indeces count back from the end, see cm_vct_get()
+DBG_STATIC DBG_INLINE
+int _deq_normalise_index(const cm_deq * deque, int index) {
+
+    if (index < 0) index = deque->len + index;
+
+    //check for < 0 to range-check normalised negative indeces
+    if (index >= deque->len || index < 0) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return -1;
+    }
+
+    return index;
+}
+
+
+
+//ensure space for `entries` elements, doubling the ring as required
+DBG_STATIC
+int _deq_reserve(cm_deq * deque, const size_t entries) {
+
+    size_t new_sz, wrap_len;
+    void * new_data;
+
+
+    if (entries <= deque->sz) return 0;
+
+    new_sz = deque->sz;
+    while (new_sz < entries) new_sz *= 2;
+
+    new_data = realloc(deque->data, new_sz * deque->data_sz);
+    if (new_data == NULL) {
+        cm_errno = CM_ERR_REALLOC;
+        return -1;
+    }
+    deque->data = new_data;
+
+    /*
+     *  If the elements wrapped around the end of the old ring, move the 
+     *  wrapped part to just past the old end so they are contiguous.
+     */
+    if (deque->head + deque->len > deque->sz) {
+
+        wrap_len = deque->head + deque->len - deque->sz;
+        memcpy(deque->data + (deque->sz * deque->data_sz),
+               deque->data, wrap_len * deque->data_sz);
+    }
+
+    deque->sz = new_sz;
+
+    return 0;
+}
+
+
+
+//copy `n` elements into the ring at a logical index, in up to two parts
+DBG_STATIC
+void _deq_copy_in(cm_deq * deque, const size_t index,
+                  const void * src, const size_t n) {
+
+    size_t phys, first_n;
+
+
+    phys = _deq_phys(deque, index);
+    first_n = deque->sz - phys;
+    if (first_n > n) first_n = n;
+
+    memcpy(deque->data + (phys * deque->data_sz), src,
+           first_n * deque->data_sz);
+    memcpy(deque->data, src + (first_n * deque->data_sz),
+           (n - first_n) * deque->data_sz);
+
+    return;
+}
+
+
+
+//copy `n` elements out of the ring from a logical index
+DBG_STATIC
+void _deq_copy_out(const cm_deq * deque, const size_t index,
+                   void * dst, const size_t n) {
+
+    size_t phys, first_n;
+
+
+    phys = _deq_phys(deque, index);
+    first_n = deque->sz - phys;
+    if (first_n > n) first_n = n;
+
+    memcpy(dst, deque->data + (phys * deque->data_sz),
+           first_n * deque->data_sz);
+    memcpy(dst + (first_n * deque->data_sz), deque->data,
+           (n - first_n) * deque->data_sz);
+
+    return;
+}
+
+
+
+/*
+ *  --- [DEQUE - EXTERNAL] ---
+ */
+
+int cm_deq_get(const cm_deq * deque, const int index, void * buf) {
+
+    int norm_index = _deq_normalise_index(deque, index);
+    if (norm_index == -1) return -1;
+
+    memcpy(buf, _deq_traverse(deque, norm_index), deque->data_sz);
+
+    return 0;
+}
+
+
+
+void * cm_deq_get_p(const cm_deq * deque, const int index) {
+
+    int norm_index = _deq_normalise_index(deque, index);
+    if (norm_index == -1) return NULL;
+
+    return _deq_traverse(deque, norm_index);
+}
+
+
+
+int cm_deq_set(cm_deq * deque, const int index, const void * data) {
+
+    int norm_index = _deq_normalise_index(deque, index);
+    if (norm_index == -1) return -1;
+
+    memcpy(_deq_traverse(deque, norm_index), data, deque->data_sz);
+
+    return 0;
+}
+
+
+
+int cm_deq_psh_f(cm_deq * deque, const void * data) {
+
+    return cm_deq_psh_f_n(deque, data, 1);
+}
+
+
+
+int cm_deq_psh_b(cm_deq * deque, const void * data) {
+
+    return cm_deq_psh_b_n(deque, data, 1);
+}
+
+
+
+int cm_deq_pop_f(cm_deq * deque, void * buf) {
+
+    return cm_deq_pop_f_n(deque, buf, 1);
+}
+
+
+
+int cm_deq_pop_b(cm_deq * deque, void * buf) {
+
+    return cm_deq_pop_b_n(deque, buf, 1);
+}
+
+
+
+int cm_deq_psh_f_n(cm_deq * deque, const void * data, const int n) {
+
+    int ret;
+
+
+    if (n < 0) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return -1;
+    }
+
+    ret = _deq_reserve(deque, (size_t) deque->len + n);
+    if (ret != 0) return -1;
+
+    //move the head back, the elements keep their order at the front
+    deque->head = (deque->head - n) & (deque->sz - 1);
+    _deq_copy_in(deque, 0, data, n);
+    deque->len += n;
+
+    return 0;
+}
+
+
+
+int cm_deq_psh_b_n(cm_deq * deque, const void * data, const int n) {
+
+    int ret;
+
+
+    if (n < 0) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return -1;
+    }
+
+    ret = _deq_reserve(deque, (size_t) deque->len + n);
+    if (ret != 0) return -1;
+
+    _deq_copy_in(deque, deque->len, data, n);
+    deque->len += n;
+
+    return 0;
+}
+
+
+
+int cm_deq_pop_f_n(cm_deq * deque, void * buf, const int n) {
+
+    //there must be enough elements
+    if (n < 0 || n > deque->len) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return -1;
+    }
+
+    if (buf != NULL) _deq_copy_out(deque, 0, buf, n);
+    deque->head = _deq_phys(deque, n);
+    deque->len -= n;
+
+    return 0;
+}
+
+
+
+int cm_deq_pop_b_n(cm_deq * deque, void * buf, const int n) {
+
+    //there must be enough elements
+    if (n < 0 || n > deque->len) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return -1;
+    }
+
+    if (buf != NULL) _deq_copy_out(deque, deque->len - n, buf, n);
+    deque->len -= n;
+
+    return 0;
+}
+
+
+
+void cm_deq_emp(cm_deq * deque) {
+
+    deque->len  = 0;
+    deque->head = 0;
+
+    return;
+}
+
+
+
+int cm_new_deq(cm_deq * deque, const size_t data_sz) {
+
+    deque->len     = 0;
+    deque->sz      = DEQUE_DEFAULT_SIZE;
+    deque->data_sz = data_sz;
+    deque->head    = 0;
+
+    deque->data = malloc(deque->sz * deque->data_sz);
+    if (deque->data == NULL) {
+        cm_errno = CM_ERR_MALLOC;
+        return -1;
+    }
+    deque->is_init = true;
+
+    return 0;
+}
+
+
+
+void cm_del_deq(cm_deq * deque) {
+
+    free(deque->data);
+    deque->is_init = false;
+
+    return;
+}
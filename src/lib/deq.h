@@ -0,0 +1,50 @@
+#ifndef DEQ_H
+#define DEQ_H
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+
+
+// -- [deque]
+
+//must be a power of two
+#define DEQUE_DEFAULT_SIZE 8
+
+
+#ifdef CM_DEBUG
+//internal
+size_t _deq_phys(const cm_deq * deque, const size_t index);
+void * _deq_traverse(const cm_deq * deque, const size_t index);
+int _deq_normalise_index(const cm_deq * deque, int index);
+int _deq_reserve(cm_deq * deque, const size_t entries);
+void _deq_copy_in(cm_deq * deque, const size_t index,
+                  const void * src, const size_t n);
+void _deq_copy_out(const cm_deq * deque, const size_t index,
+                   void * dst, const size_t n);
+#endif
+
+
+//external
+int cm_deq_get(const cm_deq * deque, const int index, void * buf);
+void * cm_deq_get_p(const cm_deq * deque, const int index);
+int cm_deq_set(cm_deq * deque, const int index, const void * data);
+
+int cm_deq_psh_f(cm_deq * deque, const void * data);
+int cm_deq_psh_b(cm_deq * deque, const void * data);
+int cm_deq_pop_f(cm_deq * deque, void * buf);
+int cm_deq_pop_b(cm_deq * deque, void * buf);
+
+int cm_deq_psh_f_n(cm_deq * deque, const void * data, const int n);
+int cm_deq_psh_b_n(cm_deq * deque, const void * data, const int n);
+int cm_deq_pop_f_n(cm_deq * deque, void * buf, const int n);
+int cm_deq_pop_b_n(cm_deq * deque, void * buf, const int n);
+void cm_deq_emp(cm_deq * deque);
+
+int cm_new_deq(cm_deq * deque, const size_t data_sz);
+void cm_del_deq(cm_deq * deque);
+
+#endif
@@ -0,0 +1,353 @@
+//standard library
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+//system headers
+#include <pthread.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "que.h"
+#include "epoch.h"
+
+
+
+//records registered by this thread, one per epoch domain
+static __thread cm_epoch_thr * _epoch_thrs;
+
+
+
+/*
+ *  A pointer retired in epoch `e` was unlinked before any thread pinned
+ *  at `e + 1`. Once the global epoch reaches `e + 2`, every thread pinned
+ *  at `e` or earlier has unpinned, so the pointer can be freed. The
+ *  global epoch only advances when every pinned thread has seen it.
+ */
+
+
+
+/*
+ *  --- [INTERNAL] ---
+ */
+
+DBG_STATIC DBG_INLINE
+cm_epoch_thr * _epoch_self(const cm_epoch * epoch) {
+
+    cm_epoch_thr * thr;
+
+
+    for (thr = _epoch_thrs; thr != NULL; thr = thr->self_next) {
+        if (thr->epoch == epoch) return thr;
+    }
+
+    return NULL;
+}
+
+
+
+//free entries retired at least two epochs before `global`
+DBG_STATIC
+void _epoch_free(cm_vct * retired, const uint64_t global) {
+
+    int kept = 0;
+    struct _cm_epoch_entry * entries = retired->data;
+
+
+    for (int i = 0; i < retired->len; ++i) {
+
+        if (entries[i].epoch + 2 <= global) {
+            entries[i].del(entries[i].ptr);
+        } else {
+            entries[kept++] = entries[i];
+        }
+    }
+    retired->len = kept;
+
+    return;
+}
+
+
+
+//advance the global epoch if every pinned thread is in it
+DBG_STATIC
+bool _epoch_advance(cm_epoch * epoch) {
+
+    uint64_t global, local;
+    cm_epoch_thr * thr;
+
+
+    //someone else is scanning the registry
+    if (pthread_mutex_trylock(&epoch->lock) != 0) return false;
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    global = __atomic_load_n(&epoch->global, __ATOMIC_RELAXED);
+
+    for (thr = epoch->thrs; thr != NULL; thr = thr->next) {
+
+        local = __atomic_load_n(&thr->local, __ATOMIC_ACQUIRE);
+        if ((local & EPOCH_PINNED) && (local >> 1) != global) {
+            pthread_mutex_unlock(&epoch->lock);
+            return false;
+        }
+    }
+
+    __atomic_store_n(&epoch->global, global + 1, __ATOMIC_SEQ_CST);
+    _epoch_free(&epoch->orphans, global + 1);
+
+    pthread_mutex_unlock(&epoch->lock);
+
+    return true;
+}
+
+
+
+/*
+ *  Fallback when a retired pointer can't be recorded: wait until every
+ *  other thread has been seen outside the current epoch.
+ */
+
+DBG_STATIC
+void _epoch_wait(cm_epoch * epoch, const cm_epoch_thr * self) {
+
+    uint64_t global, local;
+    cm_epoch_thr * thr;
+
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    global = __atomic_load_n(&epoch->global, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&epoch->lock);
+
+    for (thr = epoch->thrs; thr != NULL; thr = thr->next) {
+
+        if (thr == self) continue;
+
+        for (int i = 0; ; ++i) {
+            local = __atomic_load_n(&thr->local, __ATOMIC_ACQUIRE);
+            if (!(local & EPOCH_PINNED) || (local >> 1) > global) break;
+            _que_relax(i);
+        }
+    }
+
+    pthread_mutex_unlock(&epoch->lock);
+
+    return;
+}
+
+
+
+//cm_del_hook entry point; uses the calling thread's record if it has one
+DBG_STATIC
+void _epoch_retire(void * ctx, void * ptr, void (* del)(void *)) {
+
+    int ret;
+    cm_epoch * epoch = ctx;
+    cm_epoch_thr * thr;
+    struct _cm_epoch_entry entry;
+
+
+    thr = _epoch_self(epoch);
+    if (thr != NULL) {
+        cm_epoch_rtr(thr, ptr, del);
+        return;
+    }
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    entry.ptr   = ptr;
+    entry.del   = del;
+    entry.epoch = __atomic_load_n(&epoch->global, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&epoch->lock);
+    ret = cm_vct_apd(&epoch->orphans, &entry);
+    pthread_mutex_unlock(&epoch->lock);
+
+    if (ret != 0) {
+        _epoch_wait(epoch, NULL);
+        del(ptr);
+    }
+
+    return;
+}
+
+
+
+/*
+ *  --- [EXTERNAL] ---
+ */
+
+int cm_epoch_reg(cm_epoch * epoch, cm_epoch_thr * thr) {
+
+    int ret;
+
+
+    ret = cm_new_vct(&thr->retired, sizeof(struct _cm_epoch_entry));
+    if (ret != 0) return -1;
+
+    thr->local = 0;
+    thr->pins  = 0;
+    thr->epoch = epoch;
+
+    pthread_mutex_lock(&epoch->lock);
+    thr->next   = epoch->thrs;
+    epoch->thrs = thr;
+    pthread_mutex_unlock(&epoch->lock);
+
+    thr->self_next = _epoch_thrs;
+    _epoch_thrs    = thr;
+
+    return 0;
+}
+
+
+
+void cm_epoch_unreg(cm_epoch_thr * thr) {
+
+    int i;
+    cm_epoch * epoch = thr->epoch;
+    cm_epoch_thr ** link;
+    struct _cm_epoch_entry * entries;
+
+
+    for (link = &_epoch_thrs; *link != NULL; link = &(*link)->self_next) {
+        if (*link == thr) {
+            *link = thr->self_next;
+            break;
+        }
+    }
+
+    pthread_mutex_lock(&epoch->lock);
+
+    for (link = &epoch->thrs; *link != NULL; link = &(*link)->next) {
+        if (*link == thr) {
+            *link = thr->next;
+            break;
+        }
+    }
+
+    //hand pending pointers to the domain
+    entries = thr->retired.data;
+    for (i = 0; i < thr->retired.len; ++i) {
+        if (cm_vct_apd(&epoch->orphans, &entries[i]) != 0) break;
+    }
+
+    pthread_mutex_unlock(&epoch->lock);
+
+    if (i < thr->retired.len) {
+        _epoch_wait(epoch, NULL);
+        for ( ; i < thr->retired.len; ++i) entries[i].del(entries[i].ptr);
+    }
+
+    cm_del_vct(&thr->retired);
+
+    return;
+}
+
+
+
+void cm_epoch_pin(cm_epoch_thr * thr) {
+
+    uint64_t global;
+
+
+    if (thr->pins++ != 0) return;
+
+    global = __atomic_load_n(&thr->epoch->global, __ATOMIC_RELAXED);
+    __atomic_store_n(&thr->local, (global << 1) | EPOCH_PINNED,
+                     __ATOMIC_RELAXED);
+
+    //publish the pin before reading anything it protects
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    return;
+}
+
+
+
+void cm_epoch_unpin(cm_epoch_thr * thr) {
+
+    if (--thr->pins != 0) return;
+
+    __atomic_store_n(&thr->local, 0, __ATOMIC_RELEASE);
+
+    return;
+}
+
+
+
+void cm_epoch_rtr(cm_epoch_thr * thr, void * ptr, void (* del)(void *)) {
+
+    int ret;
+    struct _cm_epoch_entry entry;
+
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    entry.ptr   = ptr;
+    entry.del   = del;
+    entry.epoch = __atomic_load_n(&thr->epoch->global, __ATOMIC_RELAXED);
+
+    ret = cm_vct_apd(&thr->retired, &entry);
+    if (ret != 0) {
+        _epoch_wait(thr->epoch, thr);
+        del(ptr);
+        return;
+    }
+
+    if (thr->retired.len % EPOCH_BATCH == 0) cm_epoch_rcl(thr);
+
+    return;
+}
+
+
+
+void cm_epoch_rcl(cm_epoch_thr * thr) {
+
+    _epoch_advance(thr->epoch);
+    _epoch_free(&thr->retired,
+                __atomic_load_n(&thr->epoch->global, __ATOMIC_ACQUIRE));
+
+    return;
+}
+
+
+
+int cm_new_epoch(cm_epoch * epoch) {
+
+    int ret;
+
+
+    ret = cm_new_vct(&epoch->orphans, sizeof(struct _cm_epoch_entry));
+    if (ret != 0) return -1;
+
+    pthread_mutex_init(&epoch->lock, NULL);
+
+    epoch->global      = 0;
+    epoch->hook.retire = _epoch_retire;
+    epoch->hook.ctx    = epoch;
+    epoch->thrs        = NULL;
+    epoch->is_init     = true;
+
+    return 0;
+}
+
+
+
+void cm_del_epoch(cm_epoch * epoch) {
+
+    struct _cm_epoch_entry * entries;
+
+
+    //no threads may remain registered
+    entries = epoch->orphans.data;
+    for (int i = 0; i < epoch->orphans.len; ++i) {
+        entries[i].del(entries[i].ptr);
+    }
+
+    cm_del_vct(&epoch->orphans);
+    pthread_mutex_destroy(&epoch->lock);
+
+    epoch->is_init = false;
+
+    return;
+}
@@ -0,0 +1,53 @@
+#ifndef EPOCH_H
+#define EPOCH_H
+
+//standard library
+#include <stdint.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+
+
+// -- [epoch reclamation]
+
+//retired pointers a thread holds before it tries to reclaim them
+#define EPOCH_BATCH 64
+
+//`local` of a pinned thread is its epoch shifted left, with this bit set
+#define EPOCH_PINNED 0x1
+
+
+//a retired pointer & the epoch it was unlinked in
+struct _cm_epoch_entry {
+
+    void * ptr;
+    void (* del)(void *);
+    uint64_t epoch;
+};
+
+
+#ifdef CM_DEBUG
+//internal
+cm_epoch_thr * _epoch_self(const cm_epoch * epoch);
+void _epoch_free(cm_vct * retired, const uint64_t global);
+bool _epoch_advance(cm_epoch * epoch);
+void _epoch_wait(cm_epoch * epoch, const cm_epoch_thr * self);
+void _epoch_retire(void * ctx, void * ptr, void (* del)(void *));
+#endif
+
+
+//external
+int cm_epoch_reg(cm_epoch * epoch, cm_epoch_thr * thr);
+void cm_epoch_unreg(cm_epoch_thr * thr);
+
+void cm_epoch_pin(cm_epoch_thr * thr);
+void cm_epoch_unpin(cm_epoch_thr * thr);
+
+void cm_epoch_rtr(cm_epoch_thr * thr, void * ptr, void (* del)(void *));
+void cm_epoch_rcl(cm_epoch_thr * thr);
+
+int cm_new_epoch(cm_epoch * epoch);
+void cm_del_epoch(cm_epoch * epoch);
+
+#endif
@@ -26,6 +26,38 @@ void cm_perror(const char * prefix) {
             fprintf(stderr, "%s: %s", prefix, CM_ERR_CALLBACK_MSG);
             break;
 
+        case CM_ERR_USER_TRUNC:
+            fprintf(stderr, "%s: %s", prefix, CM_ERR_USER_TRUNC_MSG);
+            break;
+
+        case CM_ERR_USER_ARENA:
+            fprintf(stderr, "%s: %s", prefix, CM_ERR_USER_ARENA_MSG);
+            break;
+
+        case CM_ERR_USER_TYPE:
+            fprintf(stderr, "%s: %s", prefix, CM_ERR_USER_TYPE_MSG);
+            break;
+
+        case CM_ERR_USER_CPU:
+            fprintf(stderr, "%s: %s", prefix, CM_ERR_USER_CPU_MSG);
+            break;
+
+        case CM_ERR_USER_VALUE:
+            fprintf(stderr, "%s: %s", prefix, CM_ERR_USER_VALUE_MSG);
+            break;
+
+        case CM_ERR_USER_ARG:
+            fprintf(stderr, "%s: %s", prefix, CM_ERR_USER_ARG_MSG);
+            break;
+
+        case CM_ERR_USER_FULL:
+            fprintf(stderr, "%s: %s", prefix, CM_ERR_USER_FULL_MSG);
+            break;
+
+        case CM_ERR_USER_EMPTY:
+            fprintf(stderr, "%s: %s", prefix, CM_ERR_USER_EMPTY_MSG);
+            break;
+
         // 2XX - internal errors
         case CM_ERR_INTERNAL_INDEX:
             fprintf(stderr, "%s: %s", prefix, CM_ERR_INTERNAL_INDEX_MSG);
@@ -44,6 +76,18 @@ void cm_perror(const char * prefix) {
             fprintf(stderr, "%s: %s", prefix, CM_ERR_REALLOC_MSG);
             break;
 
+        case CM_ERR_WRITE:
+            fprintf(stderr, "%s: %s", prefix, CM_ERR_WRITE_MSG);
+            break;
+
+        case CM_ERR_READ:
+            fprintf(stderr, "%s: %s", prefix, CM_ERR_READ_MSG);
+            break;
+
+        case CM_ERR_THREAD:
+            fprintf(stderr, "%s: %s", prefix, CM_ERR_THREAD_MSG);
+            break;
+
         default:
             fprintf(stderr, "%s: %s", prefix, "Undefined error code.\n");
             break;
@@ -68,6 +112,30 @@ const char * cm_strerror(const int cm_errnum) {
         case CM_ERR_CALLBACK:
             return CM_ERR_CALLBACK_MSG;
 
+        case CM_ERR_USER_TRUNC:
+            return CM_ERR_USER_TRUNC_MSG;
+
+        case CM_ERR_USER_ARENA:
+            return CM_ERR_USER_ARENA_MSG;
+
+        case CM_ERR_USER_TYPE:
+            return CM_ERR_USER_TYPE_MSG;
+
+        case CM_ERR_USER_CPU:
+            return CM_ERR_USER_CPU_MSG;
+
+        case CM_ERR_USER_VALUE:
+            return CM_ERR_USER_VALUE_MSG;
+
+        case CM_ERR_USER_ARG:
+            return CM_ERR_USER_ARG_MSG;
+
+        case CM_ERR_USER_FULL:
+            return CM_ERR_USER_FULL_MSG;
+
+        case CM_ERR_USER_EMPTY:
+            return CM_ERR_USER_EMPTY_MSG;
+
         // 2XX - internal errors
         case CM_ERR_INTERNAL_INDEX:
             return CM_ERR_INTERNAL_INDEX_MSG;
@@ -81,6 +149,15 @@ const char * cm_strerror(const int cm_errnum) {
 
         case CM_ERR_REALLOC:
             return CM_ERR_REALLOC_MSG;
+
+        case CM_ERR_WRITE:
+            return CM_ERR_WRITE_MSG;
+
+        case CM_ERR_READ:
+            return CM_ERR_READ_MSG;
+
+        case CM_ERR_THREAD:
+            return CM_ERR_THREAD_MSG;
         
         default:
             return "Undefined error code.\n";
@@ -1,12 +1,32 @@
 //standard library
+#include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+#include <time.h>
+
+//system headers
+#include <unistd.h>
 
 //local headers
 #include "cmore.h"
 #include "debug.h"
+#include "func.h"
+#include "arena.h"
+
 
 
+//reallocations performed by cm_meta_type_upd() on this thread
+static __thread unsigned long _func_realloc_cnt;
+
+/*
+ *  Arena of the evaluation in progress on this thread. Stage callbacks &
+ *  cm_meta_type_upd() take no monad, so the arena can't be passed to them;
+ *  an evaluation runs on one thread, so a thread-local finds the right one.
+ */
+static __thread cm_arena * _func_arena;
+
 
 /*
  *  --- [META TYPE - EXTERNAL] ---
@@ -28,12 +48,32 @@ int cm_meta_type_upd(cm_meta_type * value, const int type_id,
     //update the type id
     value->type_id = type_id;
 
+    //a view inside an evaluation moves into the evaluation's arena
+    if (value->is_view && _func_arena != NULL) {
+
+        value->data = cm_arena_alloc(_func_arena, sz);
+        if (value->data == NULL) return -1;
+
+    //a view must not resize memory it does not own
+    } else if (value->is_view) {
+
+        value->data = malloc(sz);
+        if (value->data == NULL) {
+            cm_errno = CM_ERR_MALLOC;
+            return -1;
+        }
+        value->is_view = false;
+
     //reallocate space for the type
-    value->data = realloc(value->data, sz);
-    if (value->data == NULL) {
-        cm_errno = CM_ERR_REALLOC;
-        return -1;
+    } else {
+
+        value->data = realloc(value->data, sz);
+        if (value->data == NULL) {
+            cm_errno = CM_ERR_REALLOC;
+            return -1;
+        }
     }
+    ++_func_realloc_cnt;
 
     //copy the data
     value->sz = sz;
@@ -75,6 +115,7 @@ int cm_new_meta_type(cm_meta_type * value, const int type_id,
     memcpy(value->data, data, value->sz);
 
     //set meta type as initialised
+    value->is_view = false;
     value->is_init = true;
     
     return 0;
@@ -82,10 +123,27 @@ int cm_new_meta_type(cm_meta_type * value, const int type_id,
 
 
 
+void cm_meta_type_view(cm_meta_type * value, const int type_id,
+                       void * data, const size_t sz) {
+
+    //borrow the data
+    value->type_id = type_id;
+    value->sz      = sz;
+    value->data    = data;
+
+    //set meta type as an initialised view
+    value->is_view = true;
+    value->is_init = true;
+
+    return;
+}
+
+
+
 void cm_del_meta_type(cm_meta_type * value) {
 
     //deallocate space for the type
-    free(value->data);
+    if (!value->is_view) free(value->data);
 
     //set meta type as uninitialised
     value->is_init = false;
@@ -96,21 +154,28 @@ void cm_del_meta_type(cm_meta_type * value) {
 
 
 /*
- *  --- [MONAD - EXTERNAL] ---
+ *  --- [MONAD - INTERNAL] ---
  */
 
-int cm_monad_compose(cm_monad * monad,
-                     cm_meta_type * (* cb)(cm_meta_type *, void * ctx)) {
+DBG_STATIC DBG_INLINE
+unsigned long long _monad_now_ns() {
 
-    cm_lst_node * new_cb_node = cm_lst_apd(&monad->thunk, &cb);
-    if (new_cb_node == NULL) return -1;
+    struct timespec ts;
 
-    return 0;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((unsigned long long) ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
 }
 
 
 
-int cm_monad_eval(cm_monad * monad, cm_meta_type * value, void * ctx) {
+/*
+ *  Both evaluation loops report the meta type returned by the final stage
+ *  that ran through `result`.
+ */
+
+DBG_STATIC
+int _monad_eval(cm_monad * monad, cm_meta_type * value,
+                void * ctx, cm_meta_type ** result) {
 
     cm_meta_type * tmp_value;
     cm_lst_node * thunk_node;
@@ -127,6 +192,7 @@ int cm_monad_eval(cm_monad * monad, cm_meta_type * value, void * ctx) {
         //call this callback
         cb = *(cm_meta_type * (**)(cm_meta_type *, void *)) thunk_node->data;
         tmp_value = cb(tmp_value, ctx);
+        *result = tmp_value;
 
         //terminate early on error
         if (tmp_value->type_id == CM_MONAD_FAIL_TYPE) return -1;
@@ -135,6 +201,838 @@ int cm_monad_eval(cm_monad * monad, cm_meta_type * value, void * ctx) {
         thunk_node = thunk_node->next;
     }
 
+    *result = tmp_value;
+
+    return 0;
+}
+
+
+
+/*
+ *  Instrumented counterpart of _monad_eval(). Kept separate so that the 
+ *  uninstrumented loop stays untouched.
+ */
+
+DBG_STATIC
+int _monad_eval_prof(cm_monad * monad, cm_meta_type * value,
+                     void * ctx, cm_meta_type ** result) {
+
+    cm_meta_type * tmp_value;
+    cm_lst_node * thunk_node;
+    cm_monad_stat * stat;
+    cm_meta_type * (* cb)(cm_meta_type *, void *);
+
+    unsigned long realloc_cnt;
+    unsigned long long start_ns;
+
+
+    //setup iteration
+    tmp_value = value;
+    thunk_node = monad->thunk.head;
+    stat = monad->stats.data;
+
+    //execute all callbacks
+    for (int i = 0; i < monad->thunk.len; ++i) {
+
+        //snapshot counters
+        realloc_cnt = _func_realloc_cnt;
+        start_ns = _monad_now_ns();
+
+        //call this callback
+        cb = *(cm_meta_type * (**)(cm_meta_type *, void *)) thunk_node->data;
+        tmp_value = cb(tmp_value, ctx);
+        *result = tmp_value;
+
+        //record this stage
+        stat[i].ns       += _monad_now_ns() - start_ns;
+        stat[i].reallocs += _func_realloc_cnt - realloc_cnt;
+        stat[i].calls    += 1;
+
+        //terminate early on error
+        if (tmp_value->type_id == CM_MONAD_FAIL_TYPE) {
+            stat[i].fails += 1;
+            return -1;
+        }
+
+        //advance iteration
+        thunk_node = thunk_node->next;
+    }
+
+    *result = tmp_value;
+
+    return 0;
+}
+
+
+
+/*
+ *  Read as much as is available up to `sz` bytes, retrying on interrupts.
+ *  Returns 0 at end of input.
+ */
+
+DBG_STATIC
+ssize_t _monad_read(const int fd, void * buf, const size_t sz) {
+
+    ssize_t read_bytes;
+
+    do {
+        read_bytes = read(fd, buf, sz);
+    } while (read_bytes == -1 && errno == EINTR);
+
+    if (read_bytes == -1) cm_errno = CM_ERR_READ;
+
+    return read_bytes;
+}
+
+
+
+//write all `sz` bytes, retrying on short writes & interrupts
+DBG_STATIC
+int _monad_write(const int fd, const void * buf, const size_t sz) {
+
+    ssize_t write_bytes;
+    size_t done = 0;
+
+
+    while (done < sz) {
+
+        write_bytes = write(fd, (const cm_byte *) buf + done, sz - done);
+        if (write_bytes == -1) {
+            if (errno == EINTR) continue;
+            cm_errno = CM_ERR_WRITE;
+            return -1;
+        }
+
+        done += (size_t) write_bytes;
+    }
+
+    return 0;
+}
+
+
+
+//append a result to the output buffer, flushing it as required
+DBG_STATIC
+int _monad_emit(const int fd, cm_byte * buf, const size_t sz,
+                size_t * len, const cm_meta_type * result) {
+
+    int ret;
+
+
+    //flush if this result does not fit
+    if (*len + result->sz > sz) {
+        ret = _monad_write(fd, buf, *len);
+        if (ret != 0) return -1;
+        *len = 0;
+    }
+
+    //results larger than the buffer are written directly
+    if (result->sz > sz) return _monad_write(fd, result->data, result->sz);
+
+    memcpy(buf + *len, result->data, result->sz);
+    *len += result->sz;
+
+    return 0;
+}
+
+
+
+//64-bit FNV-1a
+DBG_STATIC DBG_INLINE
+uint64_t _monad_hash(const void * data, const size_t sz) {
+
+    const cm_byte * byte = data;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (size_t i = 0; i < sz; ++i) {
+        hash ^= byte[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+
+
+DBG_STATIC
+enum cm_rbt_side _monad_cache_compare(const void * key_0, const void * key_1) {
+
+    const struct _monad_cache_key * k_0 = key_0;
+    const struct _monad_cache_key * k_1 = key_1;
+
+    if (k_0->type_id < k_1->type_id) return CM_RBT_LESS;
+    if (k_0->type_id > k_1->type_id) return CM_RBT_MORE;
+    if (k_0->hash < k_1->hash) return CM_RBT_LESS;
+    if (k_0->hash > k_1->hash) return CM_RBT_MORE;
+
+    return CM_RBT_EQUAL;
+}
+
+
+
+/*
+ *  Copies a meta type's value into another meta type, reusing the 
+ *  destination's storage where possible.
+ */
+
+DBG_STATIC
+int _monad_assign(cm_meta_type * dst_value, const cm_meta_type * src_value) {
+
+    //destination is not initialised yet
+    if (dst_value->is_init == false) {
+        return cm_new_meta_type(dst_value, src_value->type_id,
+                                src_value->data, src_value->sz);
+    }
+
+    //destination has the wrong size
+    if (dst_value->sz != src_value->sz) {
+        return cm_meta_type_upd(dst_value, src_value->type_id,
+                                src_value->data, src_value->sz);
+    }
+
+    dst_value->type_id = src_value->type_id;
+    memcpy(dst_value->data, src_value->data, src_value->sz);
+
+    return 0;
+}
+
+
+
+DBG_STATIC
+void _monad_cache_rls(cm_monad_cache * cache, const int idx) {
+
+    struct _monad_cache_slot * slot = cm_vct_get_p(&cache->slots, idx);
+
+    //drop the slot from the index, keeping its storage for reuse
+    cm_rbt_rmv(&cache->index, &slot->key);
+    slot->is_used = false;
+    cache->len -= 1;
+
+    return;
+}
+
+
+
+/*
+ *  Returns the index of an unused slot, evicting with CLOCK if all slots
+ *  are in use. Referenced slots get a second chance.
+ */
+
+DBG_STATIC
+int _monad_cache_claim(cm_monad_cache * cache) {
+
+    int idx;
+    struct _monad_cache_slot * slot;
+
+
+    while (true) {
+
+        idx = cache->hand;
+        slot = cm_vct_get_p(&cache->slots, idx);
+        cache->hand = (cache->hand + 1) % cache->sz;
+
+        //free slot
+        if (slot->is_used == false) return idx;
+
+        //recently hit slot
+        if (slot->ref == true) {
+            slot->ref = false;
+            continue;
+        }
+
+        //evict
+        _monad_cache_rls(cache, idx);
+        cache->stat.evictions += 1;
+
+        return idx;
+    }
+}
+
+
+
+DBG_STATIC
+int _monad_eval_cache(cm_monad * monad, cm_meta_type * value, void * ctx) {
+
+    int ret, eval_ret, idx;
+    int * idx_p;
+
+    cm_meta_type * result;
+    cm_monad_cache * cache;
+    struct _monad_cache_key key;
+    struct _monad_cache_slot * slot;
+
+
+    cache = &monad->cache;
+
+    //build the key for this input
+    memset(&key, 0, sizeof(key));
+    key.type_id = value->type_id;
+    key.hash    = _monad_hash(value->data, value->sz);
+
+    //look for a previous evaluation of this input
+    idx_p = cm_rbt_get_p(&cache->index, &key);
+    if (idx_p != NULL) {
+
+        slot = cm_vct_get_p(&cache->slots, *idx_p);
+
+        //hit if the input matches, not just the hash
+        if (slot->in.sz == value->sz 
+            && memcmp(slot->in.data, value->data, value->sz) == 0) {
+
+            cache->stat.hits += 1;
+            slot->ref = true;
+
+            ret = _monad_assign(value, &slot->out);
+            if (ret != 0) return -1;
+
+            return slot->ret;
+        }
+
+        //hash collision, replace the old entry
+        idx = *idx_p;
+        _monad_cache_rls(cache, idx);
+    
+    } else {
+        idx = _monad_cache_claim(cache);
+    }
+
+    cache->stat.misses += 1;
+    slot = cm_vct_get_p(&cache->slots, idx);
+
+    //save the input before stages modify it
+    ret = _monad_assign(&slot->in, value);
+    if (ret != 0) return -1;
+
+    //evaluate
+    if (monad->is_prof) {
+        eval_ret = _monad_eval_prof(monad, value, ctx, &result);
+    } else {
+        eval_ret = _monad_eval(monad, value, ctx, &result);
+    }
+
+    //leave the result in the caller's value
+    if (result != value) {
+        ret = _monad_assign(value, result);
+        if (ret != 0) return -1;
+    }
+
+    //save the result
+    ret = _monad_assign(&slot->out, value);
+    if (ret != 0) return -1;
+
+    slot->key = key;
+    slot->ret = eval_ret;
+    slot->ref = false;
+
+    //publish the slot
+    if (cm_rbt_set(&cache->index, &key, &idx) == NULL) return -1;
+    slot->is_used = true;
+    cache->len += 1;
+
+    return eval_ret;
+}
+
+
+
+//evaluate through the cache and instrumentation as configured
+DBG_STATIC DBG_INLINE
+int _monad_dispatch(cm_monad * monad, cm_meta_type * value,
+                    void * ctx, cm_meta_type ** result) {
+
+    //the cache always leaves the result in `value`
+    if (monad->is_cache) {
+        *result = value;
+        return _monad_eval_cache(monad, value, ctx);
+    }
+
+    if (monad->is_prof) return _monad_eval_prof(monad, value, ctx, result);
+
+    return _monad_eval(monad, value, ctx, result);
+}
+
+
+
+/*
+ *  Evaluates with the monad's arena active, then moves the result out of
+ *  the arena before resetting it.
+ */
+
+DBG_STATIC
+int _monad_eval_arena(cm_monad * monad, cm_meta_type * value, void * ctx) {
+
+    int ret, eval_ret;
+    void * data;
+    cm_arena * prev_arena;
+    cm_meta_type * result;
+
+
+    //evaluate with the arena active
+    data = value->data;
+    prev_arena = _func_arena;
+    _func_arena = monad->arena;
+
+    eval_ret = _monad_dispatch(monad, value, ctx, &result);
+    _func_arena = prev_arena;
+
+    //leave the result in the caller's value
+    ret = 0;
+    if (result != value) ret = _monad_assign(value, result);
+
+    //a view moved into an arena now needs storage of its own
+    if (ret == 0 && value->is_view && value->data != data) {
+
+        data = value->data;
+        value->data = malloc(value->sz);
+        if (value->data == NULL) {
+            cm_errno = CM_ERR_MALLOC;
+            ret = -1;
+        } else {
+            memcpy(value->data, data, value->sz);
+            value->is_view = false;
+        }
+    }
+
+    cm_arena_rst(monad->arena);
+
+    return ret != 0 ? -1 : eval_ret;
+}
+
+
+
+/*
+ *  --- [MONAD - EXTERNAL] ---
+ */
+
+int cm_monad_compose(cm_monad * monad,
+                     cm_meta_type * (* cb)(cm_meta_type *, void * ctx)) {
+
+    int ret;
+    cm_monad_stat stat;
+    cm_lst_node * new_cb_node;
+
+
+    //track the new stage first, so a failed append leaves no untracked stage
+    if (monad->is_prof) {
+
+        memset(&stat, 0, sizeof(stat));
+        ret = cm_vct_apd(&monad->stats, &stat);
+        if (ret != 0) return -1;
+    }
+
+    new_cb_node = cm_lst_apd(&monad->thunk, &cb);
+    if (new_cb_node == NULL) {
+        if (monad->is_prof) --monad->stats.len;
+        return -1;
+    }
+
+    //cached results no longer apply
+    if (monad->is_cache) cm_monad_cache_emp(monad);
+
+    return 0;
+}
+
+
+
+int cm_monad_eval(cm_monad * monad, cm_meta_type * value, void * ctx) {
+
+    cm_meta_type * result;
+
+
+    if (monad->arena != NULL) return _monad_eval_arena(monad, value, ctx);
+
+    return _monad_dispatch(monad, value, ctx, &result);
+}
+
+
+
+ssize_t cm_monad_eval_fd(cm_monad * monad, const int in_fd,
+                         const int out_fd, const int type_id,
+                         const size_t rec_sz, void * ctx) {
+
+    int ret, eval_ret;
+    ssize_t read_bytes, records;
+    size_t in_sz, in_len, in_off, out_sz, out_len;
+
+    cm_byte * in_buf, * out_buf;
+    cm_meta_type value, * result;
+    cm_arena * prev_arena = _func_arena;
+
+
+    if (rec_sz == 0) {
+        cm_errno = CM_ERR_USER_ARG;
+        return -1;
+    }
+
+    //size buffers to a whole number of records
+    in_sz = (CM_MONAD_STREAM_SZ / rec_sz) * rec_sz;
+    if (in_sz == 0) in_sz = rec_sz;
+    out_sz = in_sz;
+
+    in_buf = malloc(in_sz);
+    if (in_buf == NULL) {
+        cm_errno = CM_ERR_MALLOC;
+        return -1;
+    }
+
+    out_buf = malloc(out_sz);
+    if (out_buf == NULL) {
+        free(in_buf);
+        cm_errno = CM_ERR_MALLOC;
+        return -1;
+    }
+
+    //the value is re-pointed at each record
+    cm_meta_type_view(&value, type_id, in_buf, rec_sz);
+
+    in_len  = 0;
+    out_len = 0;
+    records = 0;
+
+    //read until end of input
+    while (true) {
+
+        read_bytes = _monad_read(in_fd, in_buf + in_len, in_sz - in_len);
+        if (read_bytes == -1) break;
+
+        //end of input, complain about a partial record
+        if (read_bytes == 0) {
+            if (in_len != 0) {
+                cm_errno = CM_ERR_USER_TRUNC;
+                read_bytes = -1;
+            }
+            break;
+        }
+        in_len += (size_t) read_bytes;
+
+        //evaluate every whole record in the buffer
+        for (in_off = 0; in_len - in_off >= rec_sz; in_off += rec_sz) {
+
+            //drop storage a stage allocated for the previous record
+            if (!value.is_view) free(value.data);
+            cm_meta_type_view(&value, type_id, in_buf + in_off, rec_sz);
+
+            //stage allocations live until the result is emitted
+            _func_arena = monad->arena;
+            eval_ret = _monad_dispatch(monad, &value, ctx, &result);
+            _func_arena = prev_arena;
+
+            //emit successful results
+            ret = 0;
+            if (eval_ret == 0) {
+                ret = _monad_emit(out_fd, out_buf, out_sz, &out_len, result);
+                if (ret == 0) ++records;
+            }
+
+            if (monad->arena != NULL) cm_arena_rst(monad->arena);
+            if (ret != 0) {
+                read_bytes = -1;
+                break;
+            }
+        }
+
+        //stop on a write error
+        if (read_bytes == -1) break;
+
+        //move a trailing partial record to the front of the buffer
+        in_len -= in_off;
+        memmove(in_buf, in_buf + in_off, in_len);
+    }
+
+    //flush remaining output, unless writing is what failed
+    if (read_bytes != -1 || cm_errno != CM_ERR_WRITE) {
+        ret = _monad_write(out_fd, out_buf, out_len);
+        if (ret != 0) read_bytes = -1;
+    }
+
+    //cleanup
+    if (!value.is_view) free(value.data);
+    free(in_buf);
+    free(out_buf);
+
+    return read_bytes == -1 ? -1 : records;
+}
+
+
+
+int cm_monad_prof_on(cm_monad * monad) {
+
+    int ret;
+
+
+    //do nothing if already profiling
+    if (monad->is_prof) return 0;
+
+    //allocate a zeroed record for every stage
+    ret = cm_new_vct(&monad->stats, sizeof(cm_monad_stat));
+    if (ret != 0) return -1;
+
+    ret = cm_vct_rsz(&monad->stats, monad->thunk.len);
+    if (ret != 0) {
+        cm_del_vct(&monad->stats);
+        return -1;
+    }
+    memset(monad->stats.data, 0, sizeof(cm_monad_stat) * monad->thunk.len);
+
+    monad->is_prof = true;
+
+    return 0;
+}
+
+
+
+void cm_monad_prof_off(cm_monad * monad) {
+
+    if (!monad->is_prof) return;
+
+    cm_del_vct(&monad->stats);
+    monad->is_prof = false;
+
+    return;
+}
+
+
+
+void cm_monad_prof_rst(cm_monad * monad) {
+
+    if (!monad->is_prof) return;
+
+    memset(monad->stats.data, 0, sizeof(cm_monad_stat) * monad->stats.len);
+
+    return;
+}
+
+
+
+int cm_monad_prof_get(const cm_monad * monad,
+                      const int stage, cm_monad_stat * buf) {
+
+    //profiling must be enabled
+    if (!monad->is_prof) {
+        cm_errno = CM_ERR_USER_ARG;
+        return -1;
+    }
+
+    return cm_vct_get(&monad->stats, stage, buf);
+}
+
+
+
+int cm_monad_prof_dump(const cm_monad * monad,
+                       const int fd, const enum cm_monad_fmt fmt) {
+
+    int ret;
+    cm_monad_stat * stat;
+
+
+    //profiling must be enabled
+    if (!monad->is_prof) {
+        cm_errno = CM_ERR_USER_ARG;
+        return -1;
+    }
+
+    stat = monad->stats.data;
+
+    //header
+    if (fmt == CM_MONAD_FMT_JSON) {
+        ret = dprintf(fd, "{\"stages\": [");
+    } else {
+        ret = dprintf(fd, "%-6s %12s %12s %12s %16s %12s\n",
+                      "stage", "calls", "fails", "reallocs", "ns", "ns/call");
+    }
+    if (ret < 0) {
+        cm_errno = CM_ERR_WRITE;
+        return -1;
+    }
+
+    //one entry per stage
+    for (int i = 0; i < monad->stats.len; ++i) {
+
+        if (fmt == CM_MONAD_FMT_JSON) {
+            ret = dprintf(fd, "%s{\"stage\": %d, \"calls\": %lu, "
+                          "\"fails\": %lu, \"reallocs\": %lu, \"ns\": %llu}",
+                          i == 0 ? "" : ", ", i, stat[i].calls,
+                          stat[i].fails, stat[i].reallocs, stat[i].ns);
+        } else {
+            ret = dprintf(fd, "%-6d %12lu %12lu %12lu %16llu %12llu\n",
+                          i, stat[i].calls, stat[i].fails, stat[i].reallocs,
+                          stat[i].ns, stat[i].calls == 0
+                                      ? 0 : stat[i].ns / stat[i].calls);
+        }
+        if (ret < 0) {
+            cm_errno = CM_ERR_WRITE;
+            return -1;
+        }
+    }
+
+    //footer
+    if (fmt == CM_MONAD_FMT_JSON) {
+        ret = dprintf(fd, "]}\n");
+        if (ret < 0) {
+            cm_errno = CM_ERR_WRITE;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+
+void cm_monad_set_arena(cm_monad * monad, cm_arena * arena) {
+
+    monad->arena = arena;
+
+    return;
+}
+
+
+
+cm_meta_type * cm_monad_new_meta_type(const int type_id,
+                                      const void * data, const size_t sz) {
+
+    cm_meta_type * value;
+
+
+    //only available to stages of an evaluation with an arena
+    if (_func_arena == NULL) {
+        cm_errno = CM_ERR_USER_ARENA;
+        return NULL;
+    }
+
+    value = cm_arena_alloc(_func_arena, sizeof(*value));
+    if (value == NULL) return NULL;
+
+    value->data = cm_arena_alloc(_func_arena, sz);
+    if (value->data == NULL) return NULL;
+
+    //the arena owns the data
+    value->type_id = type_id;
+    value->sz      = sz;
+    memcpy(value->data, data, sz);
+
+    value->is_view = true;
+    value->is_init = true;
+
+    return value;
+}
+
+
+
+void * cm_monad_alloc(const size_t sz) {
+
+    //only available to stages of an evaluation with an arena
+    if (_func_arena == NULL) {
+        cm_errno = CM_ERR_USER_ARENA;
+        return NULL;
+    }
+
+    return cm_arena_alloc(_func_arena, sz);
+}
+
+
+
+int cm_monad_cache_on(cm_monad * monad, const int slots) {
+
+    int ret;
+    cm_monad_cache * cache = &monad->cache;
+
+
+    //do nothing if already caching
+    if (monad->is_cache) return 0;
+
+    //need at least one slot
+    if (slots <= 0) {
+        cm_errno = CM_ERR_USER_ARG;
+        return -1;
+    }
+
+    //allocate zeroed slots
+    ret = cm_new_vct(&cache->slots, sizeof(struct _monad_cache_slot));
+    if (ret != 0) return -1;
+
+    ret = cm_vct_rsz(&cache->slots, slots);
+    if (ret != 0) {
+        cm_del_vct(&cache->slots);
+        return -1;
+    }
+    memset(cache->slots.data, 0, sizeof(struct _monad_cache_slot) * slots);
+
+    //initialise the index
+    cm_new_rbt(&cache->index, sizeof(struct _monad_cache_key),
+               sizeof(int), _monad_cache_compare);
+
+    cache->len  = 0;
+    cache->sz   = slots;
+    cache->hand = 0;
+    memset(&cache->stat, 0, sizeof(cache->stat));
+
+    monad->is_cache = true;
+
+    return 0;
+}
+
+
+
+void cm_monad_cache_off(cm_monad * monad) {
+
+    struct _monad_cache_slot * slot;
+    cm_monad_cache * cache = &monad->cache;
+
+
+    if (!monad->is_cache) return;
+
+    //free storage held by every slot
+    for (int i = 0; i < cache->sz; ++i) {
+
+        slot = cm_vct_get_p(&cache->slots, i);
+        if (slot->in.is_init) cm_del_meta_type(&slot->in);
+        if (slot->out.is_init) cm_del_meta_type(&slot->out);
+    }
+
+    cm_del_rbt(&cache->index);
+    cm_del_vct(&cache->slots);
+    monad->is_cache = false;
+
+    return;
+}
+
+
+
+void cm_monad_cache_emp(cm_monad * monad) {
+
+    struct _monad_cache_slot * slot;
+    cm_monad_cache * cache = &monad->cache;
+
+
+    if (!monad->is_cache) return;
+
+    //mark every slot as unused, keeping storage for reuse
+    for (int i = 0; i < cache->sz; ++i) {
+
+        slot = cm_vct_get_p(&cache->slots, i);
+        slot->is_used = false;
+        slot->ref = false;
+    }
+
+    cm_rbt_emp(&cache->index);
+    cache->len  = 0;
+    cache->hand = 0;
+
+    return;
+}
+
+
+
+int cm_monad_cache_get(const cm_monad * monad, cm_monad_cache_stat * buf) {
+
+    //caching must be enabled
+    if (!monad->is_cache) {
+        cm_errno = CM_ERR_USER_ARG;
+        return -1;
+    }
+
+    memcpy(buf, &monad->cache.stat, sizeof(*buf));
+
     return 0;
 }
 
@@ -145,6 +1043,13 @@ void cm_new_monad(cm_monad * monad) {
     //initialise the function list
     cm_new_lst(&monad->thunk, sizeof(void *));
 
+    //profiling & caching are disabled by default
+    monad->is_prof  = false;
+    monad->is_cache = false;
+
+    //no arena by default
+    monad->arena = NULL;
+
     //set monad as initialised
     monad->is_init = true;
 
@@ -158,6 +1063,10 @@ void cm_del_monad(cm_monad * monad) {
     //delete the function list
     cm_del_lst(&monad->thunk);
 
+    //delete instrumentation & cache
+    cm_monad_prof_off(monad);
+    cm_monad_cache_off(monad);
+
     //set monad as uninitialised
     monad->is_init = false;
 
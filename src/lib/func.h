@@ -1,6 +1,12 @@
 #ifndef FUNC_H
 #define FUNC_H
 
+//standard library
+#include <stdint.h>
+
+//system headers
+#include <unistd.h>
+
 //local headers
 #include "cmore.h"
 #include "debug.h"
@@ -17,16 +23,86 @@ int cm_meta_type_cpy(cm_meta_type * dst_value,
 
 int cm_new_meta_type(cm_meta_type * value,
                      const int type_id, const void * data, const size_t sz);
+void cm_meta_type_view(cm_meta_type * value, const int type_id,
+                       void * data, const size_t sz);
 void cm_del_meta_type(cm_meta_type * meta_value);
 
 
 
 // -- [monad]
 
+//streaming buffer size
+#define CM_MONAD_STREAM_SZ 0x100000
+
+//key of a cached evaluation
+struct _monad_cache_key {
+
+    int type_id;
+    uint64_t hash;
+};
+
+//cached evaluation
+struct _monad_cache_slot {
+
+    struct _monad_cache_key key;
+    cm_meta_type in;
+    cm_meta_type out;
+    int ret;
+
+    bool ref;     //CLOCK reference bit
+    bool is_used;
+};
+
+
+#ifdef CM_DEBUG
+//internal
+unsigned long long _monad_now_ns();
+int _monad_eval(cm_monad * monad, cm_meta_type * value,
+                void * ctx, cm_meta_type ** result);
+int _monad_eval_prof(cm_monad * monad, cm_meta_type * value,
+                     void * ctx, cm_meta_type ** result);
+
+ssize_t _monad_read(const int fd, void * buf, const size_t sz);
+int _monad_write(const int fd, const void * buf, const size_t sz);
+int _monad_emit(const int fd, cm_byte * buf, const size_t sz,
+                size_t * len, const cm_meta_type * result);
+uint64_t _monad_hash(const void * data, const size_t sz);
+enum cm_rbt_side _monad_cache_compare(const void * key_0, const void * key_1);
+int _monad_assign(cm_meta_type * dst_value, const cm_meta_type * src_value);
+void _monad_cache_rls(cm_monad_cache * cache, const int idx);
+int _monad_cache_claim(cm_monad_cache * cache);
+int _monad_eval_cache(cm_monad * monad, cm_meta_type * value, void * ctx);
+int _monad_dispatch(cm_monad * monad, cm_meta_type * value,
+                    void * ctx, cm_meta_type ** result);
+int _monad_eval_arena(cm_monad * monad, cm_meta_type * value, void * ctx);
+#endif
+
+
 //external
 int cm_monad_compose(cm_monad * monad,
                      cm_meta_type * (* cb)(cm_meta_type *, void * ctx));
 int cm_monad_eval(cm_monad * monad, cm_meta_type * value, void * ctx);
+ssize_t cm_monad_eval_fd(cm_monad * monad, const int in_fd,
+                         const int out_fd, const int type_id,
+                         const size_t rec_sz, void * ctx);
+
+int cm_monad_prof_on(cm_monad * monad);
+void cm_monad_prof_off(cm_monad * monad);
+void cm_monad_prof_rst(cm_monad * monad);
+int cm_monad_prof_get(const cm_monad * monad,
+                      const int stage, cm_monad_stat * buf);
+int cm_monad_prof_dump(const cm_monad * monad,
+                       const int fd, const enum cm_monad_fmt fmt);
+
+void cm_monad_set_arena(cm_monad * monad, cm_arena * arena);
+cm_meta_type * cm_monad_new_meta_type(const int type_id,
+                                      const void * data, const size_t sz);
+void * cm_monad_alloc(const size_t sz);
+
+int cm_monad_cache_on(cm_monad * monad, const int slots);
+void cm_monad_cache_off(cm_monad * monad);
+void cm_monad_cache_emp(cm_monad * monad);
+int cm_monad_cache_get(const cm_monad * monad, cm_monad_cache_stat * buf);
 
 void cm_new_monad(cm_monad * monad);
 void cm_del_monad(cm_monad * monad);
@@ -0,0 +1,703 @@
+//standard library
+#include <stdlib.h>
+#include <string.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "heap.h"
+
+
+
+/*
+ *  --- [HEAP - INTERNAL] ---
+ */
+
+DBG_STATIC DBG_INLINE
+void * _heap_traverse(const cm_heap * heap, const int index) {
+
+    return heap->data.data + (heap->data.data_sz * index);
+}
+
+
+
+//true if `data_0` belongs above `data_1`
+DBG_STATIC DBG_INLINE
+bool _heap_is_above(const cm_heap * heap,
+                    const void * data_0, const void * data_1) {
+
+    return heap->compare(data_0, data_1) == CM_RBT_LESS;
+}
+
+
+
+/*
+ *  Both sift functions move a hole rather than swapping elements; `data`
+ *  is written once, into the hole's final position.
+ */
+
+DBG_STATIC
+void _heap_sift_up(cm_heap * heap, int index, const void * data) {
+
+    int parent;
+    void * parent_data;
+
+
+    while (index > 0) {
+
+        parent = (index - 1) / heap->arity;
+        parent_data = _heap_traverse(heap, parent);
+        if (!_heap_is_above(heap, data, parent_data)) break;
+
+        //move the parent down into the hole
+        memcpy(_heap_traverse(heap, index), parent_data, heap->data.data_sz);
+        index = parent;
+    }
+
+    memcpy(_heap_traverse(heap, index), data, heap->data.data_sz);
+
+    return;
+}
+
+
+
+DBG_STATIC
+void _heap_sift_down(cm_heap * heap, int index, const void * data) {
+
+    int child, first, last, best;
+    void * best_data;
+
+
+    while (true) {
+
+        //find the highest priority child
+        first = (index * heap->arity) + 1;
+        if (first >= heap->data.len) break;
+
+        last = first + heap->arity;
+        if (last > heap->data.len) last = heap->data.len;
+
+        best = first;
+        best_data = _heap_traverse(heap, first);
+        for (child = first + 1; child < last; ++child) {
+            if (_heap_is_above(heap, _heap_traverse(heap, child), best_data)) {
+                best = child;
+                best_data = _heap_traverse(heap, child);
+            }
+        }
+
+        if (!_heap_is_above(heap, best_data, data)) break;
+
+        //move the child up into the hole
+        memcpy(_heap_traverse(heap, index), best_data, heap->data.data_sz);
+        index = best;
+    }
+
+    memcpy(_heap_traverse(heap, index), data, heap->data.data_sz);
+
+    return;
+}
+
+
+
+//Floyd's heap construction, O(n)
+DBG_STATIC
+void _heap_build(cm_heap * heap) {
+
+    if (heap->data.len < 2) return;
+
+    //sift down every node that has children, deepest first
+    for (int i = (heap->data.len - 2) / heap->arity; i >= 0; --i) {
+
+        memcpy(heap->tmp, _heap_traverse(heap, i), heap->data.data_sz);
+        _heap_sift_down(heap, i, heap->tmp);
+    }
+
+    return;
+}
+
+
+
+DBG_STATIC
+int _heap_init(cm_heap * heap, const int arity,
+               enum cm_rbt_side (*compare)(const void *, const void *)) {
+
+    //a node needs at least two children
+    if (arity < 2) {
+        cm_errno = CM_ERR_USER_ARG;
+        return -1;
+    }
+
+    //scratch space for the element being sifted
+    heap->tmp = malloc(heap->data.data_sz);
+    if (heap->tmp == NULL) {
+        cm_errno = CM_ERR_MALLOC;
+        return -1;
+    }
+
+    heap->arity   = arity;
+    heap->compare = compare;
+    heap->is_init = true;
+
+    return 0;
+}
+
+
+
+/*
+ *  --- [HEAP - EXTERNAL] ---
+ */
+
+int cm_heap_pek(const cm_heap * heap, void * buf) {
+
+    //heap must not be empty
+    if (heap->data.len == 0) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return -1;
+    }
+
+    memcpy(buf, heap->data.data, heap->data.data_sz);
+
+    return 0;
+}
+
+
+
+void * cm_heap_pek_p(const cm_heap * heap) {
+
+    //heap must not be empty
+    if (heap->data.len == 0) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return NULL;
+    }
+
+    return heap->data.data;
+}
+
+
+
+int cm_heap_psh(cm_heap * heap, const void * data) {
+
+    int ret;
+
+
+    //`data` may point into the heap's storage, which may move
+    memcpy(heap->tmp, data, heap->data.data_sz);
+
+    //make space at the end
+    ret = cm_vct_apd(&heap->data, heap->tmp);
+    if (ret != 0) return -1;
+
+    _heap_sift_up(heap, heap->data.len - 1, heap->tmp);
+
+    return 0;
+}
+
+
+
+int cm_heap_pop(cm_heap * heap, void * buf) {
+
+    //heap must not be empty
+    if (heap->data.len == 0) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return -1;
+    }
+
+    if (buf != NULL) memcpy(buf, heap->data.data, heap->data.data_sz);
+
+    //move the last element to the top & sift it down
+    heap->data.len -= 1;
+    if (heap->data.len > 0) {
+        memcpy(heap->tmp, _heap_traverse(heap, heap->data.len),
+               heap->data.data_sz);
+        _heap_sift_down(heap, 0, heap->tmp);
+    }
+
+    return 0;
+}
+
+
+
+int cm_heap_rpl(cm_heap * heap, const void * data, void * buf) {
+
+    //heap must not be empty
+    if (heap->data.len == 0) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return -1;
+    }
+
+    memcpy(heap->tmp, data, heap->data.data_sz);
+    if (buf != NULL) memcpy(buf, heap->data.data, heap->data.data_sz);
+
+    //a single sift replaces a pop followed by a push
+    _heap_sift_down(heap, 0, heap->tmp);
+
+    return 0;
+}
+
+
+
+void cm_heap_emp(cm_heap * heap) {
+
+    cm_vct_emp(&heap->data);
+
+    return;
+}
+
+
+
+int cm_new_heap(cm_heap * heap, const size_t data_sz, const int arity,
+                enum cm_rbt_side (*compare)(const void *, const void *)) {
+
+    int ret;
+
+
+    ret = cm_new_vct(&heap->data, data_sz);
+    if (ret != 0) return -1;
+
+    ret = _heap_init(heap, arity, compare);
+    if (ret != 0) {
+        cm_del_vct(&heap->data);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+
+int cm_new_heap_vct(cm_heap * heap, cm_vct * vector, const int arity,
+                    enum cm_rbt_side (*compare)(const void *, const void *)) {
+
+    int ret;
+
+
+    //take over the vector's storage
+    cm_vct_mov(&heap->data, vector);
+
+    ret = _heap_init(heap, arity, compare);
+    if (ret != 0) {
+        cm_vct_mov(vector, &heap->data);
+        return -1;
+    }
+
+    _heap_build(heap);
+
+    return 0;
+}
+
+
+
+void cm_del_heap(cm_heap * heap) {
+
+    cm_del_vct(&heap->data);
+    free(heap->tmp);
+    heap->is_init = false;
+
+    return;
+}
+
+
+
+/*
+ *  --- [INDEXED HEAP - INTERNAL] ---
+ */
+
+#define IHEAP_ORDER(iheap) ((int *) (iheap)->order.data)
+#define IHEAP_POS(iheap)   ((int *) (iheap)->pos.data)
+
+
+
+DBG_STATIC DBG_INLINE
+void * _iheap_traverse(const cm_iheap * iheap, const int handle) {
+
+    return iheap->data.data + (iheap->data.data_sz * handle);
+}
+
+
+
+//true if the element of `handle_0` belongs above that of `handle_1`
+DBG_STATIC DBG_INLINE
+bool _iheap_is_above(const cm_iheap * iheap,
+                     const int handle_0, const int handle_1) {
+
+    return iheap->compare(_iheap_traverse(iheap, handle_0),
+                          _iheap_traverse(iheap, handle_1)) == CM_RBT_LESS;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+bool _iheap_is_valid(const cm_iheap * iheap, const int handle) {
+
+    if (handle < 0 || handle >= iheap->pos.len) return false;
+    return IHEAP_POS(iheap)[handle] != -1;
+}
+
+
+
+//place `handle` at `index` of the order & record its position
+DBG_STATIC DBG_INLINE
+void _iheap_place(cm_iheap * iheap, const int index, const int handle) {
+
+    IHEAP_ORDER(iheap)[index] = handle;
+    IHEAP_POS(iheap)[handle] = index;
+
+    return;
+}
+
+
+
+/*
+ *  As with cm_heap, sifting moves a hole through the order; only handles 
+ *  move, element data stays where it is.
+ */
+
+DBG_STATIC
+int _iheap_sift_up(cm_iheap * iheap, int index, const int handle) {
+
+    int parent;
+
+
+    while (index > 0) {
+
+        parent = (index - 1) / iheap->arity;
+        if (!_iheap_is_above(iheap, handle, IHEAP_ORDER(iheap)[parent])) break;
+
+        _iheap_place(iheap, index, IHEAP_ORDER(iheap)[parent]);
+        index = parent;
+    }
+
+    _iheap_place(iheap, index, handle);
+
+    return index;
+}
+
+
+
+DBG_STATIC
+int _iheap_sift_down(cm_iheap * iheap, int index, const int handle) {
+
+    int child, first, last, best;
+    int * order = IHEAP_ORDER(iheap);
+
+
+    while (true) {
+
+        //find the highest priority child
+        first = (index * iheap->arity) + 1;
+        if (first >= iheap->order.len) break;
+
+        last = first + iheap->arity;
+        if (last > iheap->order.len) last = iheap->order.len;
+
+        best = first;
+        for (child = first + 1; child < last; ++child) {
+            if (_iheap_is_above(iheap, order[child], order[best])) {
+                best = child;
+            }
+        }
+
+        if (!_iheap_is_above(iheap, order[best], handle)) break;
+
+        _iheap_place(iheap, index, order[best]);
+        index = best;
+    }
+
+    _iheap_place(iheap, index, handle);
+
+    return index;
+}
+
+
+
+//move the element at `index` to wherever it now belongs
+DBG_STATIC
+void _iheap_fix(cm_iheap * iheap, const int index) {
+
+    int handle = IHEAP_ORDER(iheap)[index];
+
+    if (_iheap_sift_up(iheap, index, handle) == index) {
+        _iheap_sift_down(iheap, index, handle);
+    }
+
+    return;
+}
+
+
+
+//take the element of `handle` out of the order & release the handle
+DBG_STATIC
+void _iheap_unlink(cm_iheap * iheap, const int handle) {
+
+    int index, last;
+
+
+    index = IHEAP_POS(iheap)[handle];
+    IHEAP_POS(iheap)[handle] = -1;
+
+    //fill the gap with the last element of the order
+    iheap->order.len -= 1;
+    if (index != iheap->order.len) {
+
+        last = IHEAP_ORDER(iheap)[iheap->order.len];
+        _iheap_place(iheap, index, last);
+        _iheap_fix(iheap, index);
+    }
+
+    /*
+     *  The free list has space for every handle, so appending can not 
+     *  fail: it is grown alongside the handle table in cm_iheap_psh().
+     */
+    cm_vct_apd(&iheap->free, &handle);
+
+    return;
+}
+
+
+
+/*
+ *  --- [INDEXED HEAP - EXTERNAL] ---
+ */
+
+int cm_iheap_get(const cm_iheap * iheap, const int handle, void * buf) {
+
+    if (!_iheap_is_valid(iheap, handle)) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return -1;
+    }
+
+    memcpy(buf, _iheap_traverse(iheap, handle), iheap->data.data_sz);
+
+    return 0;
+}
+
+
+
+void * cm_iheap_get_p(const cm_iheap * iheap, const int handle) {
+
+    if (!_iheap_is_valid(iheap, handle)) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return NULL;
+    }
+
+    return _iheap_traverse(iheap, handle);
+}
+
+
+
+int cm_iheap_pek(const cm_iheap * iheap, void * buf) {
+
+    int handle;
+
+
+    //heap must not be empty
+    if (iheap->order.len == 0) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return -1;
+    }
+
+    handle = IHEAP_ORDER(iheap)[0];
+    if (buf != NULL) {
+        memcpy(buf, _iheap_traverse(iheap, handle), iheap->data.data_sz);
+    }
+
+    return handle;
+}
+
+
+
+int cm_iheap_psh(cm_iheap * iheap, const void * data) {
+
+    int ret, handle, index;
+
+
+    //`data` may point into the heap's storage, which may move
+    memcpy(iheap->tmp, data, iheap->data.data_sz);
+
+    //reuse a released handle
+    if (iheap->free.len > 0) {
+
+        iheap->free.len -= 1;
+        handle = ((int *) iheap->free.data)[iheap->free.len];
+
+        //grow the order first, so a failure leaves the handle released
+        index = iheap->order.len;
+        ret = cm_vct_apd(&iheap->order, &handle);
+        if (ret != 0) {
+            iheap->free.len += 1;
+            return -1;
+        }
+
+        memcpy(_iheap_traverse(iheap, handle), iheap->tmp,
+               iheap->data.data_sz);
+
+    //else allocate a new handle
+    } else {
+
+        handle = iheap->data.len;
+        index  = iheap->order.len;
+
+        /*
+         *  Every table grows by one entry. The free list is reserved 
+         *  here too, so that releasing a handle never allocates.
+         */
+        if (iheap->free.sz < (size_t) handle + 1) {
+            ret = cm_vct_rsz(&iheap->free, handle + 1);
+            if (ret != 0) return -1;
+            iheap->free.len = 0;
+        }
+
+        ret = cm_vct_apd(&iheap->data, iheap->tmp);
+        if (ret != 0) return -1;
+
+        ret = cm_vct_apd(&iheap->pos, &index);
+        if (ret != 0) {
+            iheap->data.len -= 1;
+            return -1;
+        }
+
+        ret = cm_vct_apd(&iheap->order, &handle);
+        if (ret != 0) {
+            iheap->data.len -= 1;
+            iheap->pos.len  -= 1;
+            return -1;
+        }
+    }
+
+    _iheap_sift_up(iheap, index, handle);
+
+    return handle;
+}
+
+
+
+int cm_iheap_pop(cm_iheap * iheap, void * buf) {
+
+    int handle;
+
+
+    //heap must not be empty
+    handle = cm_iheap_pek(iheap, buf);
+    if (handle == -1) return -1;
+
+    _iheap_unlink(iheap, handle);
+
+    return handle;
+}
+
+
+
+int cm_iheap_upd(cm_iheap * iheap, const int handle, const void * data) {
+
+    if (!_iheap_is_valid(iheap, handle)) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return -1;
+    }
+
+    //update the element, then restore heap order around it
+    memmove(_iheap_traverse(iheap, handle), data, iheap->data.data_sz);
+    _iheap_fix(iheap, IHEAP_POS(iheap)[handle]);
+
+    return 0;
+}
+
+
+
+int cm_iheap_rmv(cm_iheap * iheap, const int handle) {
+
+    if (!_iheap_is_valid(iheap, handle)) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return -1;
+    }
+
+    _iheap_unlink(iheap, handle);
+
+    return 0;
+}
+
+
+
+void cm_iheap_emp(cm_iheap * iheap) {
+
+    //release every handle
+    cm_vct_emp(&iheap->data);
+    cm_vct_emp(&iheap->order);
+    cm_vct_emp(&iheap->pos);
+    cm_vct_emp(&iheap->free);
+
+    return;
+}
+
+
+
+int cm_new_iheap(cm_iheap * iheap, const size_t data_sz, const int arity,
+                 enum cm_rbt_side (*compare)(const void *, const void *)) {
+
+    int ret;
+
+
+    //a node needs at least two children
+    if (arity < 2) {
+        cm_errno = CM_ERR_USER_ARG;
+        return -1;
+    }
+
+    ret = cm_new_vct(&iheap->data, data_sz);
+    if (ret != 0) return -1;
+
+    ret = cm_new_vct(&iheap->order, sizeof(int));
+    if (ret != 0) {
+        cm_del_vct(&iheap->data);
+        return -1;
+    }
+
+    ret = cm_new_vct(&iheap->pos, sizeof(int));
+    if (ret != 0) {
+        cm_del_vct(&iheap->data);
+        cm_del_vct(&iheap->order);
+        return -1;
+    }
+
+    ret = cm_new_vct(&iheap->free, sizeof(int));
+    if (ret != 0) {
+        cm_del_vct(&iheap->data);
+        cm_del_vct(&iheap->order);
+        cm_del_vct(&iheap->pos);
+        return -1;
+    }
+
+    //scratch space for the element being pushed
+    iheap->tmp = malloc(data_sz);
+    if (iheap->tmp == NULL) {
+        cm_del_vct(&iheap->data);
+        cm_del_vct(&iheap->order);
+        cm_del_vct(&iheap->pos);
+        cm_del_vct(&iheap->free);
+        cm_errno = CM_ERR_MALLOC;
+        return -1;
+    }
+
+    iheap->arity   = arity;
+    iheap->compare = compare;
+    iheap->is_init = true;
+
+    return 0;
+}
+
+
+
+void cm_del_iheap(cm_iheap * iheap) {
+
+    cm_del_vct(&iheap->data);
+    cm_del_vct(&iheap->order);
+    cm_del_vct(&iheap->pos);
+    cm_del_vct(&iheap->free);
+    free(iheap->tmp);
+    iheap->is_init = false;
+
+    return;
+}
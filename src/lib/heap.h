@@ -0,0 +1,66 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+
+
+// -- [heap]
+
+#ifdef CM_DEBUG
+//internal
+void * _heap_traverse(const cm_heap * heap, const int index);
+bool _heap_is_above(const cm_heap * heap,
+                    const void * data_0, const void * data_1);
+void _heap_sift_up(cm_heap * heap, int index, const void * data);
+void _heap_sift_down(cm_heap * heap, int index, const void * data);
+void _heap_build(cm_heap * heap);
+int _heap_init(cm_heap * heap, const int arity,
+               enum cm_rbt_side (*compare)(const void *, const void *));
+
+void * _iheap_traverse(const cm_iheap * iheap, const int handle);
+bool _iheap_is_above(const cm_iheap * iheap,
+                     const int handle_0, const int handle_1);
+bool _iheap_is_valid(const cm_iheap * iheap, const int handle);
+void _iheap_place(cm_iheap * iheap, const int index, const int handle);
+int _iheap_sift_up(cm_iheap * iheap, int index, const int handle);
+int _iheap_sift_down(cm_iheap * iheap, int index, const int handle);
+void _iheap_fix(cm_iheap * iheap, const int index);
+void _iheap_unlink(cm_iheap * iheap, const int handle);
+#endif
+
+
+//external
+int cm_heap_pek(const cm_heap * heap, void * buf);
+void * cm_heap_pek_p(const cm_heap * heap);
+
+int cm_heap_psh(cm_heap * heap, const void * data);
+int cm_heap_pop(cm_heap * heap, void * buf);
+int cm_heap_rpl(cm_heap * heap, const void * data, void * buf);
+void cm_heap_emp(cm_heap * heap);
+
+int cm_new_heap(cm_heap * heap, const size_t data_sz, const int arity,
+                enum cm_rbt_side (*compare)(const void *, const void *));
+int cm_new_heap_vct(cm_heap * heap, cm_vct * vector, const int arity,
+                    enum cm_rbt_side (*compare)(const void *, const void *));
+void cm_del_heap(cm_heap * heap);
+
+int cm_iheap_get(const cm_iheap * iheap, const int handle, void * buf);
+void * cm_iheap_get_p(const cm_iheap * iheap, const int handle);
+int cm_iheap_pek(const cm_iheap * iheap, void * buf);
+
+int cm_iheap_psh(cm_iheap * iheap, const void * data);
+int cm_iheap_pop(cm_iheap * iheap, void * buf);
+int cm_iheap_upd(cm_iheap * iheap, const int handle, const void * data);
+int cm_iheap_rmv(cm_iheap * iheap, const int handle);
+void cm_iheap_emp(cm_iheap * iheap);
+
+int cm_new_iheap(cm_iheap * iheap, const size_t data_sz, const int arity,
+                 enum cm_rbt_side (*compare)(const void *, const void *));
+void cm_del_iheap(cm_iheap * iheap);
+
+#endif
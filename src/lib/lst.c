@@ -78,9 +78,9 @@ cm_lst_node * _lst_new_node(const cm_lst * list, const void * data) {
 
 
 DBG_STATIC 
-void _lst_del_node(cm_lst_node * node) {
+void _lst_free_node(void * node) {
 
-    free(node->data);
+    free(((cm_lst_node *) node)->data);
     free(node);
 
     return;
@@ -88,6 +88,22 @@ void _lst_del_node(cm_lst_node * node) {
 
 
 
+//readers of the list may delay the free through its hook
+DBG_STATIC 
+void _lst_del_node(const cm_lst * list, cm_lst_node * node) {
+
+    if (list != NULL && list->del_hook != NULL) {
+        list->del_hook->retire(list->del_hook->ctx, node, _lst_free_node);
+        return;
+    }
+
+    _lst_free_node(node);
+
+    return;
+}
+
+
+
 DBG_STATIC 
 void _lst_set_head_node(cm_lst * list, cm_lst_node * node) {
 
@@ -157,7 +173,7 @@ int _lst_emp(cm_lst * list) {
     while ((node != NULL) && (index != 0)) {
 
         next_node = node->next;
-        _lst_del_node(node);
+        _lst_del_node(list, node);
         node = next_node;
         --index;
     }
@@ -199,7 +215,7 @@ int _lst_assert_index_range(const cm_lst * list,
 
 int cm_lst_get(const cm_lst * list, const int index, void * buf) {
 
-    if (_lst_assert_index_range(list, index, INDEX)) return -1;
+    if (_lst_assert_index_range(list, index, LST_INDEX)) return -1;
 
     //get the node
     cm_lst_node * node = _lst_traverse(list, index);
@@ -214,7 +230,7 @@ int cm_lst_get(const cm_lst * list, const int index, void * buf) {
 
 void * cm_lst_get_p(const cm_lst * list, const int index) {
 
-    if (_lst_assert_index_range(list, index, INDEX)) return NULL;
+    if (_lst_assert_index_range(list, index, LST_INDEX)) return NULL;
 
     //get the node
     cm_lst_node * node = _lst_traverse(list, index);
@@ -227,7 +243,7 @@ void * cm_lst_get_p(const cm_lst * list, const int index) {
 
 cm_lst_node * cm_lst_get_n(const cm_lst * list, const int index) {
 
-    if (_lst_assert_index_range(list, index, INDEX)) return NULL;
+    if (_lst_assert_index_range(list, index, LST_INDEX)) return NULL;
 
     //get the node
     return _lst_traverse(list, index);
@@ -238,7 +254,7 @@ cm_lst_node * cm_lst_get_n(const cm_lst * list, const int index) {
 cm_lst_node * cm_lst_set(cm_lst * list, 
                          const int index, const void * data) {
 
-    if (_lst_assert_index_range(list, index, INDEX)) return NULL;
+    if (_lst_assert_index_range(list, index, LST_INDEX)) return NULL;
 
     //get the node
     cm_lst_node * node = _lst_traverse(list, index);
@@ -266,7 +282,7 @@ cm_lst_node * cm_lst_ins(cm_lst * list,
 
     cm_lst_node * prev_node, * next_node;
 
-    if (_lst_assert_index_range(list, index, ADD_INDEX)) return NULL;
+    if (_lst_assert_index_range(list, index, LST_ADD_INDEX)) return NULL;
 
     //create new node
     cm_lst_node * new_node = _lst_new_node(list, data);
@@ -293,7 +309,7 @@ cm_lst_node * cm_lst_ins(cm_lst * list,
                 next_node = _lst_traverse(list, index + 1);
             }
             if (!next_node) {
-                _lst_del_node(new_node);
+                _lst_del_node(NULL, new_node);
                 return NULL;
             }
             prev_node = next_node->prev;
@@ -384,7 +400,7 @@ cm_lst_node * cm_lst_apd(cm_lst * list, const void * data) {
 
 cm_lst_node * cm_lst_uln(cm_lst * list, const int index) {
 
-    if (_lst_assert_index_range(list, index, INDEX)) return NULL;
+    if (_lst_assert_index_range(list, index, LST_INDEX)) return NULL;
     
     //get the node
     cm_lst_node * unlink_node = _lst_traverse(list, index);
@@ -416,14 +432,14 @@ cm_lst_node * cm_lst_uln_n(cm_lst * list, cm_lst_node * node) {
 
 int cm_lst_rmv(cm_lst * list, const int index) {
  
-    if (_lst_assert_index_range(list, index, INDEX)) return -1;
+    if (_lst_assert_index_range(list, index, LST_INDEX)) return -1;
 
     //get the node
     cm_lst_node * del_node = _lst_traverse(list, index);
     if(!del_node) return -1;
 
     _lst_sub_node(list, del_node->prev, del_node->next, index);
-    _lst_del_node(del_node);
+    _lst_del_node(list, del_node);
     
     --list->len;
 
@@ -437,7 +453,7 @@ int cm_lst_rmv_n(cm_lst * list, cm_lst_node * node) {
     int index = list->head == node ? 0 : -1;
 
     _lst_sub_node(list, node->prev, node->next, index);
-    _lst_del_node(node);
+    _lst_del_node(list, node);
 
     --list->len;
 
@@ -523,11 +539,47 @@ int cm_lst_iter(const cm_lst * list,
 
 
 
+int cm_lst_iter_bat(const cm_lst * list,
+                    int (* callback)(void * const * data,
+                                     const int len, void * ctx),
+                    void * ctx) {
+
+    int ret, len;
+    void * batch[CM_ITER_BATCH];
+
+
+    //for every batch of nodes in the list
+    cm_lst_node * node = list->head;
+    for (int i = 0; i < list->len; i += len) {
+
+        //gather the batch, prefetching data for the callback
+        len = list->len - i < CM_ITER_BATCH ? list->len - i : CM_ITER_BATCH;
+        for (int j = 0; j < len; ++j) {
+
+            batch[j] = node->data;
+            __builtin_prefetch(node->data);
+            node = node->next;
+        }
+
+        //process the batch
+        ret = callback(batch, len, ctx);
+        if (ret != 0) {
+            cm_errno = CM_ERR_CALLBACK;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+
 void cm_new_lst(cm_lst * list, const size_t data_sz) {
 
     list->len = 0;
     list->data_sz = data_sz;
     list->head = NULL;
+    list->del_hook = NULL;
     list->is_init = true;
 
     return;
@@ -545,7 +597,7 @@ void cm_del_lst(cm_lst * list) {
 
         del_node = list->head;
         _lst_sub_node(list, del_node->prev, del_node->next, 0);
-        _lst_del_node(del_node);
+        _lst_del_node(list, del_node);
     
     } //end for
 
@@ -557,7 +609,7 @@ void cm_del_lst(cm_lst * list) {
 
 void cm_del_lst_node(cm_lst_node * node) {
 
-    _lst_del_node(node);
+    _lst_del_node(NULL, node);
 
     return;
 }
@@ -13,7 +13,7 @@
 
 //controls if user provided index should be verified for accessing elements
 //or for adding new elements
-enum _lst_index_mode {INDEX = 0, ADD_INDEX = 1};
+enum _lst_index_mode {LST_INDEX = 0, LST_ADD_INDEX = 1};
 
 
 #ifdef CM_DEBUG
@@ -21,7 +21,8 @@ enum _lst_index_mode {INDEX = 0, ADD_INDEX = 1};
 cm_lst_node * _lst_traverse(const cm_lst * list, int index);
 
 cm_lst_node * _lst_new_node(const cm_lst * list, const void * data);
-void _lst_del_node(cm_lst_node * node);
+void _lst_free_node(void * node);
+void _lst_del_node(const cm_lst * list, cm_lst_node * node);
 
 void _lst_set_head_node(cm_lst * list, cm_lst_node * node);
 void _lst_add_node(cm_lst * list, 
@@ -68,6 +69,10 @@ void cm_lst_mov(cm_lst * dst_list, cm_lst * src_list);
 int cm_lst_iter(const cm_lst * list,
                 int (* callback)(const cm_lst_node * node, void * ctx),
                 void * ctx);
+int cm_lst_iter_bat(const cm_lst * list,
+                    int (* callback)(void * const * data,
+                                     const int len, void * ctx),
+                    void * ctx);
 
 void cm_new_lst(cm_lst * list, const size_t data_sz);
 void cm_del_lst(cm_lst * list);
@@ -0,0 +1,513 @@
+//CPU_COUNT() & sched_getaffinity()
+#define _GNU_SOURCE
+
+//standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+
+//system headers
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "que.h"
+#include "pool.h"
+
+
+
+//worker the calling thread belongs to, if any
+static __thread struct _cm_pool_worker * _pool_self;
+
+//xorshift state for picking victims
+static __thread uint64_t _pool_rng;
+
+//pool shared by the library's parallel algorithms
+static cm_pool _pool_def;
+static pthread_once_t _pool_def_once = PTHREAD_ONCE_INIT;
+static int _pool_def_err;
+
+
+
+/*
+ *  --- [INTERNAL] ---
+ */
+
+DBG_STATIC DBG_INLINE
+uint64_t _pool_rand() {
+
+    //seed from the thread's stack address
+    if (_pool_rng == 0) _pool_rng = (uint64_t) (uintptr_t) &_pool_rng | 1;
+
+    _pool_rng ^= _pool_rng << 13;
+    _pool_rng ^= _pool_rng >> 7;
+    _pool_rng ^= _pool_rng << 17;
+
+    return _pool_rng;
+}
+
+
+
+/*
+ *  Chase-Lev deque operations, with the fences of Lê et al.'s C11 
+ *  formulation. Only the owner calls _pool_push() & _pool_take().
+ */
+
+DBG_STATIC DBG_INLINE
+bool _pool_push(struct _cm_pool_worker * worker, cm_pool_task * task) {
+
+    int64_t top, bottom;
+
+
+    bottom = __atomic_load_n(&worker->bottom, __ATOMIC_RELAXED);
+    top    = __atomic_load_n(&worker->top, __ATOMIC_ACQUIRE);
+
+    //deque is full
+    if (bottom - top >= POOL_DEQUE_SZ) return false;
+
+    __atomic_store_n(&worker->buf[bottom & (POOL_DEQUE_SZ - 1)],
+                     task, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&worker->bottom, bottom + 1, __ATOMIC_RELAXED);
+
+    return true;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+cm_pool_task * _pool_take(struct _cm_pool_worker * worker) {
+
+    int64_t top, bottom;
+    cm_pool_task * task;
+
+
+    bottom = __atomic_load_n(&worker->bottom, __ATOMIC_RELAXED) - 1;
+    __atomic_store_n(&worker->bottom, bottom, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    top = __atomic_load_n(&worker->top, __ATOMIC_RELAXED);
+
+    //deque is empty
+    if (top > bottom) {
+        __atomic_store_n(&worker->bottom, bottom + 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    task = __atomic_load_n(&worker->buf[bottom & (POOL_DEQUE_SZ - 1)],
+                           __ATOMIC_RELAXED);
+
+    //last task, race thieves for it
+    if (top == bottom) {
+        if (!__atomic_compare_exchange_n(&worker->top, &top, top + 1, false,
+                                         __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+            task = NULL;
+        __atomic_store_n(&worker->bottom, bottom + 1, __ATOMIC_RELAXED);
+    }
+
+    return task;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+cm_pool_task * _pool_steal(struct _cm_pool_worker * worker) {
+
+    int64_t top, bottom;
+    cm_pool_task * task;
+
+
+    top = __atomic_load_n(&worker->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    bottom = __atomic_load_n(&worker->bottom, __ATOMIC_ACQUIRE);
+
+    //deque is empty
+    if (top >= bottom) return NULL;
+
+    task = __atomic_load_n(&worker->buf[top & (POOL_DEQUE_SZ - 1)],
+                           __ATOMIC_RELAXED);
+
+    //lost the race to the owner or another thief
+    if (!__atomic_compare_exchange_n(&worker->top, &top, top + 1, false,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+        return NULL;
+
+    return task;
+}
+
+
+
+//own deque first, then the injection queue, then other workers
+DBG_STATIC
+cm_pool_task * _pool_find(cm_pool * pool, struct _cm_pool_worker * self) {
+
+    int start;
+    struct _cm_pool_worker * victim;
+    cm_pool_task * task;
+
+
+    if (self != NULL) {
+        task = _pool_take(self);
+        if (task != NULL) return task;
+    }
+
+    if (cm_mpmc_deq(&pool->inject, &task) == 0) return task;
+
+    //steal, starting from a random victim
+    start = (int) (_pool_rand() % (uint64_t) pool->workers_n);
+    for (int i = 0; i < pool->workers_n; ++i) {
+
+        victim = &pool->workers[(start + i) % pool->workers_n];
+        if (victim == self) continue;
+
+        task = _pool_steal(victim);
+        if (task != NULL) return task;
+    }
+
+    return NULL;
+}
+
+
+
+DBG_STATIC
+void _pool_run(cm_pool_task * task) {
+
+    uint32_t old;
+    cm_pool_grp * grp = task->grp;
+
+
+    if (task->fn(task->ctx) != 0) {
+        __atomic_store_n(&grp->failed, true, __ATOMIC_RELAXED);
+    }
+
+    //last task of the group wakes a sleeping cm_pool_sync()
+    old = __atomic_fetch_sub(&grp->pending, 1, __ATOMIC_SEQ_CST);
+    if (old == (POOL_GRP_WAIT | 1)) {
+        syscall(SYS_futex, &grp->pending, FUTEX_WAKE_PRIVATE,
+                INT_MAX, NULL, NULL, 0);
+    }
+
+    return;
+}
+
+
+
+DBG_STATIC
+void * _pool_main(void * arg) {
+
+    uint32_t seen;
+    struct _cm_pool_worker * self = arg;
+    cm_pool * pool = self->pool;
+    cm_pool_task * task;
+
+
+    _pool_self = self;
+
+    for (int i = 0; !__atomic_load_n(&pool->stop, __ATOMIC_ACQUIRE); ) {
+
+        task = _pool_find(pool, self);
+        if (task != NULL) {
+            _pool_run(task);
+            i = 0;
+            continue;
+        }
+
+        //spin briefly before parking
+        if (i < QUE_SPIN) {
+            _que_relax(i++);
+            continue;
+        }
+
+        //register as idle, then look once more before sleeping
+        seen = _que_register(&pool->wake, &pool->idle);
+
+        task = _pool_find(pool, self);
+        if (task == NULL && !__atomic_load_n(&pool->stop, __ATOMIC_ACQUIRE)) {
+            syscall(SYS_futex, &pool->wake, FUTEX_WAIT_PRIVATE,
+                    seen, NULL, NULL, 0);
+        }
+        __atomic_sub_fetch(&pool->idle, 1, __ATOMIC_SEQ_CST);
+
+        if (task != NULL) {
+            _pool_run(task);
+            i = 0;
+        }
+    }
+
+    return NULL;
+}
+
+
+
+//CPUs allowed by the cgroup quota, rounded up; 0 if unlimited
+DBG_STATIC
+int _pool_cgroup_quota() {
+
+    FILE * fs;
+    char buf[16];
+    long quota, period;
+
+
+    //cgroup v2: "<quota> <period>" or "max <period>"
+    fs = fopen(POOL_CGROUP_V2, "r");
+    if (fs != NULL) {
+
+        quota = period = 0;
+        if (fscanf(fs, "%15s %ld", buf, &period) == 2
+            && strcmp(buf, "max") != 0) quota = strtol(buf, NULL, 10);
+        fclose(fs);
+
+        return (quota > 0 && period > 0) 
+               ? (int) ((quota + period - 1) / period) : 0;
+    }
+
+    //cgroup v1: quota is -1 if unlimited
+    quota = period = 0;
+
+    fs = fopen(POOL_CGROUP_V1_QUOTA, "r");
+    if (fs == NULL) return 0;
+    if (fscanf(fs, "%ld", &quota) != 1) quota = 0;
+    fclose(fs);
+
+    fs = fopen(POOL_CGROUP_V1_PERIOD, "r");
+    if (fs == NULL) return 0;
+    if (fscanf(fs, "%ld", &period) != 1) period = 0;
+    fclose(fs);
+
+    return (quota > 0 && period > 0) 
+           ? (int) ((quota + period - 1) / period) : 0;
+}
+
+
+
+DBG_STATIC
+void _pool_def_init() {
+
+    if (cm_new_pool(&_pool_def, 0) != 0) _pool_def_err = cm_errno;
+
+    return;
+}
+
+
+
+__attribute__((destructor)) DBG_STATIC
+void _pool_def_fini() {
+
+    if (_pool_def.is_init) cm_del_pool(&_pool_def);
+
+    return;
+}
+
+
+
+/*
+ *  --- [EXTERNAL] ---
+ */
+
+void cm_pool_spawn(cm_pool * pool, cm_pool_grp * grp, cm_pool_task * task,
+                   int (* fn)(void * ctx), void * ctx) {
+
+    bool ret;
+
+
+    task->fn  = fn;
+    task->ctx = ctx;
+    task->grp = grp;
+
+    __atomic_add_fetch(&grp->pending, 1, __ATOMIC_RELAXED);
+
+    //workers push onto their own deque, other threads inject
+    if (_pool_self != NULL && _pool_self->pool == pool) {
+        ret = _pool_push(_pool_self, task);
+    } else {
+        ret = cm_mpmc_enq(&pool->inject, &task) == 0;
+    }
+
+    //no room, run it now
+    if (!ret) {
+        _pool_run(task);
+        return;
+    }
+
+    _que_notify(&pool->wake, &pool->idle, 1);
+
+    return;
+}
+
+
+
+int cm_pool_sync(cm_pool * pool, cm_pool_grp * grp) {
+
+    uint32_t pending;
+    struct _cm_pool_worker * self;
+    cm_pool_task * task;
+
+
+    self = (_pool_self != NULL && _pool_self->pool == pool) 
+           ? _pool_self : NULL;
+
+    //help with outstanding work until the group completes
+    for (int i = 0; ; ) {
+
+        pending = __atomic_load_n(&grp->pending, __ATOMIC_ACQUIRE);
+        if ((pending & ~POOL_GRP_WAIT) == 0) break;
+
+        task = _pool_find(pool, self);
+        if (task != NULL) {
+            _pool_run(task);
+            i = 0;
+            continue;
+        }
+
+        //workers keep looking for work, other threads may sleep
+        if (i < QUE_SPIN || self != NULL) {
+            _que_relax(i++);
+            continue;
+        }
+
+        if ((pending & POOL_GRP_WAIT) == 0
+            && !__atomic_compare_exchange_n(&grp->pending, &pending,
+                    pending | POOL_GRP_WAIT, false,
+                    __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) continue;
+
+        syscall(SYS_futex, &grp->pending, FUTEX_WAIT_PRIVATE,
+                pending | POOL_GRP_WAIT, NULL, NULL, 0);
+    }
+
+    __atomic_store_n(&grp->pending, 0, __ATOMIC_RELAXED);
+
+    if (grp->failed) {
+        grp->failed = false;
+        cm_errno = CM_ERR_CALLBACK;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+
+void cm_new_pool_grp(cm_pool_grp * grp) {
+
+    grp->pending = 0;
+    grp->failed  = false;
+
+    return;
+}
+
+
+
+int cm_pool_cpus() {
+
+    int cpus, quota;
+    cpu_set_t set;
+
+
+    //CPUs this thread may run on
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        cpus = CPU_COUNT(&set);
+    } else {
+        cpus = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+
+    //CPU time the cgroup may use
+    quota = _pool_cgroup_quota();
+    if (quota > 0 && quota < cpus) cpus = quota;
+
+    return cpus < 1 ? 1 : cpus;
+}
+
+
+
+cm_pool * cm_pool_def() {
+
+    pthread_once(&_pool_def_once, _pool_def_init);
+
+    if (!_pool_def.is_init) {
+        cm_errno = _pool_def_err;
+        return NULL;
+    }
+
+    return &_pool_def;
+}
+
+
+
+int cm_new_pool(cm_pool * pool, const int workers) {
+
+    int ret;
+    struct _cm_pool_worker * worker;
+
+
+    pool->workers_n = workers < 1 ? cm_pool_cpus() : workers;
+
+    ret = cm_new_mpmc(&pool->inject, sizeof(cm_pool_task *), POOL_DEQUE_SZ);
+    if (ret != 0) return -1;
+
+    pool->workers = aligned_alloc(CM_CACHE_LINE, 
+                        sizeof(struct _cm_pool_worker) * pool->workers_n);
+    if (pool->workers == NULL) {
+        cm_del_mpmc(&pool->inject);
+        cm_errno = CM_ERR_MALLOC;
+        return -1;
+    }
+
+    pool->wake = 0;
+    pool->idle = 0;
+    pool->stop = false;
+
+    for (int i = 0; i < pool->workers_n; ++i) {
+
+        worker = &pool->workers[i];
+        worker->top    = 0;
+        worker->bottom = 0;
+        worker->pool   = pool;
+        worker->id     = i;
+    }
+
+    for (int i = 0; i < pool->workers_n; ++i) {
+
+        ret = pthread_create(&pool->workers[i].thread, NULL,
+                             _pool_main, &pool->workers[i]);
+        if (ret != 0) {
+
+            //stop the workers started so far
+            pool->workers_n = i;
+            pool->is_init = true;
+            cm_del_pool(pool);
+
+            cm_errno = CM_ERR_THREAD;
+            return -1;
+        }
+    }
+
+    pool->is_init = true;
+
+    return 0;
+}
+
+
+
+void cm_del_pool(cm_pool * pool) {
+
+    __atomic_store_n(&pool->stop, true, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&pool->wake, 1, __ATOMIC_SEQ_CST);
+    syscall(SYS_futex, &pool->wake, FUTEX_WAKE_PRIVATE,
+            INT_MAX, NULL, NULL, 0);
+
+    for (int i = 0; i < pool->workers_n; ++i) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+
+    free(pool->workers);
+    cm_del_mpmc(&pool->inject);
+    pool->is_init = false;
+
+    return;
+}
@@ -0,0 +1,74 @@
+#ifndef POOL_H
+#define POOL_H
+
+//standard library
+#include <stdint.h>
+
+//system headers
+#include <unistd.h>
+#include <pthread.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+
+
+// -- [thread pool]
+
+//capacity of every worker's deque; spawns beyond it run inline
+#define POOL_DEQUE_SZ 1024
+
+//set in a group's counter while a thread sleeps in cm_pool_sync()
+#define POOL_GRP_WAIT 0x80000000u
+
+//cgroup CPU quota files, v2 then v1
+#define POOL_CGROUP_V2        "/sys/fs/cgroup/cpu.max"
+#define POOL_CGROUP_V1_QUOTA  "/sys/fs/cgroup/cpu/cpu.cfs_quota_us"
+#define POOL_CGROUP_V1_PERIOD "/sys/fs/cgroup/cpu/cpu.cfs_period_us"
+
+
+/*
+ *  Every worker owns a Chase-Lev deque: the owner pushes & takes at 
+ *  `bottom`, thieves steal at `top`. Both indeces only grow.
+ */
+
+struct _cm_pool_worker {
+
+    int64_t top __attribute__((aligned(CM_CACHE_LINE)));
+    int64_t bottom __attribute__((aligned(CM_CACHE_LINE)));
+    cm_pool_task * buf[POOL_DEQUE_SZ];
+
+    cm_pool * pool;
+    pthread_t thread;
+    int id;
+};
+
+
+#ifdef CM_DEBUG
+//internal
+uint64_t _pool_rand();
+bool _pool_push(struct _cm_pool_worker * worker, cm_pool_task * task);
+cm_pool_task * _pool_take(struct _cm_pool_worker * worker);
+cm_pool_task * _pool_steal(struct _cm_pool_worker * worker);
+cm_pool_task * _pool_find(cm_pool * pool, struct _cm_pool_worker * self);
+void _pool_run(cm_pool_task * task);
+void * _pool_main(void * arg);
+int _pool_cgroup_quota();
+void _pool_def_init();
+void _pool_def_fini();
+#endif
+
+
+//external
+void cm_pool_spawn(cm_pool * pool, cm_pool_grp * grp, cm_pool_task * task,
+                   int (* fn)(void * ctx), void * ctx);
+int cm_pool_sync(cm_pool * pool, cm_pool_grp * grp);
+void cm_new_pool_grp(cm_pool_grp * grp);
+
+int cm_pool_cpus();
+cm_pool * cm_pool_def();
+
+int cm_new_pool(cm_pool * pool, const int workers);
+void cm_del_pool(cm_pool * pool);
+
+#endif
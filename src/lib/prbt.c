@@ -0,0 +1,664 @@
+//standard library
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+//system headers
+#include <pthread.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "crbt.h"
+#include "prbt.h"
+
+
+
+/*
+ *  Versions are immutable & share subtrees. Every node counts the
+ *  versions & parent nodes that point to it, so releasing a version frees
+ *  exactly the nodes no other version uses.
+ *
+ *  The rebalancing follows Kahrs' functional red-black trees: each step
+ *  builds new nodes instead of rotating links. Every helper takes
+ *  ownership of the references passed in as subtrees & returns an owned
+ *  reference; `src` & `key`/`data` arguments are only borrowed.
+ */
+
+
+
+/*
+ *  --- [INTERNAL] ---
+ */
+
+DBG_STATIC DBG_INLINE
+bool _prbt_is_red(const cm_prbt_node * node) {
+
+    return node != NULL && node->colour == CM_RBT_RED;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+bool _prbt_is_black(const cm_prbt_node * node) {
+
+    return node != NULL && node->colour == CM_RBT_BLACK;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+size_t _prbt_round(const size_t sz) {
+
+    return (sz + PRBT_ALIGN - 1) & ~((size_t) PRBT_ALIGN - 1);
+}
+
+
+
+DBG_STATIC DBG_INLINE
+cm_prbt_node * _prbt_ref(cm_prbt_node * node) {
+
+    if (node != NULL) __atomic_add_fetch(&node->refs, 1, __ATOMIC_RELAXED);
+
+    return node;
+}
+
+
+
+DBG_STATIC
+void _prbt_unref(cm_prbt_node * node) {
+
+    if (node == NULL) return;
+    if (__atomic_sub_fetch(&node->refs, 1, __ATOMIC_ACQ_REL) != 0) return;
+
+    _prbt_unref(node->left);
+    _prbt_unref(node->right);
+    free(node);
+
+    return;
+}
+
+
+
+DBG_STATIC
+cm_prbt_node * _prbt_find(const cm_prbt * tree,
+                          const cm_prbt_node * ver, const void * key) {
+
+    enum cm_rbt_side side;
+
+
+    while (ver != NULL) {
+
+        side = tree->compare(key, ver->key);
+        if (side == CM_RBT_EQUAL) return (cm_prbt_node *) ver;
+
+        ver = side == CM_RBT_LESS ? ver->left : ver->right;
+    }
+
+    return NULL;
+}
+
+
+
+/*
+ *  Make a node that owns `left` & `right`. On failure the subtrees are
+ *  released & the operation is marked as failed; callers carry on with
+ *  a NULL subtree & the result is discarded at the end.
+ */
+
+DBG_STATIC
+cm_prbt_node * _prbt_mk(struct _prbt_ctx * ctx, enum cm_rbt_colour colour,
+                        cm_prbt_node * left, const void * key,
+                        const void * data, cm_prbt_node * right) {
+
+    size_t hdr_sz, key_sz;
+    cm_prbt_node * node;
+
+
+    hdr_sz = _prbt_round(sizeof(cm_prbt_node));
+    key_sz = _prbt_round(ctx->tree->key_sz);
+
+    node = malloc(hdr_sz + key_sz + ctx->tree->data_sz);
+    if (node == NULL) {
+        _prbt_unref(left);
+        _prbt_unref(right);
+        ctx->failed = true;
+        cm_errno = CM_ERR_MALLOC;
+        return NULL;
+    }
+
+    node->key  = (uint8_t *) node + hdr_sz;
+    node->data = (uint8_t *) node->key + key_sz;
+    memcpy(node->key, key, ctx->tree->key_sz);
+    memcpy(node->data, data, ctx->tree->data_sz);
+
+    node->left   = left;
+    node->right  = right;
+    node->refs   = 1;
+    node->colour = colour;
+
+    return node;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+cm_prbt_node * _prbt_cpy(struct _prbt_ctx * ctx, enum cm_rbt_colour colour,
+                         cm_prbt_node * left, const cm_prbt_node * src,
+                         cm_prbt_node * right) {
+
+    return _prbt_mk(ctx, colour, left, src->key, src->data, right);
+}
+
+
+
+//a node only this operation can reach is recoloured in place
+DBG_STATIC
+cm_prbt_node * _prbt_blacken(struct _prbt_ctx * ctx, cm_prbt_node * node) {
+
+    cm_prbt_node * res;
+
+
+    if (!_prbt_is_red(node)) return node;
+
+    if (__atomic_load_n(&node->refs, __ATOMIC_ACQUIRE) == 1) {
+        node->colour = CM_RBT_BLACK;
+        return node;
+    }
+
+    res = _prbt_cpy(ctx, CM_RBT_BLACK,
+                    _prbt_ref(node->left), node, _prbt_ref(node->right));
+    _prbt_unref(node);
+
+    return res;
+}
+
+
+
+DBG_STATIC
+cm_prbt_node * _prbt_redden(struct _prbt_ctx * ctx, cm_prbt_node * node) {
+
+    cm_prbt_node * res;
+
+
+    if (!_prbt_is_black(node)) return node;
+
+    res = _prbt_cpy(ctx, CM_RBT_RED,
+                    _prbt_ref(node->left), node, _prbt_ref(node->right));
+    _prbt_unref(node);
+
+    return res;
+}
+
+
+
+//build a black node, resolving a red-red violation below it
+DBG_STATIC
+cm_prbt_node * _prbt_balance(struct _prbt_ctx * ctx, cm_prbt_node * left,
+                             const void * key, const void * data,
+                             cm_prbt_node * right) {
+
+    cm_prbt_node * x, * res;
+
+
+    if (_prbt_is_red(left) && _prbt_is_red(right)) {
+
+        res = _prbt_mk(ctx, CM_RBT_RED,
+                       _prbt_cpy(ctx, CM_RBT_BLACK, _prbt_ref(left->left),
+                                 left, _prbt_ref(left->right)),
+                       key, data,
+                       _prbt_cpy(ctx, CM_RBT_BLACK, _prbt_ref(right->left),
+                                 right, _prbt_ref(right->right)));
+        _prbt_unref(left);
+        _prbt_unref(right);
+        return res;
+    }
+
+    if (_prbt_is_red(left) && _prbt_is_red(left->left)) {
+
+        x = left->left;
+        res = _prbt_cpy(ctx, CM_RBT_RED,
+                        _prbt_cpy(ctx, CM_RBT_BLACK, _prbt_ref(x->left),
+                                  x, _prbt_ref(x->right)),
+                        left,
+                        _prbt_mk(ctx, CM_RBT_BLACK, _prbt_ref(left->right),
+                                 key, data, right));
+        _prbt_unref(left);
+        return res;
+    }
+
+    if (_prbt_is_red(left) && _prbt_is_red(left->right)) {
+
+        x = left->right;
+        res = _prbt_cpy(ctx, CM_RBT_RED,
+                        _prbt_cpy(ctx, CM_RBT_BLACK, _prbt_ref(left->left),
+                                  left, _prbt_ref(x->left)),
+                        x,
+                        _prbt_mk(ctx, CM_RBT_BLACK, _prbt_ref(x->right),
+                                 key, data, right));
+        _prbt_unref(left);
+        return res;
+    }
+
+    if (_prbt_is_red(right) && _prbt_is_red(right->right)) {
+
+        x = right->right;
+        res = _prbt_cpy(ctx, CM_RBT_RED,
+                        _prbt_mk(ctx, CM_RBT_BLACK, left,
+                                 key, data, _prbt_ref(right->left)),
+                        right,
+                        _prbt_cpy(ctx, CM_RBT_BLACK, _prbt_ref(x->left),
+                                  x, _prbt_ref(x->right)));
+        _prbt_unref(right);
+        return res;
+    }
+
+    if (_prbt_is_red(right) && _prbt_is_red(right->left)) {
+
+        x = right->left;
+        res = _prbt_cpy(ctx, CM_RBT_RED,
+                        _prbt_mk(ctx, CM_RBT_BLACK, left,
+                                 key, data, _prbt_ref(x->left)),
+                        x,
+                        _prbt_cpy(ctx, CM_RBT_BLACK, _prbt_ref(x->right),
+                                  right, _prbt_ref(right->right)));
+        _prbt_unref(right);
+        return res;
+    }
+
+    return _prbt_mk(ctx, CM_RBT_BLACK, left, key, data, right);
+}
+
+
+
+//the left subtree lost a black node
+DBG_STATIC
+cm_prbt_node * _prbt_balance_left(struct _prbt_ctx * ctx,
+                                  cm_prbt_node * left, const void * key,
+                                  const void * data, cm_prbt_node * right) {
+
+    cm_prbt_node * x, * res;
+
+
+    if (_prbt_is_red(left)) {
+
+        res = _prbt_mk(ctx, CM_RBT_RED,
+                       _prbt_cpy(ctx, CM_RBT_BLACK, _prbt_ref(left->left),
+                                 left, _prbt_ref(left->right)),
+                       key, data, right);
+        _prbt_unref(left);
+        return res;
+    }
+
+    if (_prbt_is_black(right)) {
+
+        res = _prbt_balance(ctx, left, key, data,
+                            _prbt_cpy(ctx, CM_RBT_RED, _prbt_ref(right->left),
+                                      right, _prbt_ref(right->right)));
+        _prbt_unref(right);
+        return res;
+    }
+
+    if (_prbt_is_red(right) && _prbt_is_black(right->left)) {
+
+        x = right->left;
+        res = _prbt_cpy(ctx, CM_RBT_RED,
+                        _prbt_mk(ctx, CM_RBT_BLACK, left,
+                                 key, data, _prbt_ref(x->left)),
+                        x,
+                        _prbt_balance(ctx, _prbt_ref(x->right),
+                                      right->key, right->data,
+                                      _prbt_redden(ctx,
+                                          _prbt_ref(right->right))));
+        _prbt_unref(right);
+        return res;
+    }
+
+    //only reached after a failed allocation
+    return _prbt_mk(ctx, CM_RBT_BLACK, left, key, data, right);
+}
+
+
+
+//the right subtree lost a black node
+DBG_STATIC
+cm_prbt_node * _prbt_balance_right(struct _prbt_ctx * ctx,
+                                   cm_prbt_node * left, const void * key,
+                                   const void * data, cm_prbt_node * right) {
+
+    cm_prbt_node * x, * res;
+
+
+    if (_prbt_is_red(right)) {
+
+        res = _prbt_mk(ctx, CM_RBT_RED, left, key, data,
+                       _prbt_cpy(ctx, CM_RBT_BLACK, _prbt_ref(right->left),
+                                 right, _prbt_ref(right->right)));
+        _prbt_unref(right);
+        return res;
+    }
+
+    if (_prbt_is_black(left)) {
+
+        res = _prbt_balance(ctx,
+                            _prbt_cpy(ctx, CM_RBT_RED, _prbt_ref(left->left),
+                                      left, _prbt_ref(left->right)),
+                            key, data, right);
+        _prbt_unref(left);
+        return res;
+    }
+
+    if (_prbt_is_red(left) && _prbt_is_black(left->right)) {
+
+        x = left->right;
+        res = _prbt_cpy(ctx, CM_RBT_RED,
+                        _prbt_balance(ctx,
+                                      _prbt_redden(ctx,
+                                          _prbt_ref(left->left)),
+                                      left->key, left->data,
+                                      _prbt_ref(x->left)),
+                        x,
+                        _prbt_mk(ctx, CM_RBT_BLACK, _prbt_ref(x->right),
+                                 key, data, right));
+        _prbt_unref(left);
+        return res;
+    }
+
+    //only reached after a failed allocation
+    return _prbt_mk(ctx, CM_RBT_BLACK, left, key, data, right);
+}
+
+
+
+//join the borrowed subtrees of a removed node
+DBG_STATIC
+cm_prbt_node * _prbt_fuse(struct _prbt_ctx * ctx,
+                          cm_prbt_node * left, cm_prbt_node * right) {
+
+    cm_prbt_node * mid, * res;
+
+
+    if (left == NULL) return _prbt_ref(right);
+    if (right == NULL) return _prbt_ref(left);
+
+    //both red or both black: fuse the inner subtrees
+    if (left->colour == right->colour) {
+
+        mid = _prbt_fuse(ctx, left->right, right->left);
+
+        if (_prbt_is_red(mid)) {
+            res = _prbt_cpy(ctx, CM_RBT_RED,
+                            _prbt_cpy(ctx, left->colour, _prbt_ref(left->left),
+                                      left, _prbt_ref(mid->left)),
+                            mid,
+                            _prbt_cpy(ctx, right->colour, _prbt_ref(mid->right),
+                                      right, _prbt_ref(right->right)));
+            _prbt_unref(mid);
+            return res;
+        }
+
+        if (left->colour == CM_RBT_RED) {
+            return _prbt_cpy(ctx, CM_RBT_RED, _prbt_ref(left->left), left,
+                             _prbt_cpy(ctx, CM_RBT_RED, mid, right,
+                                       _prbt_ref(right->right)));
+        }
+
+        return _prbt_balance_left(ctx, _prbt_ref(left->left),
+                                  left->key, left->data,
+                                  _prbt_cpy(ctx, CM_RBT_BLACK, mid, right,
+                                            _prbt_ref(right->right)));
+    }
+
+    if (right->colour == CM_RBT_RED) {
+        return _prbt_cpy(ctx, CM_RBT_RED,
+                         _prbt_fuse(ctx, left, right->left), right,
+                         _prbt_ref(right->right));
+    }
+
+    return _prbt_cpy(ctx, CM_RBT_RED, _prbt_ref(left->left), left,
+                     _prbt_fuse(ctx, left->right, right));
+}
+
+
+
+//copy the search path, inserting or replacing at its end
+DBG_STATIC
+cm_prbt_node * _prbt_ins(struct _prbt_ctx * ctx, cm_prbt_node * node) {
+
+    enum cm_rbt_side side;
+
+
+    if (node == NULL) {
+        return _prbt_mk(ctx, CM_RBT_RED, NULL, ctx->key, ctx->data, NULL);
+    }
+
+    side = ctx->tree->compare(ctx->key, node->key);
+
+    if (side == CM_RBT_EQUAL) {
+        return _prbt_mk(ctx, node->colour, _prbt_ref(node->left),
+                        node->key, ctx->data, _prbt_ref(node->right));
+    }
+
+    if (node->colour == CM_RBT_RED) {
+        return side == CM_RBT_LESS
+            ? _prbt_cpy(ctx, CM_RBT_RED, _prbt_ins(ctx, node->left),
+                        node, _prbt_ref(node->right))
+            : _prbt_cpy(ctx, CM_RBT_RED, _prbt_ref(node->left),
+                        node, _prbt_ins(ctx, node->right));
+    }
+
+    return side == CM_RBT_LESS
+        ? _prbt_balance(ctx, _prbt_ins(ctx, node->left),
+                        node->key, node->data, _prbt_ref(node->right))
+        : _prbt_balance(ctx, _prbt_ref(node->left),
+                        node->key, node->data, _prbt_ins(ctx, node->right));
+}
+
+
+
+//copy the search path, removing the node at its end
+DBG_STATIC
+cm_prbt_node * _prbt_del(struct _prbt_ctx * ctx, cm_prbt_node * node) {
+
+    enum cm_rbt_side side;
+
+
+    if (node == NULL) return NULL;
+
+    side = ctx->tree->compare(ctx->key, node->key);
+
+    if (side == CM_RBT_EQUAL) return _prbt_fuse(ctx, node->left, node->right);
+
+    if (side == CM_RBT_LESS) {
+        return _prbt_is_black(node->left)
+            ? _prbt_balance_left(ctx, _prbt_del(ctx, node->left),
+                                 node->key, node->data,
+                                 _prbt_ref(node->right))
+            : _prbt_cpy(ctx, CM_RBT_RED, _prbt_del(ctx, node->left),
+                        node, _prbt_ref(node->right));
+    }
+
+    return _prbt_is_black(node->right)
+        ? _prbt_balance_right(ctx, _prbt_ref(node->left),
+                              node->key, node->data,
+                              _prbt_del(ctx, node->right))
+        : _prbt_cpy(ctx, CM_RBT_RED, _prbt_ref(node->left),
+                    node, _prbt_del(ctx, node->right));
+}
+
+
+
+/*
+ *  --- [EXTERNAL] ---
+ */
+
+int cm_prbt_get(const cm_prbt * tree, const cm_prbt_node * ver,
+                const void * key, void * buf) {
+
+    cm_prbt_node * node;
+
+
+    node = _prbt_find(tree, ver, key);
+    if (node == NULL) {
+        cm_errno = CM_ERR_USER_KEY;
+        return -1;
+    }
+
+    memcpy(buf, node->data, tree->data_sz);
+
+    return 0;
+}
+
+
+
+void * cm_prbt_get_p(const cm_prbt * tree, const cm_prbt_node * ver,
+                     const void * key) {
+
+    cm_prbt_node * node;
+
+
+    node = _prbt_find(tree, ver, key);
+    if (node == NULL) {
+        cm_errno = CM_ERR_USER_KEY;
+        return NULL;
+    }
+
+    return node->data;
+}
+
+
+
+int cm_prbt_set(const cm_prbt * tree, cm_prbt_node * ver,
+                const void * key, const void * data, cm_prbt_node ** new_ver) {
+
+    cm_prbt_node * root;
+    struct _prbt_ctx ctx = {tree, key, data, false};
+
+
+    root = _prbt_blacken(&ctx, _prbt_ins(&ctx, ver));
+    if (ctx.failed) {
+        _prbt_unref(root);
+        return -1;
+    }
+
+    *new_ver = root;
+
+    return 0;
+}
+
+
+
+int cm_prbt_rmv(const cm_prbt * tree, cm_prbt_node * ver,
+                const void * key, cm_prbt_node ** new_ver) {
+
+    cm_prbt_node * root;
+    struct _prbt_ctx ctx = {tree, key, NULL, false};
+
+
+    //a miss would still recolour the path
+    if (_prbt_find(tree, ver, key) == NULL) {
+        cm_errno = CM_ERR_USER_KEY;
+        return -1;
+    }
+
+    root = _prbt_blacken(&ctx, _prbt_del(&ctx, ver));
+    if (ctx.failed) {
+        _prbt_unref(root);
+        return -1;
+    }
+
+    *new_ver = root;
+
+    return 0;
+}
+
+
+
+/*
+ *  Readers take a reference to the published root inside a grace period,
+ *  so the publisher can't drop the old root between the load & the
+ *  increment.
+ */
+
+cm_prbt_node * cm_prbt_snp(cm_prbt * tree) {
+
+    uint32_t parity;
+    cm_prbt_node * ver;
+    struct _cm_crbt_slot * slot;
+
+
+    slot = _crbt_enter(tree->slots, &tree->parity, &parity);
+    ver = _prbt_ref(__atomic_load_n(&tree->root, __ATOMIC_ACQUIRE));
+    _crbt_exit(slot, parity);
+
+    return ver;
+}
+
+
+
+void cm_prbt_pub(cm_prbt * tree, cm_prbt_node * ver) {
+
+    cm_prbt_node * old;
+
+
+    pthread_mutex_lock(&tree->lock);
+
+    old = tree->root;
+    __atomic_store_n(&tree->root, ver, __ATOMIC_SEQ_CST);
+    _crbt_sync(tree->slots, &tree->parity);
+
+    pthread_mutex_unlock(&tree->lock);
+
+    _prbt_unref(old);
+
+    return;
+}
+
+
+
+void cm_prbt_rls(cm_prbt_node * ver) {
+
+    _prbt_unref(ver);
+
+    return;
+}
+
+
+
+int cm_new_prbt(cm_prbt * tree, const size_t key_sz, const size_t data_sz,
+                enum cm_rbt_side (*compare)(const void *, const void *)) {
+
+    tree->slots = aligned_alloc(CM_CACHE_LINE,
+                                sizeof(struct _cm_crbt_slot) * CRBT_SLOTS);
+    if (tree->slots == NULL) {
+        cm_errno = CM_ERR_MALLOC;
+        return -1;
+    }
+    memset(tree->slots, 0, sizeof(struct _cm_crbt_slot) * CRBT_SLOTS);
+
+    pthread_mutex_init(&tree->lock, NULL);
+
+    tree->root    = NULL;
+    tree->parity  = 0;
+    tree->key_sz  = key_sz;
+    tree->data_sz = data_sz;
+    tree->compare = compare;
+    tree->is_init = true;
+
+    return 0;
+}
+
+
+
+void cm_del_prbt(cm_prbt * tree) {
+
+    //snapshots still held stay valid
+    _prbt_unref(tree->root);
+
+    pthread_mutex_destroy(&tree->lock);
+    free(tree->slots);
+
+    tree->is_init = false;
+
+    return;
+}
@@ -0,0 +1,79 @@
+#ifndef PRBT_H
+#define PRBT_H
+
+//standard library
+#include <stdint.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+
+
+// -- [persistent red-black tree]
+
+//key & data are stored after the node header, at this alignment
+#define PRBT_ALIGN 16
+
+
+//state of a single set or remove
+struct _prbt_ctx {
+
+    const cm_prbt * tree;
+    const void * key;
+    const void * data;
+    bool failed;
+};
+
+
+#ifdef CM_DEBUG
+//internal
+bool _prbt_is_red(const cm_prbt_node * node);
+bool _prbt_is_black(const cm_prbt_node * node);
+size_t _prbt_round(const size_t sz);
+cm_prbt_node * _prbt_ref(cm_prbt_node * node);
+void _prbt_unref(cm_prbt_node * node);
+cm_prbt_node * _prbt_find(const cm_prbt * tree,
+                          const cm_prbt_node * ver, const void * key);
+cm_prbt_node * _prbt_mk(struct _prbt_ctx * ctx, enum cm_rbt_colour colour,
+                        cm_prbt_node * left, const void * key,
+                        const void * data, cm_prbt_node * right);
+cm_prbt_node * _prbt_cpy(struct _prbt_ctx * ctx, enum cm_rbt_colour colour,
+                         cm_prbt_node * left, const cm_prbt_node * src,
+                         cm_prbt_node * right);
+cm_prbt_node * _prbt_blacken(struct _prbt_ctx * ctx, cm_prbt_node * node);
+cm_prbt_node * _prbt_redden(struct _prbt_ctx * ctx, cm_prbt_node * node);
+cm_prbt_node * _prbt_balance(struct _prbt_ctx * ctx, cm_prbt_node * left,
+                             const void * key, const void * data,
+                             cm_prbt_node * right);
+cm_prbt_node * _prbt_balance_left(struct _prbt_ctx * ctx,
+                                  cm_prbt_node * left, const void * key,
+                                  const void * data, cm_prbt_node * right);
+cm_prbt_node * _prbt_balance_right(struct _prbt_ctx * ctx,
+                                   cm_prbt_node * left, const void * key,
+                                   const void * data, cm_prbt_node * right);
+cm_prbt_node * _prbt_fuse(struct _prbt_ctx * ctx,
+                          cm_prbt_node * left, cm_prbt_node * right);
+cm_prbt_node * _prbt_ins(struct _prbt_ctx * ctx, cm_prbt_node * node);
+cm_prbt_node * _prbt_del(struct _prbt_ctx * ctx, cm_prbt_node * node);
+#endif
+
+
+//external
+int cm_prbt_get(const cm_prbt * tree, const cm_prbt_node * ver,
+                const void * key, void * buf);
+void * cm_prbt_get_p(const cm_prbt * tree, const cm_prbt_node * ver,
+                     const void * key);
+int cm_prbt_set(const cm_prbt * tree, cm_prbt_node * ver,
+                const void * key, const void * data, cm_prbt_node ** new_ver);
+int cm_prbt_rmv(const cm_prbt * tree, cm_prbt_node * ver,
+                const void * key, cm_prbt_node ** new_ver);
+
+cm_prbt_node * cm_prbt_snp(cm_prbt * tree);
+void cm_prbt_pub(cm_prbt * tree, cm_prbt_node * ver);
+void cm_prbt_rls(cm_prbt_node * ver);
+
+int cm_new_prbt(cm_prbt * tree, const size_t key_sz, const size_t data_sz,
+                enum cm_rbt_side (*compare)(const void *, const void *));
+void cm_del_prbt(cm_prbt * tree);
+
+#endif
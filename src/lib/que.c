@@ -0,0 +1,682 @@
+//standard library
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+
+//system headers
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <linux/membarrier.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "cpu.h"
+#include "que.h"
+
+
+
+//set if this process can issue expedited membarrier() calls
+static int _que_membar;
+static pthread_once_t _que_membar_once = PTHREAD_ONCE_INIT;
+
+
+
+/*
+ *  --- [QUEUE - INTERNAL] ---
+ */
+
+DBG_STATIC
+void _que_membar_init() {
+
+    int ret;
+
+
+    ret = syscall(SYS_membarrier,
+                  MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+    __atomic_store_n(&_que_membar, ret, __ATOMIC_RELEASE);
+
+    return;
+}
+
+
+
+//round a slot count up to a power of two
+DBG_STATIC
+size_t _que_round_sz(const int slots) {
+
+    size_t sz = 1;
+
+    while (sz < (size_t) slots) sz *= 2;
+
+    return sz;
+}
+
+
+
+/*
+ *  Blocking calls sleep on a futex `word` that the opposite side bumps 
+ *  after making progress, but only while `waiters` is non-zero. The 
+ *  sleeper registers itself & samples `word` before its final attempt, so
+ *  progress made after that attempt always changes `word` & the futex 
+ *  wait returns immediately.
+ *
+ *  Registering must be ordered before the final attempt, & the other
+ *  side's slot update before its read of `waiters`. Where membarrier() is
+ *  available the sleeper pays for both with one expedited barrier, & the
+ *  non-blocking calls that notify only need a compiler barrier. Every
+ *  thread sleeping on a word passed to _que_notify() must therefore
+ *  register through _que_register().
+ */
+
+DBG_STATIC
+void _que_park(uint32_t * word, uint32_t * waiters, cm_mpmc * mpmc,
+               void * data, bool (* attempt)(cm_mpmc *, void *)) {
+
+    uint32_t seen;
+
+
+    for (int i = 0; ; ++i) {
+
+        if (attempt(mpmc, data)) return;
+
+        //spin briefly before sleeping
+        if (i < QUE_SPIN) {
+            _que_relax(i);
+            continue;
+        }
+
+        seen = _que_register(word, waiters);
+
+        if (attempt(mpmc, data)) {
+            __atomic_sub_fetch(waiters, 1, __ATOMIC_SEQ_CST);
+            return;
+        }
+
+        syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, seen, NULL, NULL, 0);
+        __atomic_sub_fetch(waiters, 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+
+
+/*
+ *  --- [SHARED] ---
+ */
+
+//back off while another thread finishes with a slot
+void _que_relax(const int spins) {
+
+    if (spins < QUE_SPIN) {
+#ifdef CPU_X86
+        __builtin_ia32_pause();
+#endif
+    } else {
+        sched_yield();
+    }
+
+    return;
+}
+
+
+
+//register as a waiter on `word` & return its value, before a final attempt
+uint32_t _que_register(uint32_t * word, uint32_t * waiters) {
+
+    __atomic_add_fetch(waiters, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&_que_membar, __ATOMIC_ACQUIRE)) {
+        syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+    }
+
+    return __atomic_load_n(word, __ATOMIC_SEQ_CST);
+}
+
+
+
+//wake up to `n` threads parked on `word`
+void _que_notify(uint32_t * word, uint32_t * waiters, const int n) {
+
+    //order the caller's slot update before the read of `waiters`
+    if (__atomic_load_n(&_que_membar, __ATOMIC_ACQUIRE)) {
+        __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    } else {
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    }
+    if (__atomic_load_n(waiters, __ATOMIC_RELAXED) == 0) return;
+
+    __atomic_add_fetch(word, 1, __ATOMIC_SEQ_CST);
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, n, NULL, NULL, 0);
+
+    return;
+}
+
+
+
+/*
+ *  --- [SPSC - INTERNAL] ---
+ */
+
+/*
+ *  `head` & `tail` count slots consumed & produced since creation; their
+ *  difference is the number of slots in use. Each side keeps a private 
+ *  copy of the other side's counter and only reloads it, with acquire 
+ *  semantics, when the copy says there is not enough room or data.
+ */
+
+DBG_STATIC DBG_INLINE
+void * _spsc_traverse(const cm_spsc * spsc, const size_t pos) {
+
+    return spsc->data + (spsc->data_sz * (pos & (spsc->sz - 1)));
+}
+
+
+
+//producer: number of free slots, at most `want`
+DBG_STATIC DBG_INLINE
+size_t _spsc_free(cm_spsc * spsc, const size_t want) {
+
+    size_t free_n;
+
+
+    free_n = spsc->sz - (spsc->tail - spsc->head_cache);
+    if (free_n < want) {
+        spsc->head_cache = QUE_LOAD_ACQ(&spsc->head);
+        free_n = spsc->sz - (spsc->tail - spsc->head_cache);
+    }
+
+    return free_n < want ? free_n : want;
+}
+
+
+
+//consumer: number of used slots, at most `want`
+DBG_STATIC DBG_INLINE
+size_t _spsc_used(cm_spsc * spsc, const size_t want) {
+
+    size_t used_n;
+
+
+    used_n = spsc->tail_cache - spsc->head;
+    if (used_n < want) {
+        spsc->tail_cache = QUE_LOAD_ACQ(&spsc->tail);
+        used_n = spsc->tail_cache - spsc->head;
+    }
+
+    return used_n < want ? used_n : want;
+}
+
+
+
+/*
+ *  --- [SPSC - EXTERNAL] ---
+ */
+
+int cm_spsc_enq(cm_spsc * spsc, const void * data) {
+
+    //queue must have space
+    if (_spsc_free(spsc, 1) == 0) {
+        cm_errno = CM_ERR_USER_FULL;
+        return -1;
+    }
+
+    memcpy(_spsc_traverse(spsc, spsc->tail), data, spsc->data_sz);
+    QUE_STORE_REL(&spsc->tail, spsc->tail + 1);
+
+    return 0;
+}
+
+
+
+int cm_spsc_deq(cm_spsc * spsc, void * buf) {
+
+    //queue must not be empty
+    if (_spsc_used(spsc, 1) == 0) {
+        cm_errno = CM_ERR_USER_EMPTY;
+        return -1;
+    }
+
+    memcpy(buf, _spsc_traverse(spsc, spsc->head), spsc->data_sz);
+    QUE_STORE_REL(&spsc->head, spsc->head + 1);
+
+    return 0;
+}
+
+
+
+int cm_spsc_enq_n(cm_spsc * spsc, const void * data, const int n) {
+
+    size_t done, run_n;
+
+
+    if (n < 1) return 0;
+
+    done  = _spsc_free(spsc, (size_t) n);
+    run_n = spsc->sz - (spsc->tail & (spsc->sz - 1));
+    if (run_n > done) run_n = done;
+
+    //copy in up to two contiguous runs, then publish them together
+    memcpy(_spsc_traverse(spsc, spsc->tail), data, spsc->data_sz * run_n);
+    memcpy(spsc->data, data + (spsc->data_sz * run_n),
+           spsc->data_sz * (done - run_n));
+
+    QUE_STORE_REL(&spsc->tail, spsc->tail + done);
+
+    return (int) done;
+}
+
+
+
+int cm_spsc_deq_n(cm_spsc * spsc, void * buf, const int n) {
+
+    size_t done, run_n;
+
+
+    if (n < 1) return 0;
+
+    done  = _spsc_used(spsc, (size_t) n);
+    run_n = spsc->sz - (spsc->head & (spsc->sz - 1));
+    if (run_n > done) run_n = done;
+
+    //copy out up to two contiguous runs, then release them together
+    memcpy(buf, _spsc_traverse(spsc, spsc->head), spsc->data_sz * run_n);
+    memcpy(buf + (spsc->data_sz * run_n), spsc->data,
+           spsc->data_sz * (done - run_n));
+
+    QUE_STORE_REL(&spsc->head, spsc->head + done);
+
+    return (int) done;
+}
+
+
+
+int cm_spsc_rsv(cm_spsc * spsc, void ** slots, const int n) {
+
+    size_t free_n, run_n;
+
+
+    if (n < 1) return 0;
+
+    //at most until the end of the ring
+    free_n = _spsc_free(spsc, (size_t) n);
+    run_n  = spsc->sz - (spsc->tail & (spsc->sz - 1));
+    if (free_n > run_n) free_n = run_n;
+
+    *slots = _spsc_traverse(spsc, spsc->tail);
+
+    return (int) free_n;
+}
+
+
+
+void cm_spsc_cmt(cm_spsc * spsc, const int n) {
+
+    QUE_STORE_REL(&spsc->tail, spsc->tail + n);
+
+    return;
+}
+
+
+
+int cm_spsc_pek(cm_spsc * spsc, void ** slots, const int n) {
+
+    size_t used_n, run_n;
+
+
+    if (n < 1) return 0;
+
+    //at most until the end of the ring
+    used_n = _spsc_used(spsc, (size_t) n);
+    run_n  = spsc->sz - (spsc->head & (spsc->sz - 1));
+    if (used_n > run_n) used_n = run_n;
+
+    *slots = _spsc_traverse(spsc, spsc->head);
+
+    return (int) used_n;
+}
+
+
+
+void cm_spsc_rls(cm_spsc * spsc, const int n) {
+
+    QUE_STORE_REL(&spsc->head, spsc->head + n);
+
+    return;
+}
+
+
+
+int cm_new_spsc(cm_spsc * spsc, const size_t data_sz, const int slots) {
+
+    //there must be at least one slot
+    if (slots < 1) {
+        cm_errno = CM_ERR_USER_ARG;
+        return -1;
+    }
+
+    spsc->sz      = _que_round_sz(slots);
+    spsc->data_sz = data_sz;
+
+    spsc->data = malloc(spsc->sz * spsc->data_sz);
+    if (spsc->data == NULL) {
+        cm_errno = CM_ERR_MALLOC;
+        return -1;
+    }
+
+    spsc->head       = 0;
+    spsc->tail_cache = 0;
+    spsc->tail       = 0;
+    spsc->head_cache = 0;
+    spsc->is_init    = true;
+
+    return 0;
+}
+
+
+
+void cm_del_spsc(cm_spsc * spsc) {
+
+    free(spsc->data);
+    spsc->is_init = false;
+
+    return;
+}
+
+
+
+
+/*
+ *  --- [MPMC - INTERNAL] ---
+ */
+
+/*
+ *  Each slot starts with a sequence number that says whose turn it is:
+ *  `seq == pos` means the slot is free for the producer that claims 
+ *  position `pos`, `seq == pos + 1` means it holds that producer's element,
+ *  and the consumer hands it to the next lap by storing `pos + sz`.
+ */
+
+DBG_STATIC DBG_INLINE
+size_t * _mpmc_seq(const cm_mpmc * mpmc, const size_t pos) {
+
+    return mpmc->slots + (mpmc->slot_sz * (pos & (mpmc->sz - 1)));
+}
+
+
+
+DBG_STATIC DBG_INLINE
+void * _mpmc_traverse(const cm_mpmc * mpmc, const size_t pos) {
+
+    return (void *) _mpmc_seq(mpmc, pos) + sizeof(size_t);
+}
+
+
+
+DBG_STATIC
+bool _mpmc_enq(cm_mpmc * mpmc, void * data) {
+
+    size_t pos, seq;
+    intptr_t dif;
+
+
+    pos = __atomic_load_n(&mpmc->enq_pos, __ATOMIC_RELAXED);
+    while (true) {
+
+        seq = QUE_LOAD_ACQ(_mpmc_seq(mpmc, pos));
+        dif = (intptr_t) seq - (intptr_t) pos;
+
+        //slot is free, try to claim it
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&mpmc->enq_pos, &pos, pos + 1,
+                    true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+
+        //slot still holds last lap's element
+        } else if (dif < 0) {
+            return false;
+
+        //another producer claimed it first
+        } else {
+            pos = __atomic_load_n(&mpmc->enq_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    memcpy(_mpmc_traverse(mpmc, pos), data, mpmc->data_sz);
+    QUE_STORE_REL(_mpmc_seq(mpmc, pos), pos + 1);
+
+    _que_notify(&mpmc->not_empty, &mpmc->deq_wait, 1);
+
+    return true;
+}
+
+
+
+DBG_STATIC
+bool _mpmc_deq(cm_mpmc * mpmc, void * buf) {
+
+    size_t pos, seq;
+    intptr_t dif;
+
+
+    pos = __atomic_load_n(&mpmc->deq_pos, __ATOMIC_RELAXED);
+    while (true) {
+
+        seq = QUE_LOAD_ACQ(_mpmc_seq(mpmc, pos));
+        dif = (intptr_t) seq - (intptr_t) (pos + 1);
+
+        //slot holds an element, try to claim it
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&mpmc->deq_pos, &pos, pos + 1,
+                    true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+
+        //slot has not been filled yet
+        } else if (dif < 0) {
+            return false;
+
+        //another consumer claimed it first
+        } else {
+            pos = __atomic_load_n(&mpmc->deq_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    memcpy(buf, _mpmc_traverse(mpmc, pos), mpmc->data_sz);
+    QUE_STORE_REL(_mpmc_seq(mpmc, pos), pos + mpmc->sz);
+
+    _que_notify(&mpmc->not_full, &mpmc->enq_wait, 1);
+
+    return true;
+}
+
+
+
+/*
+ *  Batches claim a run of positions with a single CAS, bounded by the 
+ *  opposite side's position (`*lim_ptr + lim_off`). A claimed slot may 
+ *  still be in the hands of a thread on the opposite side that claimed 
+ *  it but has not finished copying, so each slot's sequence number is 
+ *  awaited before use.
+ */
+
+DBG_STATIC
+size_t _mpmc_claim(size_t * pos_ptr, const size_t * lim_ptr,
+                   const size_t lim_off, const size_t want, size_t * pos) {
+
+    intptr_t avail;
+
+
+    *pos = __atomic_load_n(pos_ptr, __ATOMIC_RELAXED);
+    while (true) {
+
+        avail = (intptr_t) (QUE_LOAD_ACQ(lim_ptr) + lim_off - *pos);
+        if (avail <= 0) return 0;
+        if ((size_t) avail > want) avail = (intptr_t) want;
+
+        if (__atomic_compare_exchange_n(pos_ptr, pos, *pos + avail,
+                true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+    }
+
+    return (size_t) avail;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+void _mpmc_wait_seq(const cm_mpmc * mpmc, const size_t pos,
+                    const size_t seq) {
+
+    for (int i = 0; QUE_LOAD_ACQ(_mpmc_seq(mpmc, pos)) != seq; ++i) {
+        _que_relax(i);
+    }
+
+    return;
+}
+
+
+
+/*
+ *  --- [MPMC - EXTERNAL] ---
+ */
+
+int cm_mpmc_enq(cm_mpmc * mpmc, const void * data) {
+
+    if (!_mpmc_enq(mpmc, (void *) data)) {
+        cm_errno = CM_ERR_USER_FULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+
+int cm_mpmc_deq(cm_mpmc * mpmc, void * buf) {
+
+    if (!_mpmc_deq(mpmc, buf)) {
+        cm_errno = CM_ERR_USER_EMPTY;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+
+void cm_mpmc_enq_w(cm_mpmc * mpmc, const void * data) {
+
+    _que_park(&mpmc->not_full, &mpmc->enq_wait,
+              mpmc, (void *) data, _mpmc_enq);
+
+    return;
+}
+
+
+
+void cm_mpmc_deq_w(cm_mpmc * mpmc, void * buf) {
+
+    _que_park(&mpmc->not_empty, &mpmc->deq_wait, mpmc, buf, _mpmc_deq);
+
+    return;
+}
+
+
+
+int cm_mpmc_enq_n(cm_mpmc * mpmc, const void * data, const int n) {
+
+    size_t pos, done;
+
+
+    if (n < 1) return 0;
+
+    done = _mpmc_claim(&mpmc->enq_pos, &mpmc->deq_pos,
+                       mpmc->sz, (size_t) n, &pos);
+
+    for (size_t i = 0; i < done; ++i) {
+
+        _mpmc_wait_seq(mpmc, pos + i, pos + i);
+        memcpy(_mpmc_traverse(mpmc, pos + i),
+               data + (mpmc->data_sz * i), mpmc->data_sz);
+        QUE_STORE_REL(_mpmc_seq(mpmc, pos + i), pos + i + 1);
+    }
+
+    if (done != 0) _que_notify(&mpmc->not_empty, &mpmc->deq_wait, done);
+
+    return (int) done;
+}
+
+
+
+int cm_mpmc_deq_n(cm_mpmc * mpmc, void * buf, const int n) {
+
+    size_t pos, done;
+
+
+    if (n < 1) return 0;
+
+    done = _mpmc_claim(&mpmc->deq_pos, &mpmc->enq_pos,
+                       0, (size_t) n, &pos);
+
+    for (size_t i = 0; i < done; ++i) {
+
+        _mpmc_wait_seq(mpmc, pos + i, pos + i + 1);
+        memcpy(buf + (mpmc->data_sz * i),
+               _mpmc_traverse(mpmc, pos + i), mpmc->data_sz);
+        QUE_STORE_REL(_mpmc_seq(mpmc, pos + i), pos + i + mpmc->sz);
+    }
+
+    if (done != 0) _que_notify(&mpmc->not_full, &mpmc->enq_wait, done);
+
+    return (int) done;
+}
+
+
+
+int cm_new_mpmc(cm_mpmc * mpmc, const size_t data_sz, const int slots) {
+
+    //there must be at least one slot
+    if (slots < 1) {
+        cm_errno = CM_ERR_USER_ARG;
+        return -1;
+    }
+
+    //a single slot's sequence numbers can't tell full from free
+    mpmc->sz      = _que_round_sz(slots < 2 ? 2 : slots);
+    mpmc->data_sz = data_sz;
+
+    //keep every slot's sequence number aligned
+    mpmc->slot_sz = sizeof(size_t) + data_sz;
+    mpmc->slot_sz = (mpmc->slot_sz + sizeof(size_t) - 1)
+                    & ~(sizeof(size_t) - 1);
+
+    mpmc->slots = malloc(mpmc->sz * mpmc->slot_sz);
+    if (mpmc->slots == NULL) {
+        cm_errno = CM_ERR_MALLOC;
+        return -1;
+    }
+
+    for (size_t i = 0; i < mpmc->sz; ++i) *_mpmc_seq(mpmc, i) = i;
+
+    //let blocking calls take the cost of ordering from the fast path
+    pthread_once(&_que_membar_once, _que_membar_init);
+
+    mpmc->enq_pos   = 0;
+    mpmc->deq_pos   = 0;
+    mpmc->not_empty = 0;
+    mpmc->deq_wait  = 0;
+    mpmc->not_full  = 0;
+    mpmc->enq_wait  = 0;
+    mpmc->is_init   = true;
+
+    return 0;
+}
+
+
+
+void cm_del_mpmc(cm_mpmc * mpmc) {
+
+    free(mpmc->slots);
+    mpmc->is_init = false;
+
+    return;
+}
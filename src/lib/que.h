@@ -0,0 +1,78 @@
+#ifndef QUE_H
+#define QUE_H
+
+//standard library
+#include <stdint.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "cpu.h"
+
+
+// -- [concurrent queues]
+
+//atomics shared between threads
+#define QUE_LOAD_ACQ(ptr)       __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define QUE_STORE_REL(ptr, val) __atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+
+//attempts made in userspace before a blocking call sleeps on a futex
+#define QUE_SPIN 64
+
+
+#ifdef CM_DEBUG
+//internal
+size_t _que_round_sz(const int slots);
+void _que_membar_init();
+void * _spsc_traverse(const cm_spsc * spsc, const size_t pos);
+size_t _spsc_free(cm_spsc * spsc, const size_t want);
+size_t _spsc_used(cm_spsc * spsc, const size_t want);
+
+void _que_park(uint32_t * word, uint32_t * waiters, cm_mpmc * mpmc,
+               void * data, bool (* attempt)(cm_mpmc *, void *));
+
+size_t * _mpmc_seq(const cm_mpmc * mpmc, const size_t pos);
+void * _mpmc_traverse(const cm_mpmc * mpmc, const size_t pos);
+bool _mpmc_enq(cm_mpmc * mpmc, void * data);
+bool _mpmc_deq(cm_mpmc * mpmc, void * buf);
+size_t _mpmc_claim(size_t * pos_ptr, const size_t * lim_ptr,
+                   const size_t lim_off, const size_t want, size_t * pos);
+void _mpmc_wait_seq(const cm_mpmc * mpmc, const size_t pos,
+                    const size_t seq);
+#endif
+
+
+//shared
+CPU_HIDDEN void _que_relax(const int spins);
+CPU_HIDDEN uint32_t _que_register(uint32_t * word, uint32_t * waiters);
+CPU_HIDDEN void _que_notify(uint32_t * word, uint32_t * waiters, const int n);
+
+
+//external
+int cm_spsc_enq(cm_spsc * spsc, const void * data);
+int cm_spsc_deq(cm_spsc * spsc, void * buf);
+int cm_spsc_enq_n(cm_spsc * spsc, const void * data, const int n);
+int cm_spsc_deq_n(cm_spsc * spsc, void * buf, const int n);
+
+int cm_spsc_rsv(cm_spsc * spsc, void ** slots, const int n);
+void cm_spsc_cmt(cm_spsc * spsc, const int n);
+int cm_spsc_pek(cm_spsc * spsc, void ** slots, const int n);
+void cm_spsc_rls(cm_spsc * spsc, const int n);
+
+int cm_new_spsc(cm_spsc * spsc, const size_t data_sz, const int slots);
+void cm_del_spsc(cm_spsc * spsc);
+
+int cm_mpmc_enq(cm_mpmc * mpmc, const void * data);
+int cm_mpmc_deq(cm_mpmc * mpmc, void * buf);
+void cm_mpmc_enq_w(cm_mpmc * mpmc, const void * data);
+void cm_mpmc_deq_w(cm_mpmc * mpmc, void * buf);
+int cm_mpmc_enq_n(cm_mpmc * mpmc, const void * data, const int n);
+int cm_mpmc_deq_n(cm_mpmc * mpmc, void * buf, const int n);
+
+int cm_new_mpmc(cm_mpmc * mpmc, const size_t data_sz, const int slots);
+void cm_del_mpmc(cm_mpmc * mpmc);
+
+#endif
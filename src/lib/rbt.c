@@ -24,23 +24,192 @@
  *  --- [RED-BLACK TREE - INTERNAL] ---
  */
 
+/*
+ *  Node field accessors. With CM_RBT_COMPACT, a node's colour & the side
+ *  of its parent it hangs off are packed into the low bits of its parent
+ *  pointer; nodes are malloc'd so those bits are always free.
+ */
+
+DBG_STATIC DBG_INLINE
+cm_rbt_node * _rbt_get_parent(const cm_rbt_node * node) {
+
+    return CM_RBT_PARENT(node);
+}
+
+
+
+DBG_STATIC DBG_INLINE
+enum cm_rbt_side _rbt_get_side(const cm_rbt_node * node) {
+
+    return CM_RBT_SIDE(node);
+}
+
+
+
+DBG_STATIC DBG_INLINE 
+enum cm_rbt_colour _rbt_get_colour(const cm_rbt_node * node) {
+
+    if (node == NULL) return CM_RBT_BLACK;
+    return CM_RBT_COLOUR(node);
+}
+
+
+
+DBG_STATIC DBG_INLINE
+void _rbt_set_parent(cm_rbt_node * node, cm_rbt_node * parent) {
+
+#ifdef CM_RBT_COMPACT
+    node->parent_bits = (uintptr_t) parent 
+                        | (node->parent_bits & ~CM_RBT_PARENT_MASK);
+#else
+    node->parent = parent;
+#endif
+
+    return;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+void _rbt_set_side(cm_rbt_node * node, const enum cm_rbt_side side) {
+
+#ifdef CM_RBT_COMPACT
+    node->parent_bits = (node->parent_bits & ~CM_RBT_SIDE_MASK)
+                        | ((uintptr_t) side << CM_RBT_SIDE_SHIFT);
+#else
+    node->parent_side = side;
+#endif
+
+    return;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+void _rbt_set_colour(cm_rbt_node * node, const enum cm_rbt_colour colour) {
+
+#ifdef CM_RBT_COMPACT
+    node->parent_bits = (node->parent_bits & ~CM_RBT_COLOUR_MASK)
+                        | (uintptr_t) colour;
+#else
+    node->colour = colour;
+#endif
+
+    return;
+}
+
+
+
+/*
+ *  Built-in key kinds compare in place instead of through `compare`. The
+ *  typed descents pick the child with a select rather than a switch on 
+ *  the comparison, so the only unpredictable branch is the loop exit.
+ */
+
+#define RBT_DEF_KEY(sfx, type)                                               \
+DBG_STATIC DBG_INLINE                                                        \
+enum cm_rbt_side _rbt_cmp_##sfx(const void * a, const void * b) {            \
+                                                                             \
+    type x, y;                                                               \
+                                                                             \
+    memcpy(&x, a, sizeof(type));                                             \
+    memcpy(&y, b, sizeof(type));                                             \
+                                                                             \
+    if (x < y) return CM_RBT_LESS;                                           \
+    return x == y ? CM_RBT_EQUAL : CM_RBT_MORE;                              \
+}                                                                            \
+                                                                             \
+DBG_STATIC DBG_INLINE                                                        \
+cm_rbt_node * _rbt_descend_##sfx(cm_rbt_node * node, const void * key,       \
+                                 enum cm_rbt_side * side) {                  \
+                                                                             \
+    type k, n;                                                               \
+    cm_rbt_node * next;                                                      \
+                                                                             \
+                                                                             \
+    memcpy(&k, key, sizeof(type));                                           \
+    *side = CM_RBT_ROOT;                                                     \
+                                                                             \
+    while (node != NULL) {                                                   \
+                                                                             \
+        memcpy(&n, node->key, sizeof(type));                                 \
+        if (k == n) {                                                        \
+            *side = CM_RBT_EQUAL;                                            \
+            return node;                                                     \
+        }                                                                    \
+                                                                             \
+        *side = k < n ? CM_RBT_LESS : CM_RBT_MORE;                           \
+        next  = k < n ? node->left : node->right;                            \
+        if (next == NULL) return node;                                       \
+        node = next;                                                         \
+    }                                                                        \
+                                                                             \
+    return node;                                                             \
+}
+
+RBT_DEF_KEY(i32, int32_t)
+RBT_DEF_KEY(u32, uint32_t)
+RBT_DEF_KEY(i64, int64_t)
+RBT_DEF_KEY(u64, uint64_t)
+RBT_DEF_KEY(f64, double)
+
+
+
+DBG_STATIC DBG_INLINE
+enum cm_rbt_side _rbt_compare(const cm_rbt * tree, 
+                              const void * a, const void * b) {
+
+    int ret;
+
+
+    switch (tree->key_kind) {
+
+        case CM_RBT_KEY_I32: return _rbt_cmp_i32(a, b);
+        case CM_RBT_KEY_U32: return _rbt_cmp_u32(a, b);
+        case CM_RBT_KEY_I64: return _rbt_cmp_i64(a, b);
+        case CM_RBT_KEY_U64: return _rbt_cmp_u64(a, b);
+        case CM_RBT_KEY_F64: return _rbt_cmp_f64(a, b);
+
+        case CM_RBT_KEY_MEM:
+            ret = memcmp(a, b, tree->key_sz);
+            if (ret < 0) return CM_RBT_LESS;
+            return ret == 0 ? CM_RBT_EQUAL : CM_RBT_MORE;
+
+        default:
+            return tree->compare(a, b);
+    }
+}
+
+
+
 /*
  *  Returns the node itself in case of a hit. Returns parent in case of a miss.
  */
 
-DBG_STATIC 
-cm_rbt_node * _rbt_traverse(const cm_rbt * tree, 
-                            const void * key, enum cm_rbt_side * side) {
+DBG_STATIC DBG_INLINE
+cm_rbt_node * _rbt_descend(const cm_rbt * tree, cm_rbt_node * node,
+                           const void * key, enum cm_rbt_side * side) {
 
-    cm_rbt_node * node = tree->root;
     bool found = false;
+
+
+    switch (tree->key_kind) {
+
+        case CM_RBT_KEY_I32: return _rbt_descend_i32(node, key, side);
+        case CM_RBT_KEY_U32: return _rbt_descend_u32(node, key, side);
+        case CM_RBT_KEY_I64: return _rbt_descend_i64(node, key, side);
+        case CM_RBT_KEY_U64: return _rbt_descend_u64(node, key, side);
+        case CM_RBT_KEY_F64: return _rbt_descend_f64(node, key, side);
+        default: break;
+    }
+
     *side = CM_RBT_ROOT;
 
 
     //traverse tree
     while (node != NULL && !found) {
 
-        *side = tree->compare(key, node->key);
+        *side = _rbt_compare(tree, key, node->key);
 
         switch (*side) {
 
@@ -71,10 +240,86 @@ cm_rbt_node * _rbt_traverse(const cm_rbt * tree,
 
 
 
+DBG_STATIC 
+cm_rbt_node * _rbt_traverse(const cm_rbt * tree, 
+                            const void * key, enum cm_rbt_side * side) {
+
+    return _rbt_descend(tree, tree->root, key, side);
+}
+
+
+
+/*
+ *  Finger search from `hint`, a node of the tree. Climbs towards the root
+ *  only as far as the key's range requires, comparing against the 
+ *  ancestors that bound it, then descends. A key next to the hint costs
+ *  O(1) comparisons; a key d positions away costs O(log d).
+ */
+
+DBG_STATIC 
+cm_rbt_node * _rbt_traverse_hint(const cm_rbt * tree, cm_rbt_node * hint,
+                                 const void * key, enum cm_rbt_side * side) {
+
+    enum cm_rbt_side dir, bound;
+    cm_rbt_node * up, * child;
+
+
+    if (hint == NULL) return _rbt_traverse(tree, key, side);
+
+    dir = _rbt_compare(tree, key, hint->key);
+    if (dir == CM_RBT_EQUAL) {
+        *side = CM_RBT_EQUAL;
+        return hint;
+    }
+
+    //climb while the next bounding ancestor is still on the key's side
+    for (;;) {
+
+        for (up = hint; _rbt_get_side(up) == dir; 
+             up = _rbt_get_parent(up));
+        if (_rbt_get_side(up) == CM_RBT_ROOT) break;
+
+        bound = _rbt_compare(tree, key, _rbt_get_parent(up)->key);
+        if (bound == CM_RBT_EQUAL) {
+            *side = CM_RBT_EQUAL;
+            return _rbt_get_parent(up);
+        }
+        if (bound != dir) break;
+
+        hint = _rbt_get_parent(up);
+    }
+
+    //the key is between the hint & its bound
+    child = dir == CM_RBT_LESS ? hint->left : hint->right;
+    if (child == NULL) {
+        *side = dir;
+        return hint;
+    }
+
+    return _rbt_descend(tree, child, key, side);
+}
+
+
+
 DBG_STATIC 
 cm_rbt_node * _rbt_new_node(const cm_rbt * tree,
                             const void * key, const void * data) {
 
+#ifdef CM_RBT_COMPACT
+    //allocate node structure, followed by its key & data
+    cm_rbt_node * new_node = malloc(sizeof(cm_rbt_node) 
+                                    + RBT_KEY_PAD(tree->key_sz) 
+                                    + tree->data_sz);
+    if (!new_node) {
+        cm_errno = CM_ERR_MALLOC;
+        return NULL;
+    }
+
+    new_node->key  = (cm_byte *) new_node + sizeof(cm_rbt_node);
+    new_node->data = (cm_byte *) new_node->key + RBT_KEY_PAD(tree->key_sz);
+    new_node->parent_bits = 0;
+
+#else
     //allocate node structure
     cm_rbt_node * new_node = malloc(sizeof(cm_rbt_node));
     if (!new_node) {
@@ -95,6 +340,7 @@ cm_rbt_node * _rbt_new_node(const cm_rbt * tree,
         cm_errno = CM_ERR_MALLOC;
         return NULL;
     }
+#endif
 
     //copy the key into the node
     memcpy(new_node->key, key, tree->key_sz);
@@ -103,12 +349,12 @@ cm_rbt_node * _rbt_new_node(const cm_rbt * tree,
     memcpy(new_node->data, data, tree->data_sz);
 
     //null out pointers
-    new_node->parent = NULL;
+    _rbt_set_parent(new_node, NULL);
     new_node->left   = NULL;
     new_node->right  = NULL;
 
     //set colour to red
-    new_node->colour = CM_RBT_RED;
+    _rbt_set_colour(new_node, CM_RBT_RED);
 
     return new_node;
 }
@@ -116,10 +362,12 @@ cm_rbt_node * _rbt_new_node(const cm_rbt * tree,
 
 
 DBG_STATIC 
-void _rbt_del_node(cm_rbt_node * node) {
+void _rbt_free_node(void * node) {
 
-    free(node->key);
-    free(node->data);
+#ifndef CM_RBT_COMPACT
+    free(((cm_rbt_node *) node)->key);
+    free(((cm_rbt_node *) node)->data);
+#endif
     free(node);
 
     return;
@@ -127,11 +375,27 @@ void _rbt_del_node(cm_rbt_node * node) {
 
 
 
+//readers of the tree may delay the free through its hook
+DBG_STATIC 
+void _rbt_del_node(const cm_rbt * tree, cm_rbt_node * node) {
+
+    if (tree != NULL && tree->del_hook != NULL) {
+        tree->del_hook->retire(tree->del_hook->ctx, node, _rbt_free_node);
+        return;
+    }
+
+    _rbt_free_node(node);
+
+    return;
+}
+
+
+
 DBG_STATIC DBG_INLINE 
 void _rbt_set_root(cm_rbt * tree, cm_rbt_node * node) {
 
-    node->colour      = CM_RBT_BLACK;
-    node->parent_side = CM_RBT_ROOT;    
+    _rbt_set_colour(node, CM_RBT_BLACK);
+    _rbt_set_side(node, CM_RBT_ROOT);
     tree->root = node;
 
     return;
@@ -143,24 +407,24 @@ DBG_STATIC
 void _rbt_left_rotate(cm_rbt * tree, cm_rbt_node * node) {
 
     cm_rbt_node * right_child    = node->right;
-    cm_rbt_node * parent         = node->parent;
-    enum cm_rbt_side parent_side = node->parent_side;
+    cm_rbt_node * parent         = _rbt_get_parent(node);
+    enum cm_rbt_side parent_side = _rbt_get_side(node);
 
     //rotate node
     node->right       = node->right->left;
-    node->parent      = right_child;
-    node->parent_side = CM_RBT_LESS;
+    _rbt_set_parent(node, right_child);
+    _rbt_set_side(node, CM_RBT_LESS);
 
     //rotate node's former right child
     right_child->left        = node;
-    right_child->parent      = parent;
-    right_child->parent_side = parent_side;
+    _rbt_set_parent(right_child, parent);
+    _rbt_set_side(right_child, parent_side);
 
     //rotate former right child's left child
     if (node->right != NULL) {
-        node->right->parent = node;
-        node->right->parent_side 
-            = node->right->parent_side == CM_RBT_MORE ? CM_RBT_LESS : CM_RBT_MORE;
+        _rbt_set_parent(node->right, node);
+        _rbt_set_side(node->right, _rbt_get_side(node->right) == CM_RBT_MORE 
+                                   ? CM_RBT_LESS : CM_RBT_MORE);
     }
 
     //update parent
@@ -181,24 +445,24 @@ DBG_STATIC
 void _rbt_right_rotate(cm_rbt * tree, cm_rbt_node * node) {
 
     cm_rbt_node * left_child     = node->left;
-    cm_rbt_node * parent         = node->parent;
-    enum cm_rbt_side parent_side = node->parent_side;
+    cm_rbt_node * parent         = _rbt_get_parent(node);
+    enum cm_rbt_side parent_side = _rbt_get_side(node);
 
     //rotate node
     node->left        = node->left->right;
-    node->parent      = left_child;
-    node->parent_side = CM_RBT_MORE;
+    _rbt_set_parent(node, left_child);
+    _rbt_set_side(node, CM_RBT_MORE);
 
     //rotate node's former right child
     left_child->right       = node;
-    left_child->parent      = parent;
-    left_child->parent_side = parent_side;
+    _rbt_set_parent(left_child, parent);
+    _rbt_set_side(left_child, parent_side);
 
     //rotate former right child's left child
     if (node->left != NULL) {
-        node->left->parent = node;
-        node->left->parent_side 
-            = node->left->parent_side == CM_RBT_MORE ? CM_RBT_LESS : CM_RBT_MORE;
+        _rbt_set_parent(node->left, node);
+        _rbt_set_side(node->left, _rbt_get_side(node->left) == CM_RBT_MORE 
+                                  ? CM_RBT_LESS : CM_RBT_MORE);
     }
 
     //update parent
@@ -227,30 +491,33 @@ void _rbt_transplant(cm_rbt * tree,
     //target nodes and set target node as root
     if (tree->root == subj_node) {
 
+        /*
+         *  The caller re-attaches the subject's other branch if the target 
+         *  is not the subject's only child.
+         */
+
         //set root
         tree->root            = tgt_node;
-        tgt_node->parent      = NULL;
+        _rbt_set_parent(tgt_node, NULL);
         _rbt_set_root(tree, tgt_node);
-
-        //re-attach right branch
-        tgt_node->right         = subj_node->right;
-        tgt_node->right->parent = tgt_node;
    
     } else {
 
         //update subject node's parent
-        if (subj_node->parent_side == CM_RBT_MORE) subj_node->parent->right = tgt_node;
-        if (subj_node->parent_side == CM_RBT_LESS) subj_node->parent->left  = tgt_node;
+        if (_rbt_get_side(subj_node) == CM_RBT_MORE) 
+            _rbt_get_parent(subj_node)->right = tgt_node;
+        if (_rbt_get_side(subj_node) == CM_RBT_LESS) 
+            _rbt_get_parent(subj_node)->left  = tgt_node;
 
         //if target node is not NULL
         if (tgt_node != NULL) {
 
             //update target node
-            tgt_node->parent      = subj_node->parent;
-            tgt_node->parent_side = subj_node->parent_side;
+            _rbt_set_parent(tgt_node, _rbt_get_parent(subj_node));
+            _rbt_set_side(tgt_node, _rbt_get_side(subj_node));
         
             //set target node to the colour of subject node
-            tgt_node->colour = subj_node->colour;
+            _rbt_set_colour(tgt_node, _rbt_get_colour(subj_node));
         }
 
         
@@ -279,15 +546,6 @@ cm_rbt_node * _rbt_left_max(cm_rbt_node * node) {
 
 
 
-DBG_STATIC DBG_INLINE 
-enum cm_rbt_colour _rbt_get_colour(const cm_rbt_node * node) {
-
-    if (node == NULL) return CM_RBT_BLACK;
-    return node->colour == CM_RBT_BLACK ? CM_RBT_BLACK : CM_RBT_RED;
-}
-
-
-
 DBG_STATIC DBG_INLINE 
 void _rbt_populate_fix_data(const cm_rbt_node * node,
                             struct _rbt_fix_data * f_data) {
@@ -295,22 +553,22 @@ void _rbt_populate_fix_data(const cm_rbt_node * node,
     memset(f_data, 0, sizeof(*f_data));
     
     //if unable to get parent, then unable to get everything
-    if (node->parent == NULL) return;
+    if (_rbt_get_parent(node) == NULL) return;
     
     //get parent & grandparent
-    f_data->parent = node->parent;
-    f_data->grandparent = f_data->parent->parent;
+    f_data->parent = _rbt_get_parent(node);
+    f_data->grandparent = _rbt_get_parent(f_data->parent);
 
     //get uncle
-    if (f_data->parent->parent_side == CM_RBT_LESS)
+    if (_rbt_get_side(f_data->parent) == CM_RBT_LESS)
         f_data->uncle = f_data->grandparent->right;
-    if (f_data->parent->parent_side == CM_RBT_MORE)
+    if (_rbt_get_side(f_data->parent) == CM_RBT_MORE)
         f_data->uncle = f_data->grandparent->left;
 
     //get sibling
-    if (node->parent_side == CM_RBT_LESS)
+    if (_rbt_get_side(node) == CM_RBT_LESS)
         f_data->sibling = f_data->parent->right;
-    if (node->parent_side == CM_RBT_MORE)
+    if (_rbt_get_side(node) == CM_RBT_MORE)
         f_data->sibling = f_data->parent->left;
 
     return;
@@ -329,9 +587,10 @@ void _rbt_ins_case_1(cm_rbt * tree,
                      cm_rbt_node ** node, struct _rbt_fix_data * f_data) {
 
     //swap colours per red uncle case
-    f_data->parent->colour = CM_RBT_BLACK;
-    f_data->uncle->colour  = CM_RBT_BLACK;
-    if (tree->root != f_data->grandparent) f_data->grandparent->colour = CM_RBT_RED;
+    _rbt_set_colour(f_data->parent, CM_RBT_BLACK);
+    _rbt_set_colour(f_data->uncle, CM_RBT_BLACK);
+    if (tree->root != f_data->grandparent) 
+        _rbt_set_colour(f_data->grandparent, CM_RBT_RED);
 
     //advance node to grandparent
     *node = f_data->grandparent;
@@ -350,7 +609,7 @@ DBG_STATIC DBG_INLINE
 void _rbt_ins_case_2(cm_rbt * tree, 
                      cm_rbt_node ** node, struct _rbt_fix_data * f_data) {
 
-    f_data->parent->colour = CM_RBT_BLACK;
+    _rbt_set_colour(f_data->parent, CM_RBT_BLACK);
 
     return;
 }
@@ -370,7 +629,7 @@ void _rbt_ins_case_3(cm_rbt * tree,
                      cm_rbt_node ** node, struct _rbt_fix_data * f_data) {
     
     //node is left child
-    if ((*node)->parent_side == CM_RBT_LESS) {
+    if (_rbt_get_side(*node) == CM_RBT_LESS) {
         _rbt_right_rotate(tree, f_data->parent);
         *node = (*node)->right;
     
@@ -397,7 +656,7 @@ void _rbt_ins_case_4(cm_rbt * tree,
                      cm_rbt_node ** node, struct _rbt_fix_data * f_data) {
 
     //node is left child
-    if ((*node)->parent_side == CM_RBT_LESS) {
+    if (_rbt_get_side(*node) == CM_RBT_LESS) {
         _rbt_right_rotate(tree, f_data->grandparent);
     
     } else {
@@ -405,8 +664,8 @@ void _rbt_ins_case_4(cm_rbt * tree,
     }
 
     //recolour parent and grandparent
-    f_data->grandparent->colour = CM_RBT_RED;
-    f_data->parent->colour      = CM_RBT_BLACK;
+    _rbt_set_colour(f_data->grandparent, CM_RBT_RED);
+    _rbt_set_colour(f_data->parent, CM_RBT_BLACK);
 
     return;
 }
@@ -426,14 +685,14 @@ void _rbt_rmv_case_1(cm_rbt * tree,
                      cm_rbt_node ** node, struct _rbt_fix_data * f_data) {
 
     //get side of sibling
-    enum cm_rbt_side sibling_side = f_data->sibling->parent_side;
+    enum cm_rbt_side sibling_side = _rbt_get_side(f_data->sibling);
 
     //recolour sibling and parent
-    f_data->sibling->colour = CM_RBT_BLACK;
-    f_data->parent->colour  = CM_RBT_RED;
+    _rbt_set_colour(f_data->sibling, CM_RBT_BLACK);
+    _rbt_set_colour(f_data->parent, CM_RBT_RED);
 
     //rotate parent to make sibling the new grandparent 
-    if (f_data->sibling->parent_side == CM_RBT_LESS) {
+    if (_rbt_get_side(f_data->sibling) == CM_RBT_LESS) {
         _rbt_right_rotate(tree, f_data->parent);
     
     } else {
@@ -441,7 +700,7 @@ void _rbt_rmv_case_1(cm_rbt * tree,
     }
 
     //update fix data
-    f_data->grandparent = f_data->parent->parent;
+    f_data->grandparent = _rbt_get_parent(f_data->parent);
     if (sibling_side == CM_RBT_MORE) {
         f_data->sibling = f_data->parent->right;
     } else {
@@ -463,15 +722,15 @@ DBG_STATIC DBG_INLINE
 void _rbt_rmv_case_2(cm_rbt * tree, 
                      cm_rbt_node ** node, struct _rbt_fix_data * f_data) {
 
-    f_data->sibling->colour = CM_RBT_RED;
+    _rbt_set_colour(f_data->sibling, CM_RBT_RED);
     
-    if (f_data->parent->colour == CM_RBT_RED) {
+    if (_rbt_get_colour(f_data->parent) == CM_RBT_RED) {
 
         //apply fix
         *node = tree->root;
 
         //update fix data        
-        f_data->parent->colour = CM_RBT_BLACK;
+        _rbt_set_colour(f_data->parent, CM_RBT_BLACK);
     
     } else {
 
@@ -499,11 +758,11 @@ void _rbt_rmv_case_3(cm_rbt * tree,
                      cm_rbt_node ** node, struct _rbt_fix_data * f_data) {
 
     //colour close nephew black, set sibling's colour to CM_RBT_RED, rotate 
-    if (f_data->sibling->parent_side == CM_RBT_LESS) {    
+    if (_rbt_get_side(f_data->sibling) == CM_RBT_LESS) {    
 
         //perform fix
-        f_data->sibling->right->colour = CM_RBT_BLACK;
-        f_data->sibling->colour       = CM_RBT_RED;
+        _rbt_set_colour(f_data->sibling->right, CM_RBT_BLACK);
+        _rbt_set_colour(f_data->sibling, CM_RBT_RED);
         _rbt_left_rotate(tree, f_data->sibling);
 
         //update fix data
@@ -512,8 +771,8 @@ void _rbt_rmv_case_3(cm_rbt * tree,
     } else {
 
         //perform fix
-        f_data->sibling->left->colour = CM_RBT_BLACK; 
-        f_data->sibling->colour       = CM_RBT_RED;
+        _rbt_set_colour(f_data->sibling->left, CM_RBT_BLACK);
+        _rbt_set_colour(f_data->sibling, CM_RBT_RED);
         _rbt_right_rotate(tree, f_data->sibling);
     
         //update fix data
@@ -538,18 +797,18 @@ void _rbt_rmv_case_4(cm_rbt * tree,
                      cm_rbt_node ** node, struct _rbt_fix_data * f_data) {
 
     //recolour nodes
-    f_data->sibling->colour        = f_data->parent->colour;
-    f_data->parent->colour         = CM_RBT_BLACK;
+    _rbt_set_colour(f_data->sibling, _rbt_get_colour(f_data->parent));
+    _rbt_set_colour(f_data->parent, CM_RBT_BLACK);
 
     //colour far nephew black, rotate
-    if (f_data->sibling->parent_side == CM_RBT_LESS) {
+    if (_rbt_get_side(f_data->sibling) == CM_RBT_LESS) {
         
-        f_data->sibling->left->colour = CM_RBT_BLACK;
+        _rbt_set_colour(f_data->sibling->left, CM_RBT_BLACK);
         _rbt_right_rotate(tree, f_data->parent);
     
     } else {
         
-        f_data->sibling->right->colour = CM_RBT_BLACK;
+        _rbt_set_colour(f_data->sibling->right, CM_RBT_BLACK);
         _rbt_left_rotate(tree, f_data->parent);
     }
 
@@ -569,7 +828,7 @@ int _rbt_determine_ins_case(const cm_rbt_node * node,
 
 
     //if node is root and is red, no fix necessary
-    if (node->parent_side == CM_RBT_ROOT) return 0;
+    if (_rbt_get_side(node) == CM_RBT_ROOT) return 0;
 
     //determine if parent is black
     parent_black = _rbt_get_colour(f_data->parent) == CM_RBT_BLACK ? true : false;
@@ -582,19 +841,19 @@ int _rbt_determine_ins_case(const cm_rbt_node * node,
 
     //if uncle is red, case 1
     if (!uncle_black)
-        if (f_data->uncle->colour == CM_RBT_RED) return 1;
+        if (_rbt_get_colour(f_data->uncle) == CM_RBT_RED) return 1;
 
     //if parent is root, case 2
-    if (f_data->parent->parent_side == CM_RBT_ROOT) return 2;
+    if (_rbt_get_side(f_data->parent) == CM_RBT_ROOT) return 2;
 
     //determine 'triangle' or 'line' case
     if (uncle_black) {
 
         //if red nodes form a 'triange', case 3
-        if (node->parent_side != f_data->parent->parent_side) return 3;
+        if (_rbt_get_side(node) != _rbt_get_side(f_data->parent)) return 3;
 
         //if red nodes form a 'line', case 4
-        if (node->parent_side == f_data->parent->parent_side) return 4;
+        if (_rbt_get_side(node) == _rbt_get_side(f_data->parent)) return 4;
 
     }
 
@@ -631,9 +890,9 @@ int _rbt_determine_rmv_case(const cm_rbt * tree, const cm_rbt_node * node,
     if ((left_colour == CM_RBT_BLACK) && (right_colour == CM_RBT_BLACK)) return 2;
 
     //case 3 and 4 work with 'close' and 'distant' nephews
-    close_colour = f_data->sibling->parent_side == CM_RBT_LESS 
+    close_colour = _rbt_get_side(f_data->sibling) == CM_RBT_LESS 
                    ? right_colour : left_colour;
-    distant_colour = f_data->sibling->parent_side == CM_RBT_LESS 
+    distant_colour = _rbt_get_side(f_data->sibling) == CM_RBT_LESS 
                      ? left_colour : right_colour;
 
     //if sibling's left child is red and right child is black, case 3
@@ -649,6 +908,11 @@ int _rbt_determine_rmv_case(const cm_rbt * tree, const cm_rbt_node * node,
 
 
 
+/*
+ *  Returns 1 if the fix recoloured the children of the root, growing the
+ *  black height of the tree.
+ */
+
 DBG_STATIC 
 int _rbt_fix_ins(cm_rbt * tree, cm_rbt_node * node) {
 
@@ -674,11 +938,12 @@ int _rbt_fix_ins(cm_rbt * tree, cm_rbt_node * node) {
 
             case 1:
                 _rbt_ins_case_1(tree, &node, &f_data);
+                if (node == tree->root) return 1;
                 break;
             
             case 2:
                 _rbt_ins_case_2(tree, &node, &f_data);
-                return 0;
+                return 1;
 
             case 3:
                 _rbt_ins_case_3(tree, &node, &f_data);
@@ -748,7 +1013,7 @@ cm_rbt_node * _rbt_add_node(cm_rbt * tree, const void * key,
 
     //create new node
     cm_rbt_node * node = _rbt_new_node(tree, key, data);
-    if (is_raw == true) node->colour = colour;
+    if (is_raw == true) _rbt_set_colour(node, colour);
 
     //if tree is empty, set root
     if (tree->size == 0) {
@@ -756,12 +1021,12 @@ cm_rbt_node * _rbt_add_node(cm_rbt * tree, const void * key,
 
     //else connect node
     } else {
-        node->parent = parent;
+        _rbt_set_parent(node, parent);
         if (side == CM_RBT_LESS) {
-            node->parent_side = CM_RBT_LESS;
+            _rbt_set_side(node, CM_RBT_LESS);
             parent->left = node;
         } else {
-            node->parent_side = CM_RBT_MORE;
+            _rbt_set_side(node, CM_RBT_MORE);
             parent->right = node;
         }
     }
@@ -813,17 +1078,17 @@ cm_rbt_node * _rbt_uln_node(cm_rbt * tree, const void * key) {
         fix_node = max_node->left;
 
         
-        if (max_node->colour == CM_RBT_BLACK && 
+        if (_rbt_get_colour(max_node) == CM_RBT_BLACK && 
             _rbt_get_colour(fix_node) == CM_RBT_RED) {
 
             //can replace min node with its child and 
             //colour it black, no fix necessary
-            fix_node->colour = CM_RBT_BLACK;
+            _rbt_set_colour(fix_node, CM_RBT_BLACK);
 
         } else {
 
             //save state prior to removal for use during fixing
-            unlink_colour = max_node->colour;
+            unlink_colour = _rbt_get_colour(max_node);
             if (unlink_colour == CM_RBT_BLACK) 
                 _rbt_populate_fix_data(max_node, &f_data);
         }
@@ -833,14 +1098,15 @@ cm_rbt_node * _rbt_uln_node(cm_rbt * tree, const void * key) {
         
         //re-attach maximum node as root of left subtree
         max_node->left = node->left;
-        if (max_node->left != NULL) max_node->left->parent = max_node;
+        if (max_node->left != NULL) _rbt_set_parent(max_node->left, max_node);
 
         //set minimum node as new root of whole tree
         _rbt_transplant(tree, node, max_node);
 
         //re-attach maxumum node as root of right subtree
         max_node->right = node->right;
-        if (max_node->right != NULL) max_node->right->parent = max_node;  
+        if (max_node->right != NULL) 
+            _rbt_set_parent(max_node->right, max_node);
 
         //update fix data if transplant caused parent to change
         if (f_data.parent == node) f_data.parent = max_node;
@@ -852,7 +1118,7 @@ cm_rbt_node * _rbt_uln_node(cm_rbt * tree, const void * key) {
         _rbt_transplant(tree, node, node->left);
         
         //convert node to CM_RBT_BLACK, this is guaranteed to maintain balance
-        node->left->colour = CM_RBT_BLACK;
+        _rbt_set_colour(node->left, CM_RBT_BLACK);
 
     //only a right child
     } else if (node->left == NULL && node->right != NULL) {
@@ -861,7 +1127,7 @@ cm_rbt_node * _rbt_uln_node(cm_rbt * tree, const void * key) {
         _rbt_transplant(tree, node, node->right);
         
         //convert node to CM_RBT_BLACK, this is guaranteed to maintain balance
-        node->right->colour = CM_RBT_BLACK;
+        _rbt_set_colour(node->right, CM_RBT_BLACK);
     
     //no children present
     } else {
@@ -869,11 +1135,11 @@ cm_rbt_node * _rbt_uln_node(cm_rbt * tree, const void * key) {
         fix_node = NULL;
 
         //save state prior to removal for use during fixing
-        unlink_colour = node->colour;
+        unlink_colour = _rbt_get_colour(node);
         if (unlink_colour == CM_RBT_BLACK) 
             _rbt_populate_fix_data(node, &f_data);
 
-        if (node->parent_side == CM_RBT_ROOT) {
+        if (_rbt_get_side(node) == CM_RBT_ROOT) {
 
             //set tree root to NULL
             tree->root = NULL;
@@ -881,10 +1147,10 @@ cm_rbt_node * _rbt_uln_node(cm_rbt * tree, const void * key) {
         } else {
 
             //remove node from parent
-            if (node->parent_side == CM_RBT_LESS) {
-                node->parent->left = NULL;
+            if (_rbt_get_side(node) == CM_RBT_LESS) {
+                _rbt_get_parent(node)->left = NULL;
             } else {
-                node->parent->right = NULL;
+                _rbt_get_parent(node)->right = NULL;
             }
         }
     }
@@ -903,12 +1169,12 @@ cm_rbt_node * _rbt_uln_node(cm_rbt * tree, const void * key) {
 
 
 DBG_STATIC 
-void _rbt_emp_recurse(cm_rbt_node * node) {
+void _rbt_emp_recurse(const cm_rbt * tree, cm_rbt_node * node) {
 
     if (node == NULL) return;
-    if (node->left != NULL) _rbt_emp_recurse(node->left);
-    if (node->right != NULL) _rbt_emp_recurse(node->right);
-    _rbt_del_node(node);
+    if (node->left != NULL) _rbt_emp_recurse(tree, node->left);
+    if (node->right != NULL) _rbt_emp_recurse(tree, node->right);
+    _rbt_del_node(tree, node);
 
     return;
 }
@@ -925,8 +1191,8 @@ int _rbt_cpy_recurse(cm_rbt * dst_tree, cm_rbt_node * dst_parent_node,
 
     //create this node in the destination tree
     node = _rbt_add_node(dst_tree, src_node->key, src_node->data,
-                         dst_parent_node, src_node->parent_side,
-                         true, src_node->colour);
+                         dst_parent_node, _rbt_get_side(src_node),
+                         true, _rbt_get_colour(src_node));
     if (node == NULL) {
         cm_del_rbt(dst_tree);
         return -1;
@@ -984,6 +1250,413 @@ int _rbt_callback_recurse(cm_rbt_node * node,
 
 
 
+//leftmost node of a subtree
+DBG_STATIC DBG_INLINE
+cm_rbt_node * _rbt_first(cm_rbt_node * node) {
+
+    if (node == NULL) return NULL;
+    while (node->left != NULL) node = node->left;
+
+    return node;
+}
+
+
+
+//in-order successor, climbing through parents instead of recursing
+DBG_STATIC DBG_INLINE
+cm_rbt_node * _rbt_next(cm_rbt_node * node) {
+
+    if (node->right != NULL) return _rbt_first(node->right);
+
+    //climb until arriving from a left child, or past the root
+    while (_rbt_get_side(node) == CM_RBT_MORE) node = _rbt_get_parent(node);
+
+    return _rbt_get_side(node) == CM_RBT_ROOT ? NULL : _rbt_get_parent(node);
+}
+
+
+
+//number of black nodes on any path from the node down to a leaf
+DBG_STATIC DBG_INLINE
+int _rbt_black_height(const cm_rbt_node * node) {
+
+    int height = 0;
+
+
+    for ( ; node != NULL; node = node->left) {
+        if (_rbt_get_colour(node) == CM_RBT_BLACK) ++height;
+    }
+
+    return height;
+}
+
+
+
+//make a subtree a standalone tree with a black root
+DBG_STATIC DBG_INLINE
+cm_rbt_node * _rbt_detach(cm_rbt_node * node, int * height) {
+
+    if (node == NULL) return NULL;
+
+    _rbt_set_parent(node, NULL);
+    _rbt_set_side(node, CM_RBT_ROOT);
+    if (_rbt_get_colour(node) == CM_RBT_RED) {
+        _rbt_set_colour(node, CM_RBT_BLACK);
+        ++*height;
+    }
+
+    return node;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+void _rbt_link(cm_rbt_node * parent, cm_rbt_node * child, 
+               const enum cm_rbt_side side) {
+
+    if (side == CM_RBT_LESS) parent->left = child;
+    if (side == CM_RBT_MORE) parent->right = child;
+    if (child == NULL) return;
+
+    _rbt_set_parent(child, parent);
+    _rbt_set_side(child, side);
+
+    return;
+}
+
+
+
+/*
+ *  Join two standalone trees around `mid`, whose key lies between them.
+ *  The shorter tree is hung off the spine of the taller one at a black 
+ *  node of the same black height, & `mid` is fixed up as a fresh insert.
+ *  Costs O(difference in black height). Returns the new root.
+ */
+
+DBG_STATIC
+cm_rbt_node * _rbt_join_sub(cm_rbt_node * left, const int left_height,
+                            cm_rbt_node * mid, 
+                            cm_rbt_node * right, const int right_height,
+                            int * height) {
+
+    int ret, cur_height;
+    enum cm_rbt_side side;
+    cm_rbt_node * node, * parent;
+    cm_rbt tmp;
+
+
+    mid->left  = NULL;
+    mid->right = NULL;
+
+    //equal heights: `mid` becomes the black root
+    if (left_height == right_height) {
+
+        _rbt_link(mid, left, CM_RBT_LESS);
+        _rbt_link(mid, right, CM_RBT_MORE);
+        _rbt_set_parent(mid, NULL);
+        _rbt_set_side(mid, CM_RBT_ROOT);
+        _rbt_set_colour(mid, CM_RBT_BLACK);
+
+        *height = left_height + 1;
+        return mid;
+    }
+
+    //descend the inner spine of the taller tree
+    if (left_height > right_height) {
+        side       = CM_RBT_MORE;
+        node       = left;
+        cur_height = left_height;
+    } else {
+        side       = CM_RBT_LESS;
+        node       = right;
+        cur_height = right_height;
+    }
+    tmp.root = node;
+    parent   = NULL;
+
+    while (node != NULL && (_rbt_get_colour(node) == CM_RBT_RED 
+           || cur_height != (side == CM_RBT_MORE ? right_height 
+                                                 : left_height))) {
+
+        if (_rbt_get_colour(node) == CM_RBT_BLACK) --cur_height;
+        parent = node;
+        node = side == CM_RBT_MORE ? node->right : node->left;
+    }
+
+    //hang the shorter tree & the displaced subtree under a red `mid`
+    _rbt_set_colour(mid, CM_RBT_RED);
+    if (side == CM_RBT_MORE) {
+        _rbt_link(mid, node, CM_RBT_LESS);
+        _rbt_link(mid, right, CM_RBT_MORE);
+    } else {
+        _rbt_link(mid, left, CM_RBT_LESS);
+        _rbt_link(mid, node, CM_RBT_MORE);
+    }
+    _rbt_link(parent, mid, side);
+
+    ret = _rbt_fix_ins(&tmp, mid);
+    *height = (side == CM_RBT_MORE ? left_height : right_height)
+              + (ret == 1 ? 1 : 0);
+
+    return tmp.root;
+}
+
+
+
+/*
+ *  Split a standalone tree into keys less than `key` & the rest, joining
+ *  the pieces cut off on the way down. Costs O(log n) overall since each
+ *  join costs the difference in black height of its pieces.
+ */
+
+DBG_STATIC
+void _rbt_split_sub(const cm_rbt * tree, cm_rbt_node * node, 
+                    const int node_height, const void * key,
+                    cm_rbt_node ** left, int * left_height,
+                    cm_rbt_node ** right, int * right_height) {
+
+    int child_height, less_height, more_height, sub_height;
+    enum cm_rbt_side side;
+    cm_rbt_node * less, * more, * sub;
+
+
+    if (node == NULL) {
+        *left  = *right = NULL;
+        *left_height = *right_height = 0;
+        return;
+    }
+
+    child_height = node_height 
+                   - (_rbt_get_colour(node) == CM_RBT_BLACK ? 1 : 0);
+    less_height  = more_height = child_height;
+    less = _rbt_detach(node->left, &less_height);
+    more = _rbt_detach(node->right, &more_height);
+
+    side = _rbt_compare(tree, key, node->key);
+
+    if (side == CM_RBT_MORE) {
+        _rbt_split_sub(tree, more, more_height, key,
+                       &sub, &sub_height, right, right_height);
+        *left = _rbt_join_sub(less, less_height, node, 
+                              sub, sub_height, left_height);
+
+    } else if (side == CM_RBT_LESS) {
+        _rbt_split_sub(tree, less, less_height, key,
+                       left, left_height, &sub, &sub_height);
+        *right = _rbt_join_sub(sub, sub_height, node, 
+                               more, more_height, right_height);
+
+    } else {
+        *left        = less;
+        *left_height = less_height;
+        *right = _rbt_join_sub(NULL, 0, node, 
+                               more, more_height, right_height);
+    }
+
+    return;
+}
+
+
+
+//count the smaller of two trees in O(its size)
+DBG_STATIC
+int _rbt_count_min(const cm_rbt_node * left, const cm_rbt_node * right,
+                   bool * is_left) {
+
+    int count = 0;
+    cm_rbt_node * l, * r;
+
+
+    l = _rbt_first((cm_rbt_node *) left);
+    r = _rbt_first((cm_rbt_node *) right);
+
+    while (l != NULL && r != NULL) {
+        l = _rbt_next(l);
+        r = _rbt_next(r);
+        ++count;
+    }
+    *is_left = l == NULL;
+
+    return count;
+}
+
+
+
+/*
+ *  Build a balanced subtree from nodes sorted by key. Subtree sizes differ
+ *  by at most one, so every leaf sits at one of the two deepest levels; 
+ *  colouring the deepest level red keeps the black height equal.
+ */
+
+DBG_STATIC
+cm_rbt_node * _rbt_build(cm_rbt_node ** nodes, const int len, 
+                         const int depth, const int red_depth) {
+
+    int mid;
+    cm_rbt_node * node, * child;
+
+
+    if (len == 0) return NULL;
+
+    mid  = len / 2;
+    node = nodes[mid];
+    _rbt_set_colour(node, depth == red_depth ? CM_RBT_RED : CM_RBT_BLACK);
+    _rbt_set_parent(node, NULL);
+
+    child = _rbt_build(nodes, mid, depth + 1, red_depth);
+    _rbt_link(node, child, CM_RBT_LESS);
+    child = _rbt_build(nodes + mid + 1, len - mid - 1, depth + 1, red_depth);
+    _rbt_link(node, child, CM_RBT_MORE);
+
+    return node;
+}
+
+
+
+/*
+ *  Merge `other` into `tree` in one in-order pass, then rebuild `tree`
+ *  from the surviving nodes. The nodes of `tree` are laid out at the end
+ *  of the buffer so the merged sequence, written from the start, never
+ *  overtakes them. Only a union takes nodes from `other`.
+ */
+
+DBG_STATIC
+int _rbt_merge(cm_rbt * tree, cm_rbt * other, const enum _rbt_set_op op) {
+
+    int off, len, red_depth;
+    enum cm_rbt_side side;
+    cm_rbt_node ** nodes, ** cur, * node;
+
+
+    if (tree->key_sz != other->key_sz || tree->data_sz != other->data_sz
+        || tree->compare != other->compare
+        || tree->key_kind != other->key_kind) {
+        cm_errno = CM_ERR_USER_ARG;
+        return -1;
+    }
+
+    //a tree merged with itself is left as is, or emptied by a difference
+    if (tree == other) {
+        if (op == RBT_SET_DIF) cm_rbt_emp(tree);
+        return 0;
+    }
+
+    off   = op == RBT_SET_UNI ? other->size : 0;
+    nodes = malloc(sizeof(*nodes) * (off + tree->size + 1));
+    if (nodes == NULL) {
+        cm_errno = CM_ERR_MALLOC;
+        return -1;
+    }
+
+    //lay out the tree's nodes in order
+    cur = nodes + off;
+    for (node = _rbt_first(tree->root); node != NULL; node = _rbt_next(node)) {
+        *cur++ = node;
+    }
+
+    len  = 0;
+    node = _rbt_first(other->root);
+    for (cur = nodes + off; cur < nodes + off + tree->size; ) {
+
+        side = node == NULL 
+               ? CM_RBT_LESS : _rbt_compare(tree, (*cur)->key, node->key);
+
+        //only in the tree
+        if (side == CM_RBT_LESS) {
+            if (op == RBT_SET_ISC) _rbt_del_node(tree, *cur);
+            else nodes[len++] = *cur;
+            ++cur;
+
+        //only in the other tree
+        } else if (side == CM_RBT_MORE) {
+            if (op == RBT_SET_UNI) nodes[len++] = node;
+            node = _rbt_next(node);
+
+        //in both, a union keeps the other tree's data
+        } else {
+            if (op == RBT_SET_ISC) {
+                nodes[len++] = *cur;
+            } else {
+                _rbt_del_node(tree, *cur);
+                if (op == RBT_SET_UNI) nodes[len++] = node;
+            }
+            ++cur;
+            node = _rbt_next(node);
+        }
+    }
+
+    if (op == RBT_SET_UNI) {
+        for ( ; node != NULL; node = _rbt_next(node)) nodes[len++] = node;
+        other->root = NULL;
+        other->size = 0;
+    }
+
+    //red nodes go on the deepest level
+    for (red_depth = 0; (2 << red_depth) <= len; ++red_depth);
+
+    tree->root = NULL;
+    tree->size = len;
+    if (len != 0) _rbt_set_root(tree, _rbt_build(nodes, len, 0, red_depth));
+
+    free(nodes);
+
+    return 0;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+const void * _rbt_bat_key(const cm_rbt * tree, const void * keys, 
+                          const int idx) {
+
+    return (const char *) keys + (size_t) idx * tree->key_sz;
+}
+
+
+
+/*
+ *  Stable bottom-up merge sort of indices into `keys`. Runs that are 
+ *  already in order are left alone, so sorted input costs O(n) 
+ *  comparisons.
+ */
+
+DBG_STATIC
+void _rbt_sort_idx(const cm_rbt * tree, const void * keys, 
+                   int * idx, int * tmp, const int len) {
+
+    int mid, hi, l, r, out;
+
+
+    for (int width = 1; width < len; width *= 2) {
+        for (int lo = 0; lo < len - width; lo += 2 * width) {
+
+            mid = lo + width;
+            hi  = mid + width < len ? mid + width : len;
+
+            if (_rbt_compare(tree, _rbt_bat_key(tree, keys, idx[mid - 1]),
+                                   _rbt_bat_key(tree, keys, idx[mid]))
+                != CM_RBT_MORE) continue;
+
+            //equal keys keep their order
+            l = lo, r = mid, out = lo;
+            while (l < mid && r < hi) {
+                if (_rbt_compare(tree, _rbt_bat_key(tree, keys, idx[l]),
+                                       _rbt_bat_key(tree, keys, idx[r]))
+                    != CM_RBT_MORE) tmp[out++] = idx[l++];
+                else tmp[out++] = idx[r++];
+            }
+            while (l < mid) tmp[out++] = idx[l++];
+            while (r < hi) tmp[out++] = idx[r++];
+
+            memcpy(idx + lo, tmp + lo, sizeof(*idx) * (hi - lo));
+        }
+    }
+
+    return;
+}
+
+
+
 DBG_STATIC
 cm_rbt_node * _rbt_idx_recurse(const cm_rbt * tree, cm_rbt_node * node,
                                int * cur_idx, int tgt_idx) {
@@ -1183,13 +1856,73 @@ cm_rbt_node * cm_rbt_set(cm_rbt * tree,
 
 
 
+cm_rbt_node * cm_rbt_set_h(cm_rbt * tree, cm_rbt_node * hint,
+                           const void * key, const void * data) {
+
+    enum cm_rbt_side side;
+
+    //get relevant node, starting from the hint
+    cm_rbt_node * node = _rbt_traverse_hint(tree, hint, key, &side);
+
+    //if a node already exists for this key, update its value
+    if (side == CM_RBT_EQUAL) {
+        memcpy(node->data, data, tree->data_sz);
+        return node;
+
+    //else create a new node
+    } else { 
+        return _rbt_add_node(tree, key, data, node, side, false, CM_RBT_RED);
+    }
+}
+
+
+
+int cm_rbt_set_bat(cm_rbt * tree, const void * keys, 
+                   const void * data, const int len) {
+
+    int * idx;
+    cm_rbt_node * node;
+
+
+    if (len <= 0) return 0;
+
+    //sort indices, leaving the caller's arrays as they are
+    idx = malloc(sizeof(*idx) * len * 2);
+    if (idx == NULL) {
+        cm_errno = CM_ERR_MALLOC;
+        return -1;
+    }
+
+    for (int i = 0; i < len; ++i) idx[i] = i;
+    _rbt_sort_idx(tree, keys, idx, idx + len, len);
+
+    //each insert starts from the last
+    node = NULL;
+    for (int i = 0; i < len; ++i) {
+
+        node = cm_rbt_set_h(tree, node, _rbt_bat_key(tree, keys, idx[i]),
+                            (const char *) data 
+                            + (size_t) idx[i] * tree->data_sz);
+        if (node == NULL) {
+            free(idx);
+            return -1;
+        }
+    }
+
+    free(idx);
+
+    return 0;
+}
+
+
+
 int cm_rbt_rmv(cm_rbt * tree, const void * key) {
 
     //get relevant node
     cm_rbt_node * node = _rbt_uln_node(tree, key);
     if (node == NULL) return -1;
 
-    _rbt_del_node(node);
+    _rbt_del_node(tree, node);
 
     return 0;
 }
@@ -1202,9 +1935,11 @@ cm_rbt_node * cm_rbt_uln(cm_rbt * tree, const void * key) {
 
     //get relevant node
     node = _rbt_uln_node(tree, key);
+    if (node == NULL) return NULL;
 
     //null out pointers
-    node->parent = node->left = node->right = NULL;
+    _rbt_set_parent(node, NULL);
+    node->left = node->right = NULL;
 
     return node;
 }
@@ -1213,7 +1948,7 @@ cm_rbt_node * cm_rbt_uln(cm_rbt * tree, const void * key) {
 
 void cm_rbt_emp(cm_rbt * tree) {
 
-    _rbt_emp_recurse(tree->root);
+    _rbt_emp_recurse(tree, tree->root);
     tree->root = NULL;
     tree->size = 0;
 
@@ -1230,6 +1965,7 @@ int cm_rbt_cpy(cm_rbt * dst_tree, const cm_rbt * src_tree) {
     //initialise the destination list
     cm_new_rbt(dst_tree, src_tree->key_sz,
                src_tree->data_sz, src_tree->compare);
+    dst_tree->key_kind = src_tree->key_kind;
 
     //do not recurse if there are no nodes in the source tree
     if (src_tree->size == 0) return 0;
@@ -1256,6 +1992,117 @@ void cm_rbt_mov(cm_rbt * dst_tree, cm_rbt * src_tree) {
 
 
 
+int cm_rbt_split(cm_rbt * tree, const void * key, 
+                 cm_rbt * left_tree, cm_rbt * right_tree) {
+
+    int total, count, height;
+    bool is_left;
+    cm_rbt_node * left, * right;
+
+
+    cm_new_rbt(left_tree, tree->key_sz, tree->data_sz, tree->compare);
+    cm_new_rbt(right_tree, tree->key_sz, tree->data_sz, tree->compare);
+    left_tree->del_hook  = tree->del_hook;
+    right_tree->del_hook = tree->del_hook;
+    left_tree->key_kind  = tree->key_kind;
+    right_tree->key_kind = tree->key_kind;
+
+    if (tree->size == 0) return 0;
+
+    _rbt_split_sub(tree, tree->root, _rbt_black_height(tree->root), key,
+                   &left, &height, &right, &height);
+    total      = tree->size;
+    tree->root = NULL;
+    tree->size = 0;
+
+    if (left != NULL) _rbt_set_root(left_tree, left);
+    if (right != NULL) _rbt_set_root(right_tree, right);
+
+    //nodes don't track subtree sizes
+    count = _rbt_count_min(left, right, &is_left);
+    left_tree->size  = is_left ? count : total - count;
+    right_tree->size = total - left_tree->size;
+
+    return 0;
+}
+
+
+
+int cm_rbt_join(cm_rbt * left_tree, cm_rbt * right_tree) {
+
+    int left_height, right_height, height;
+    cm_rbt_node * max, * min, * root;
+
+
+    if (left_tree->key_sz != right_tree->key_sz
+        || left_tree->data_sz != right_tree->data_sz
+        || left_tree->compare != right_tree->compare
+        || left_tree->key_kind != right_tree->key_kind) {
+        cm_errno = CM_ERR_USER_ARG;
+        return -1;
+    }
+    if (right_tree->size == 0) return 0;
+
+    //take over the right tree
+    if (left_tree->size == 0) {
+        left_tree->root  = right_tree->root;
+        left_tree->size  = right_tree->size;
+        right_tree->root = NULL;
+        right_tree->size = 0;
+        return 0;
+    }
+
+    //every key on the left must be smaller than every key on the right
+    for (max = left_tree->root; max->right != NULL; max = max->right);
+    min = _rbt_first(right_tree->root);
+    if (_rbt_compare(left_tree, max->key, min->key) != CM_RBT_LESS) {
+        cm_errno = CM_ERR_USER_ARG;
+        return -1;
+    }
+
+    //the right tree's minimum becomes the joining node
+    min = _rbt_uln_node(right_tree, min->key);
+    if (min == NULL) return -1;
+
+    left_height  = _rbt_black_height(left_tree->root);
+    right_height = _rbt_black_height(right_tree->root);
+    root = _rbt_join_sub(left_tree->root, left_height, min,
+                         right_tree->size == 0 ? NULL : right_tree->root,
+                         right_height, &height);
+
+    _rbt_set_root(left_tree, root);
+    left_tree->size += right_tree->size + 1;
+    right_tree->root = NULL;
+    right_tree->size = 0;
+
+    return 0;
+}
+
+
+
+int cm_rbt_uni(cm_rbt * tree, cm_rbt * other) {
+
+    return _rbt_merge(tree, other, RBT_SET_UNI);
+}
+
+
+
+int cm_rbt_isc(cm_rbt * tree, const cm_rbt * other) {
+
+    //other is only read
+    return _rbt_merge(tree, (cm_rbt *) other, RBT_SET_ISC);
+}
+
+
+
+int cm_rbt_dif(cm_rbt * tree, const cm_rbt * other) {
+
+    //other is only read
+    return _rbt_merge(tree, (cm_rbt *) other, RBT_SET_DIF);
+}
+
+
+
 int cm_rbt_iter(const cm_rbt * tree,
                 int (* callback)(const cm_rbt_node * node, void * ctx),
                 void * ctx) {
@@ -1265,6 +2112,44 @@ int cm_rbt_iter(const cm_rbt * tree,
 
 
 
+int cm_rbt_iter_bat(const cm_rbt * tree,
+                    int (* callback)(void * const * keys, void * const * data,
+                                     const int len, void * ctx),
+                    void * ctx) {
+
+    int ret, len;
+    void * keys[CM_ITER_BATCH];
+    void * data[CM_ITER_BATCH];
+    cm_rbt_node * node;
+
+
+    //for every batch of nodes, in order
+    node = _rbt_first(tree->root);
+    while (node != NULL) {
+
+        //gather the batch, prefetching keys & data for the callback
+        for (len = 0; len < CM_ITER_BATCH && node != NULL; ++len) {
+
+            keys[len] = node->key;
+            data[len] = node->data;
+            __builtin_prefetch(node->key);
+            __builtin_prefetch(node->data);
+            node = _rbt_next(node);
+        }
+
+        //process the batch
+        ret = callback(keys, data, len, ctx);
+        if (ret != 0) {
+            cm_errno = CM_ERR_CALLBACK;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+
 void cm_new_rbt(cm_rbt * tree, const size_t key_sz, const size_t data_sz, 
                 enum cm_rbt_side (*compare) (const void *, const void *)) {
 
@@ -1273,6 +2158,8 @@ void cm_new_rbt(cm_rbt * tree, const size_t key_sz, const size_t data_sz,
     tree->data_sz   = data_sz;
     tree->root      = NULL;
     tree->compare   = compare;
+    tree->key_kind  = CM_RBT_KEY_FN;
+    tree->del_hook  = NULL;
     tree->is_init   = true;
 
     return;
@@ -1280,9 +2167,41 @@ void cm_new_rbt(cm_rbt * tree, const size_t key_sz, const size_t data_sz,
 
 
 
+int cm_new_rbt_k(cm_rbt * tree, const enum cm_rbt_key key_kind,
+                 const size_t key_sz, const size_t data_sz) {
+
+    size_t kind_sz;
+
+
+    switch (key_kind) {
+
+        case CM_RBT_KEY_I32: kind_sz = sizeof(int32_t); break;
+        case CM_RBT_KEY_U32: kind_sz = sizeof(uint32_t); break;
+        case CM_RBT_KEY_I64: kind_sz = sizeof(int64_t); break;
+        case CM_RBT_KEY_U64: kind_sz = sizeof(uint64_t); break;
+        case CM_RBT_KEY_F64: kind_sz = sizeof(double); break;
+        case CM_RBT_KEY_MEM: kind_sz = key_sz; break;
+
+        //user comparisons go through cm_new_rbt()
+        default: kind_sz = 0; break;
+    }
+
+    if (kind_sz == 0 || kind_sz != key_sz) {
+        cm_errno = CM_ERR_USER_ARG;
+        return -1;
+    }
+
+    cm_new_rbt(tree, key_sz, data_sz, NULL);
+    tree->key_kind = key_kind;
+
+    return 0;
+}
+
+
+
 void cm_del_rbt(cm_rbt * tree) {
 
-    _rbt_emp_recurse(tree->root);
+    _rbt_emp_recurse(tree, tree->root);
     tree->root    = NULL;
     tree->size    = 0;
     tree->is_init = false;
@@ -1294,7 +2213,7 @@ void cm_del_rbt(cm_rbt * tree) {
 
 void cm_del_rbt_node(cm_rbt_node * node) {
 
-    _rbt_del_node(node);
+    _rbt_del_node(NULL, node);
 
     return;
 }
@@ -11,6 +11,10 @@
 
 // -- [red-black tree]
 
+//compact nodes keep the data after the key, aligned to a pointer
+#define RBT_KEY_PAD(key_sz) \
+    (((key_sz) + (sizeof(void *) - 1)) & ~(sizeof(void *) - 1))
+
 //stores pointers to nodes relevant for correction operations
 struct _rbt_fix_data {
 
@@ -21,14 +25,53 @@ struct _rbt_fix_data {
 };
 
 
+//set operations performed by _rbt_merge()
+enum _rbt_set_op {
+
+    RBT_SET_UNI,
+    RBT_SET_ISC,
+    RBT_SET_DIF
+};
+
+
 #ifdef CM_DEBUG
 //internal
+cm_rbt_node * _rbt_get_parent(const cm_rbt_node * node);
+enum cm_rbt_side _rbt_get_side(const cm_rbt_node * node);
+enum cm_rbt_colour _rbt_get_colour(const cm_rbt_node * node);
+void _rbt_set_parent(cm_rbt_node * node, cm_rbt_node * parent);
+void _rbt_set_side(cm_rbt_node * node, const enum cm_rbt_side side);
+void _rbt_set_colour(cm_rbt_node * node, const enum cm_rbt_colour colour);
+
+enum cm_rbt_side _rbt_cmp_i32(const void * a, const void * b);
+enum cm_rbt_side _rbt_cmp_u32(const void * a, const void * b);
+enum cm_rbt_side _rbt_cmp_i64(const void * a, const void * b);
+enum cm_rbt_side _rbt_cmp_u64(const void * a, const void * b);
+enum cm_rbt_side _rbt_cmp_f64(const void * a, const void * b);
+cm_rbt_node * _rbt_descend_i32(cm_rbt_node * node, const void * key,
+                               enum cm_rbt_side * side);
+cm_rbt_node * _rbt_descend_u32(cm_rbt_node * node, const void * key,
+                               enum cm_rbt_side * side);
+cm_rbt_node * _rbt_descend_i64(cm_rbt_node * node, const void * key,
+                               enum cm_rbt_side * side);
+cm_rbt_node * _rbt_descend_u64(cm_rbt_node * node, const void * key,
+                               enum cm_rbt_side * side);
+cm_rbt_node * _rbt_descend_f64(cm_rbt_node * node, const void * key,
+                               enum cm_rbt_side * side);
+enum cm_rbt_side _rbt_compare(const cm_rbt * tree,
+                              const void * a, const void * b);
+
+cm_rbt_node * _rbt_descend(const cm_rbt * tree, cm_rbt_node * node,
+                           const void * key, enum cm_rbt_side * side);
 cm_rbt_node * _rbt_traverse(const cm_rbt * tree, 
                             const void * key, enum cm_rbt_side * side);
+cm_rbt_node * _rbt_traverse_hint(const cm_rbt * tree, cm_rbt_node * hint,
+                                 const void * key, enum cm_rbt_side * side);
 
 cm_rbt_node * _rbt_new_node(const cm_rbt * tree, 
                             const void * key, const void * data);
-void _rbt_del_node(cm_rbt_node * node);
+void _rbt_free_node(void * node);
+void _rbt_del_node(const cm_rbt * tree, cm_rbt_node * node);
 
 void _rbt_left_rotate(cm_rbt * tree, cm_rbt_node * node);
 void _rbt_right_rotate(cm_rbt * tree, cm_rbt_node * node);
@@ -36,7 +79,6 @@ void _rbt_transplant(cm_rbt * tree,
                      cm_rbt_node * subj_node, cm_rbt_node * tgt_node);
 
 cm_rbt_node * _rbt_left_max(cm_rbt_node * node);
-enum cm_rbt_colour _rbt_get_colour(const cm_rbt_node * node);
 
 void _rbt_populate_fix_data(const cm_rbt_node * node,
                             struct _rbt_fix_data * f_data);
@@ -74,12 +116,35 @@ cm_rbt_node * _rbt_add_node(cm_rbt * tree, const void * key,
                             enum cm_rbt_colour colour);
 cm_rbt_node * _rbt_uln_node(cm_rbt * tree, const void * key);
 
-void _rbt_emp_recurse(cm_rbt_node * node);
+void _rbt_emp_recurse(const cm_rbt * tree, cm_rbt_node * node);
 int _rbt_cpy_recurse(cm_rbt * dst_tree,
                      cm_rbt_node * dst_parent_node, cm_rbt_node * src_node);
 int _rbt_callback_recurse(cm_rbt_node * node,
                           int (* callback)(const cm_rbt_node *, void * ctx),
                           void * ctx);
+cm_rbt_node * _rbt_first(cm_rbt_node * node);
+cm_rbt_node * _rbt_next(cm_rbt_node * node);
+int _rbt_black_height(const cm_rbt_node * node);
+cm_rbt_node * _rbt_detach(cm_rbt_node * node, int * height);
+void _rbt_link(cm_rbt_node * parent, cm_rbt_node * child,
+               const enum cm_rbt_side side);
+cm_rbt_node * _rbt_join_sub(cm_rbt_node * left, const int left_height,
+                            cm_rbt_node * mid,
+                            cm_rbt_node * right, const int right_height,
+                            int * height);
+void _rbt_split_sub(const cm_rbt * tree, cm_rbt_node * node,
+                    const int node_height, const void * key,
+                    cm_rbt_node ** left, int * left_height,
+                    cm_rbt_node ** right, int * right_height);
+int _rbt_count_min(const cm_rbt_node * left, const cm_rbt_node * right,
+                   bool * is_left);
+cm_rbt_node * _rbt_build(cm_rbt_node ** nodes, const int len,
+                         const int depth, const int red_depth);
+int _rbt_merge(cm_rbt * tree, cm_rbt * other, const enum _rbt_set_op op);
+const void * _rbt_bat_key(const cm_rbt * tree, const void * keys,
+                          const int idx);
+void _rbt_sort_idx(const cm_rbt * tree, const void * keys,
+                   int * idx, int * tmp, const int len);
 #endif
 
 
@@ -94,18 +159,34 @@ cm_rbt_node * cm_rbt_idx_get_n(const cm_rbt * tree, const int idx);
 
 cm_rbt_node * cm_rbt_set(cm_rbt * tree, 
                          const void * key, const void * data);
+cm_rbt_node * cm_rbt_set_h(cm_rbt * tree, cm_rbt_node * hint,
+                           const void * key, const void * data);
+int cm_rbt_set_bat(cm_rbt * tree, const void * keys,
+                   const void * data, const int len);
 int cm_rbt_rmv(cm_rbt * tree, const void * key);
 cm_rbt_node * cm_rbt_uln(cm_rbt * tree, const void * key);
 void cm_rbt_emp(cm_rbt * tree);
 int cm_rbt_cpy(cm_rbt * dst_tree, const cm_rbt * src_tree);
 void cm_rbt_mov(cm_rbt * dst_tree, cm_rbt * src_tree);
+int cm_rbt_split(cm_rbt * tree, const void * key,
+                 cm_rbt * left_tree, cm_rbt * right_tree);
+int cm_rbt_join(cm_rbt * left_tree, cm_rbt * right_tree);
+int cm_rbt_uni(cm_rbt * tree, cm_rbt * other);
+int cm_rbt_isc(cm_rbt * tree, const cm_rbt * other);
+int cm_rbt_dif(cm_rbt * tree, const cm_rbt * other);
 
 int cm_rbt_iter(const cm_rbt * tree,
                 int (* callback)(const cm_rbt_node * node, void * ctx),
                 void * ctx);
+int cm_rbt_iter_bat(const cm_rbt * tree,
+                    int (* callback)(void * const * keys, void * const * data,
+                                     const int len, void * ctx),
+                    void * ctx);
 
 void cm_new_rbt(cm_rbt * tree, const size_t key_sz, const size_t data_sz, 
                 enum cm_rbt_side (*compare)(const void *, const void *));
+int cm_new_rbt_k(cm_rbt * tree, const enum cm_rbt_key key_kind,
+                 const size_t key_sz, const size_t data_sz);
 void cm_del_rbt(cm_rbt * tree);
 void cm_del_rbt_node(cm_rbt_node * node);
 
@@ -9,6 +9,17 @@
 #include "cmore.h"
 #include "debug.h"
 #include "vct.h"
+#include "cpu.h"
+
+//SIMD intrinsics
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+
+
+//kernels selected for this CPU, indexed by log2 of the element size
+static struct _vct_kernels _vct_kern;
 
 
 
@@ -54,7 +65,7 @@ int _vct_normalise_index(const cm_vct * vector,
     if (index < 0) {
 
         index = vector->len + index;
-        if (mode == ADD_INDEX) index++;
+        if (mode == VCT_ADD_INDEX) index++;
     }
 
     return index;
@@ -122,14 +133,385 @@ int _vct_assert_index_range(const cm_vct * vector,
 
 
 
+/*
+ *  Kernels for elements of 1, 2, 4 & 8 bytes. Elements are compared as 
+ *  integers, which for these sizes is the same as comparing their bytes.
+ *  Single byte fills have no vector variants; the compiler already turns
+ *  the scalar loop into a call to memset(), which glibc dispatches itself.
+ */
+
+#define VCT_DEF_SCALAR(bits, type)                                           \
+DBG_STATIC                                                                   \
+int _vct_fnd_##bits##_scalar(const void * data,                              \
+                             const int len, const void * key) {              \
+                                                                             \
+    type key_val;                                                            \
+    const type * arr = data;                                                 \
+                                                                             \
+    memcpy(&key_val, key, sizeof(key_val));                                  \
+    for (int i = 0; i < len; ++i) {                                          \
+        if (arr[i] == key_val) return i;                                     \
+    }                                                                        \
+                                                                             \
+    return -1;                                                               \
+}                                                                            \
+                                                                             \
+DBG_STATIC                                                                   \
+void _vct_fil_##bits##_scalar(void * data,                                   \
+                              const int len, const void * value) {           \
+                                                                             \
+    type val;                                                                \
+    type * arr = data;                                                       \
+                                                                             \
+    memcpy(&val, value, sizeof(val));                                        \
+    for (int i = 0; i < len; ++i) arr[i] = val;                              \
+                                                                             \
+    return;                                                                  \
+}
+
+VCT_DEF_SCALAR(8, uint8_t)
+VCT_DEF_SCALAR(16, uint16_t)
+VCT_DEF_SCALAR(32, uint32_t)
+VCT_DEF_SCALAR(64, uint64_t)
+
+
+
+#ifdef CPU_X86
+
+/*
+ *  Vector kernels. `eq` returns a bitmask of matching lanes, with 
+ *  `1 << shift` bits per element.
+ */
+
+#define VCT_DEF_FND(isa, attr, bits, type, vec, lanes,                       \
+                    loadu, set1, eq, shift)                                  \
+attr                                                                         \
+DBG_STATIC                                                                   \
+int _vct_fnd_##bits##_##isa(const void * data,                               \
+                            const int len, const void * key) {               \
+                                                                             \
+    int i, idx;                                                              \
+    type key_val;                                                            \
+    unsigned long long mask;                                                 \
+    const type * arr = data;                                                 \
+                                                                             \
+    memcpy(&key_val, key, sizeof(key_val));                                  \
+    const vec key_v = set1(key_val);                                         \
+                                                                             \
+    for (i = 0; i + (lanes) <= len; i += (lanes)) {                          \
+        mask = eq(loadu((void *) (arr + i)), key_v);                         \
+        if (mask != 0) return i + (__builtin_ctzll(mask) >> (shift));        \
+    }                                                                        \
+                                                                             \
+    idx = _vct_fnd_##bits##_scalar(arr + i, len - i, key);                   \
+    return idx == -1 ? -1 : i + idx;                                         \
+}
+
+#define VCT_DEF_FIL(isa, attr, bits, type, vec, lanes, storeu, set1)         \
+attr                                                                         \
+DBG_STATIC                                                                   \
+void _vct_fil_##bits##_##isa(void * data,                                    \
+                             const int len, const void * value) {            \
+                                                                             \
+    int i;                                                                   \
+    type val;                                                                \
+    type * arr = data;                                                       \
+                                                                             \
+    memcpy(&val, value, sizeof(val));                                        \
+    const vec val_v = set1(val);                                             \
+                                                                             \
+    for (i = 0; i + (lanes) <= len; i += (lanes)) {                          \
+        storeu((void *) (arr + i), val_v);                                   \
+    }                                                                        \
+                                                                             \
+    _vct_fil_##bits##_scalar(arr + i, len - i, value);                       \
+                                                                             \
+    return;                                                                  \
+}
+
+#define VCT_DEF_EQ(isa, attr, bits, vec, cmpeq, movemask)                    \
+attr                                                                         \
+static inline unsigned long long _vct_eq_##bits##_##isa(vec a, vec b) {      \
+    return (unsigned long long) movemask(cmpeq(a, b));                       \
+}
+
+//AVX-512 compares produce a mask directly
+#define VCT_MASK(mask) (mask)
+
+
+//SSE2 (no 64-bit compare, 8-byte elements stay scalar)
+VCT_DEF_EQ(sse2, CPU_TARGET_SSE2, 8, __m128i, _mm_cmpeq_epi8, _mm_movemask_epi8)
+VCT_DEF_EQ(sse2, CPU_TARGET_SSE2, 16, __m128i, _mm_cmpeq_epi16, _mm_movemask_epi8)
+VCT_DEF_EQ(sse2, CPU_TARGET_SSE2, 32, __m128i, _mm_cmpeq_epi32, _mm_movemask_epi8)
+
+VCT_DEF_FND(sse2, CPU_TARGET_SSE2, 8, uint8_t, __m128i, 16,
+            _mm_loadu_si128, _mm_set1_epi8, _vct_eq_8_sse2, 0)
+VCT_DEF_FND(sse2, CPU_TARGET_SSE2, 16, uint16_t, __m128i, 8,
+            _mm_loadu_si128, _mm_set1_epi16, _vct_eq_16_sse2, 1)
+VCT_DEF_FND(sse2, CPU_TARGET_SSE2, 32, uint32_t, __m128i, 4,
+            _mm_loadu_si128, _mm_set1_epi32, _vct_eq_32_sse2, 2)
+
+VCT_DEF_FIL(sse2, CPU_TARGET_SSE2, 16, uint16_t, __m128i, 8,
+            _mm_storeu_si128, _mm_set1_epi16)
+VCT_DEF_FIL(sse2, CPU_TARGET_SSE2, 32, uint32_t, __m128i, 4,
+            _mm_storeu_si128, _mm_set1_epi32)
+VCT_DEF_FIL(sse2, CPU_TARGET_SSE2, 64, uint64_t, __m128i, 2,
+            _mm_storeu_si128, _mm_set1_epi64x)
+
+//AVX2
+VCT_DEF_EQ(avx2, CPU_TARGET_AVX2, 8, __m256i,
+           _mm256_cmpeq_epi8, _mm256_movemask_epi8)
+VCT_DEF_EQ(avx2, CPU_TARGET_AVX2, 16, __m256i,
+           _mm256_cmpeq_epi16, _mm256_movemask_epi8)
+VCT_DEF_EQ(avx2, CPU_TARGET_AVX2, 32, __m256i,
+           _mm256_cmpeq_epi32, _mm256_movemask_epi8)
+VCT_DEF_EQ(avx2, CPU_TARGET_AVX2, 64, __m256i,
+           _mm256_cmpeq_epi64, _mm256_movemask_epi8)
+
+VCT_DEF_FND(avx2, CPU_TARGET_AVX2, 8, uint8_t, __m256i, 32,
+            _mm256_loadu_si256, _mm256_set1_epi8, _vct_eq_8_avx2, 0)
+VCT_DEF_FND(avx2, CPU_TARGET_AVX2, 16, uint16_t, __m256i, 16,
+            _mm256_loadu_si256, _mm256_set1_epi16, _vct_eq_16_avx2, 1)
+VCT_DEF_FND(avx2, CPU_TARGET_AVX2, 32, uint32_t, __m256i, 8,
+            _mm256_loadu_si256, _mm256_set1_epi32, _vct_eq_32_avx2, 2)
+VCT_DEF_FND(avx2, CPU_TARGET_AVX2, 64, uint64_t, __m256i, 4,
+            _mm256_loadu_si256, _mm256_set1_epi64x, _vct_eq_64_avx2, 3)
+
+VCT_DEF_FIL(avx2, CPU_TARGET_AVX2, 16, uint16_t, __m256i, 16,
+            _mm256_storeu_si256, _mm256_set1_epi16)
+VCT_DEF_FIL(avx2, CPU_TARGET_AVX2, 32, uint32_t, __m256i, 8,
+            _mm256_storeu_si256, _mm256_set1_epi32)
+VCT_DEF_FIL(avx2, CPU_TARGET_AVX2, 64, uint64_t, __m256i, 4,
+            _mm256_storeu_si256, _mm256_set1_epi64x)
+
+//AVX-512
+VCT_DEF_EQ(avx512, CPU_TARGET_AVX512, 8, __m512i,
+           _mm512_cmpeq_epi8_mask, VCT_MASK)
+VCT_DEF_EQ(avx512, CPU_TARGET_AVX512, 16, __m512i,
+           _mm512_cmpeq_epi16_mask, VCT_MASK)
+VCT_DEF_EQ(avx512, CPU_TARGET_AVX512, 32, __m512i,
+           _mm512_cmpeq_epi32_mask, VCT_MASK)
+VCT_DEF_EQ(avx512, CPU_TARGET_AVX512, 64, __m512i,
+           _mm512_cmpeq_epi64_mask, VCT_MASK)
+
+VCT_DEF_FND(avx512, CPU_TARGET_AVX512, 8, uint8_t, __m512i, 64,
+            _mm512_loadu_si512, _mm512_set1_epi8, _vct_eq_8_avx512, 0)
+VCT_DEF_FND(avx512, CPU_TARGET_AVX512, 16, uint16_t, __m512i, 32,
+            _mm512_loadu_si512, _mm512_set1_epi16, _vct_eq_16_avx512, 0)
+VCT_DEF_FND(avx512, CPU_TARGET_AVX512, 32, uint32_t, __m512i, 16,
+            _mm512_loadu_si512, _mm512_set1_epi32, _vct_eq_32_avx512, 0)
+VCT_DEF_FND(avx512, CPU_TARGET_AVX512, 64, uint64_t, __m512i, 8,
+            _mm512_loadu_si512, _mm512_set1_epi64, _vct_eq_64_avx512, 0)
+
+VCT_DEF_FIL(avx512, CPU_TARGET_AVX512, 16, uint16_t, __m512i, 32,
+            _mm512_storeu_si512, _mm512_set1_epi16)
+VCT_DEF_FIL(avx512, CPU_TARGET_AVX512, 32, uint32_t, __m512i, 16,
+            _mm512_storeu_si512, _mm512_set1_epi32)
+VCT_DEF_FIL(avx512, CPU_TARGET_AVX512, 64, uint64_t, __m512i, 8,
+            _mm512_storeu_si512, _mm512_set1_epi64)
+
+#endif
+
+
+
+//point the kernel table at the variants for an instruction set level
+DBG_STATIC
+void _vct_dispatch(const enum cm_cpu_lvl lvl) {
+
+    //scalar kernels work everywhere
+    _vct_kern.fnd[0] = _vct_fnd_8_scalar;
+    _vct_kern.fnd[1] = _vct_fnd_16_scalar;
+    _vct_kern.fnd[2] = _vct_fnd_32_scalar;
+    _vct_kern.fnd[3] = _vct_fnd_64_scalar;
+    _vct_kern.fil[0] = _vct_fil_8_scalar;
+    _vct_kern.fil[1] = _vct_fil_16_scalar;
+    _vct_kern.fil[2] = _vct_fil_32_scalar;
+    _vct_kern.fil[3] = _vct_fil_64_scalar;
+
+#ifdef CPU_X86
+    if (lvl >= CM_CPU_SSE2) {
+        _vct_kern.fnd[0] = _vct_fnd_8_sse2;
+        _vct_kern.fnd[1] = _vct_fnd_16_sse2;
+        _vct_kern.fnd[2] = _vct_fnd_32_sse2;
+        _vct_kern.fil[1] = _vct_fil_16_sse2;
+        _vct_kern.fil[2] = _vct_fil_32_sse2;
+        _vct_kern.fil[3] = _vct_fil_64_sse2;
+    }
+
+    if (lvl >= CM_CPU_AVX2) {
+        _vct_kern.fnd[0] = _vct_fnd_8_avx2;
+        _vct_kern.fnd[1] = _vct_fnd_16_avx2;
+        _vct_kern.fnd[2] = _vct_fnd_32_avx2;
+        _vct_kern.fnd[3] = _vct_fnd_64_avx2;
+        _vct_kern.fil[1] = _vct_fil_16_avx2;
+        _vct_kern.fil[2] = _vct_fil_32_avx2;
+        _vct_kern.fil[3] = _vct_fil_64_avx2;
+    }
+
+    if (lvl >= CM_CPU_AVX512) {
+        _vct_kern.fnd[0] = _vct_fnd_8_avx512;
+        _vct_kern.fnd[1] = _vct_fnd_16_avx512;
+        _vct_kern.fnd[2] = _vct_fnd_32_avx512;
+        _vct_kern.fnd[3] = _vct_fnd_64_avx512;
+        _vct_kern.fil[1] = _vct_fil_16_avx512;
+        _vct_kern.fil[2] = _vct_fil_32_avx512;
+        _vct_kern.fil[3] = _vct_fil_64_avx512;
+    }
+#endif
+
+    return;
+}
+
+
+
+__attribute__((constructor))
+DBG_STATIC
+void _vct_init() {
+
+    _cpu_register(_vct_dispatch);
+
+    return;
+}
+
+
+
+//index into the kernel table for an element size, -1 if there is none
+DBG_STATIC DBG_INLINE
+int _vct_kern_idx(const size_t data_sz) {
+
+    switch (data_sz) {
+        case 1: return 0;
+        case 2: return 1;
+        case 4: return 2;
+        case 8: return 3;
+    }
+
+    return -1;
+}
+
+
+
+/*
+ *  --- [VECTOR - PARALLEL] ---
+ */
+
+/*
+ *  Chunks are whole cache lines of elements where the element size 
+ *  allows, so that neighbouring workers do not write to the same line,
+ *  & never smaller than the caller's grain.
+ */
+
+DBG_STATIC
+int _vct_chunk_len(const cm_vct * vector, const int grain, const int workers) {
+
+    int len, line_len;
+
+
+    len = (vector->len + (workers * VECTOR_PAR_SPLIT) - 1)
+          / (workers * VECTOR_PAR_SPLIT);
+    if (len < grain) len = grain;
+
+    //round up to a whole number of cache lines
+    line_len = vector->data_sz >= CM_CACHE_LINE 
+               ? 1 : (int) (CM_CACHE_LINE / vector->data_sz);
+    len = ((len + line_len - 1) / line_len) * line_len;
+
+    return len;
+}
+
+
+
+DBG_STATIC
+int _vct_chunk_iter(void * ctx) {
+
+    int ret;
+    struct _vct_chunk * chunk = ctx;
+
+
+    for (int i = chunk->start; i < chunk->end; ++i) {
+
+        ret = chunk->callback(_vct_traverse(chunk->vector, i), chunk->ctx);
+        if (ret != 0) return -1;
+    }
+
+    return 0;
+}
+
+
+
+DBG_STATIC
+int _vct_chunk_rdc(void * ctx) {
+
+    int ret;
+    struct _vct_chunk * chunk = ctx;
+
+
+    for (int i = chunk->start; i < chunk->end; ++i) {
+
+        ret = chunk->map(_vct_traverse(chunk->vector, i),
+                         chunk->partial, chunk->ctx);
+        if (ret != 0) return -1;
+    }
+
+    return 0;
+}
+
+
+
+//split the vector, returns NULL if it should be processed serially
+DBG_STATIC
+struct _vct_chunk * _vct_new_chunks(const cm_vct * vector, cm_pool * pool,
+                                    const int grain, int * chunks_n) {
+
+    int len;
+    struct _vct_chunk * chunks;
+
+
+    len = _vct_chunk_len(vector, grain < 1 ? 1 : grain, pool->workers_n);
+    *chunks_n = (vector->len + len - 1) / len;
+    if (*chunks_n < 2) return NULL;
+
+    chunks = malloc(sizeof(*chunks) * *chunks_n);
+    if (chunks == NULL) return NULL;
+
+    for (int i = 0; i < *chunks_n; ++i) {
+
+        chunks[i].vector = vector;
+        chunks[i].start  = i * len;
+        chunks[i].end    = (i + 1) * len > vector->len 
+                           ? vector->len : (i + 1) * len;
+    }
+
+    return chunks;
+}
+
+
+
+DBG_STATIC
+int _vct_run_chunks(cm_pool * pool, struct _vct_chunk * chunks,
+                    const int chunks_n, int (* fn)(void * ctx)) {
+
+    cm_pool_grp grp;
+
+
+    cm_new_pool_grp(&grp);
+    for (int i = 0; i < chunks_n; ++i) {
+        cm_pool_spawn(pool, &grp, &chunks[i].task, fn, &chunks[i]);
+    }
+
+    return cm_pool_sync(pool, &grp);
+}
+
+
+
 /*
  *  --- [VECTOR -EXTERNAL] ---
  */
 
 int cm_vct_get(const cm_vct * vector, const int index, void * buf) {
 
-    int norm_index = _vct_normalise_index(vector, index, INDEX);
-    if (_vct_assert_index_range(vector, norm_index, INDEX)) return -1;
+    int norm_index = _vct_normalise_index(vector, index, VCT_INDEX);
+    if (_vct_assert_index_range(vector, norm_index, VCT_INDEX)) return -1;
     
     void * data = _vct_traverse(vector, norm_index); 
     memcpy(buf, data, vector->data_sz);
@@ -141,8 +523,8 @@ int cm_vct_get(const cm_vct * vector, const int index, void * buf) {
 
 void * cm_vct_get_p(const cm_vct * vector, const int index) {
 
-    int norm_index = _vct_normalise_index(vector, index, INDEX);
-    if (_vct_assert_index_range(vector, norm_index, INDEX)) return NULL;
+    int norm_index = _vct_normalise_index(vector, index, VCT_INDEX);
+    if (_vct_assert_index_range(vector, norm_index, VCT_INDEX)) return NULL;
     
     void * data = _vct_traverse(vector, norm_index); 
     return data;
@@ -152,8 +534,8 @@ void * cm_vct_get_p(const cm_vct * vector, const int index) {
 
 int cm_vct_set(cm_vct * vector, const int index, const void * data) {
 
-    int norm_index = _vct_normalise_index(vector, index, INDEX);
-    if (_vct_assert_index_range(vector, norm_index, INDEX)) return -1;
+    int norm_index = _vct_normalise_index(vector, index, VCT_INDEX);
+    if (_vct_assert_index_range(vector, norm_index, VCT_INDEX)) return -1;
 
     _vct_set(vector, norm_index, data);
 
@@ -164,8 +546,8 @@ int cm_vct_set(cm_vct * vector, const int index, const void * data) {
 
 int cm_vct_ins(cm_vct * vector, const int index, const void * data) {
 
-    int norm_index = _vct_normalise_index(vector, index, ADD_INDEX);
-    if (_vct_assert_index_range(vector, norm_index, ADD_INDEX)) return -1;
+    int norm_index = _vct_normalise_index(vector, index, VCT_ADD_INDEX);
+    if (_vct_assert_index_range(vector, norm_index, VCT_ADD_INDEX)) return -1;
 
     //grow the vector if there is no space left to insert new elements
     if ((size_t) vector->len == vector->sz) {
@@ -197,8 +579,8 @@ int cm_vct_apd(cm_vct * vector, const void * data) {
 
 int cm_vct_rmv(cm_vct * vector, const int index) {
 
-    int norm_index = _vct_normalise_index(vector, index, INDEX);
-    if (_vct_assert_index_range(vector, norm_index, INDEX)) return -1;
+    int norm_index = _vct_normalise_index(vector, index, VCT_INDEX);
+    if (_vct_assert_index_range(vector, norm_index, VCT_INDEX)) return -1;
 
     _vct_shift(vector, norm_index + 1, SHIFT_DOWN);
     --vector->len;
@@ -306,6 +688,66 @@ void cm_vct_mov(cm_vct * dst_vector, cm_vct * src_vector) {
 
 
 
+int cm_vct_fnd(const cm_vct * vector, const void * data) {
+
+    int kern_idx, index;
+
+
+    kern_idx = _vct_kern_idx(vector->data_sz);
+
+    //use a kernel if there is one for this element size
+    if (kern_idx != -1) {
+        index = _vct_kern.fnd[kern_idx](vector->data, vector->len, data);
+
+    //else compare every element
+    } else {
+        index = -1;
+        for (int i = 0; i < vector->len; ++i) {
+            if (memcmp(_vct_traverse(vector, i), 
+                       data, vector->data_sz) == 0) {
+                index = i;
+                break;
+            }
+        }
+    }
+
+    if (index == -1) {
+        cm_errno = CM_ERR_USER_VALUE;
+        return -1;
+    }
+
+    return index;
+}
+
+
+
+void cm_vct_fil(cm_vct * vector, const void * data) {
+
+    int kern_idx, done;
+
+
+    if (vector->len == 0) return;
+    kern_idx = _vct_kern_idx(vector->data_sz);
+
+    //use a kernel if there is one for this element size
+    if (kern_idx != -1) {
+        _vct_kern.fil[kern_idx](vector->data, vector->len, data);
+        return;
+    }
+
+    //else set the first element, then keep doubling the filled region
+    _vct_set(vector, 0, data);
+    for (done = 1; done < vector->len; done *= 2) {
+        memcpy(_vct_traverse(vector, done), vector->data,
+               vector->data_sz 
+               * (done * 2 > vector->len ? vector->len - done : done));
+    }
+
+    return;
+}
+
+
+
 int cm_vct_iter(const cm_vct * vector,
                 int (* callback)(const void * data, void * ctx),
                 void * ctx) {
@@ -331,6 +773,131 @@ int cm_vct_iter(const cm_vct * vector,
 
 
 
+//spans of `span` elements, or the whole vector if `span` is below 1
+int cm_vct_iter_spn(const cm_vct * vector,
+                    int (* callback)(const void * data,
+                                     const int len, void * ctx),
+                    void * ctx, const int span) {
+
+    int ret, len;
+
+
+    //for every span in the vector
+    for (int i = 0; i < vector->len; i += len) {
+
+        len = (span < 1 || vector->len - i < span) ? vector->len - i : span;
+
+        //process next span
+        ret = callback(_vct_traverse(vector, i), len, ctx);
+        if (ret != 0) {
+            cm_errno = CM_ERR_CALLBACK;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+
+/*
+ *  Parallel calls fall back to serial processing for vectors no larger 
+ *  than `grain`, or when the shared pool or the chunk list can't be 
+ *  allocated.
+ */
+
+int cm_vct_iter_par(const cm_vct * vector,
+                    int (* callback)(const void * data, void * ctx),
+                    void * ctx, const int grain) {
+
+    int ret, chunks_n;
+    cm_pool * pool;
+    struct _vct_chunk * chunks;
+
+
+    pool = vector->len > grain ? cm_pool_def() : NULL;
+    chunks = pool != NULL 
+             ? _vct_new_chunks(vector, pool, grain, &chunks_n) : NULL;
+    if (chunks == NULL) return cm_vct_iter(vector, callback, ctx);
+
+    for (int i = 0; i < chunks_n; ++i) {
+        chunks[i].callback = callback;
+        chunks[i].ctx      = ctx;
+    }
+
+    ret = _vct_run_chunks(pool, chunks, chunks_n, _vct_chunk_iter);
+    free(chunks);
+
+    return ret;
+}
+
+
+
+int cm_vct_rdc_par(const cm_vct * vector, void * acc, const size_t acc_sz,
+                   int (* map)(const void * data, void * partial, void * ctx),
+                   int (* combine)(void * acc, const void * partial,
+                                   void * ctx),
+                   void * ctx, const int grain) {
+
+    int ret, chunks_n;
+    size_t stride;
+    void * partials;
+    cm_pool * pool;
+    struct _vct_chunk * chunks;
+
+
+    pool = vector->len > grain ? cm_pool_def() : NULL;
+    chunks = pool != NULL 
+             ? _vct_new_chunks(vector, pool, grain, &chunks_n) : NULL;
+
+    //one partial per chunk, each on its own cache lines
+    stride = (acc_sz + CM_CACHE_LINE - 1) & ~((size_t) CM_CACHE_LINE - 1);
+    partials = chunks != NULL
+               ? aligned_alloc(CM_CACHE_LINE, stride * chunks_n) : NULL;
+
+    //serial: fold straight into the accumulator
+    if (partials == NULL) {
+
+        free(chunks);
+        for (int i = 0; i < vector->len; ++i) {
+
+            ret = map(_vct_traverse(vector, i), acc, ctx);
+            if (ret != 0) {
+                cm_errno = CM_ERR_CALLBACK;
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    //every partial starts from the identity held in `acc`
+    for (int i = 0; i < chunks_n; ++i) {
+
+        chunks[i].partial = partials + (stride * i);
+        chunks[i].map     = map;
+        chunks[i].ctx     = ctx;
+        memcpy(chunks[i].partial, acc, acc_sz);
+    }
+
+    ret = _vct_run_chunks(pool, chunks, chunks_n, _vct_chunk_rdc);
+
+    //combine in chunk order
+    for (int i = 0; ret == 0 && i < chunks_n; ++i) {
+
+        if (combine(acc, chunks[i].partial, ctx) != 0) {
+            cm_errno = CM_ERR_CALLBACK;
+            ret = -1;
+        }
+    }
+
+    free(partials);
+    free(chunks);
+
+    return ret;
+}
+
+
+
 int cm_new_vct(cm_vct * vector, const size_t data_sz) {
 
     vector->len = 0;
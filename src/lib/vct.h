@@ -13,14 +13,39 @@
 
 #define VECTOR_DEFAULT_SIZE 8
 
+//chunks per pool worker in parallel calls, for load balancing
+#define VECTOR_PAR_SPLIT 4
+
 
 //controls if user provided index should be verified for accessing elements 
 //or for adding new elements
-enum _vct_index_mode {INDEX = 0, ADD_INDEX = 1};
+enum _vct_index_mode {VCT_INDEX = 0, VCT_ADD_INDEX = 1};
 
 //controls if vector elements are shifted up or down in memory
 enum _vct_shift_mode {SHIFT_UP = 1, SHIFT_DOWN = -1};
 
+//kernels selected at load time, indexed by log2 of the element size
+struct _vct_kernels {
+
+    int (* fnd[4])(const void * data, const int len, const void * key);
+    void (* fil[4])(void * data, const int len, const void * value);
+};
+
+//one chunk of a parallel iteration or reduction
+struct _vct_chunk {
+
+    const cm_vct * vector;
+    int start;
+    int end;
+
+    int (* callback)(const void * data, void * ctx);
+    int (* map)(const void * data, void * partial, void * ctx);
+    void * partial;
+    void * ctx;
+
+    cm_pool_task task;
+};
+
 
 #ifdef CM_DEBUG
 //internal
@@ -37,6 +62,26 @@ void _vct_shift(cm_vct * vector,
 void _vct_set(cm_vct * vector, const int index, const void  * data);
 int _vct_assert_index_range(const cm_vct * vector, 
                             const int index, const enum _vct_index_mode mode);
+
+int _vct_fnd_8_scalar(const void * data, const int len, const void * key);
+int _vct_fnd_16_scalar(const void * data, const int len, const void * key);
+int _vct_fnd_32_scalar(const void * data, const int len, const void * key);
+int _vct_fnd_64_scalar(const void * data, const int len, const void * key);
+void _vct_fil_8_scalar(void * data, const int len, const void * value);
+void _vct_fil_16_scalar(void * data, const int len, const void * value);
+void _vct_fil_32_scalar(void * data, const int len, const void * value);
+void _vct_fil_64_scalar(void * data, const int len, const void * value);
+void _vct_dispatch(const enum cm_cpu_lvl lvl);
+void _vct_init();
+int _vct_kern_idx(const size_t data_sz);
+
+int _vct_chunk_len(const cm_vct * vector, const int grain, const int workers);
+int _vct_chunk_iter(void * ctx);
+int _vct_chunk_rdc(void * ctx);
+struct _vct_chunk * _vct_new_chunks(const cm_vct * vector, cm_pool * pool,
+                                    const int grain, int * chunks_n);
+int _vct_run_chunks(cm_pool * pool, struct _vct_chunk * chunks,
+                    const int chunks_n, int (* fn)(void * ctx));
 #endif
 
 
@@ -53,9 +98,23 @@ int cm_vct_rsz(cm_vct * vector, const int entries);
 void cm_vct_emp(cm_vct * vector);
 int cm_vct_cpy(cm_vct * dst_vector, const cm_vct * src_vector);
 void cm_vct_mov(cm_vct * dst_vector, cm_vct * src_vector);
+int cm_vct_fnd(const cm_vct * vector, const void * data);
+void cm_vct_fil(cm_vct * vector, const void * data);
 int cm_vct_iter(const cm_vct * vector,
                 int (* callback)(const void * data, void * ctx),
                 void * ctx);
+int cm_vct_iter_spn(const cm_vct * vector,
+                    int (* callback)(const void * data,
+                                     const int len, void * ctx),
+                    void * ctx, const int span);
+int cm_vct_iter_par(const cm_vct * vector,
+                    int (* callback)(const void * data, void * ctx),
+                    void * ctx, const int grain);
+int cm_vct_rdc_par(const cm_vct * vector, void * acc, const size_t acc_sz,
+                   int (* map)(const void * data, void * partial, void * ctx),
+                   int (* combine)(void * acc, const void * partial,
+                                   void * ctx),
+                   void * ctx, const int grain);
 
 int cm_new_vct(cm_vct * vector, const size_t data_sz);
 void cm_del_vct(cm_vct * vector);
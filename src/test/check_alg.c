@@ -1,3 +1,7 @@
+//standard library
+#include <stdint.h>
+#include <math.h>
+
 //external libraries
 #include <check.h>
 
@@ -18,6 +22,169 @@
  */
 
 
+//array lengths that exercise whole vectors & tails of every width
+static const size_t lens[] = {0, 1, 3, 7, 16, 33, 100};
+#define LENS_NUM (sizeof(lens) / sizeof(lens[0]))
+#define ARR_LEN 100
+
+
+
+/*
+ *  --- [HELPERS] ---
+ */
+
+static void _assert_clamp_arr() {
+
+    int32_t i32[ARR_LEN];
+    int64_t i64[ARR_LEN];
+    float f32[ARR_LEN];
+    double f64[ARR_LEN];
+
+
+    //first test: clamp arrays of every type & length
+    for (size_t l = 0; l < LENS_NUM; ++l) {
+
+        for (size_t i = 0; i < ARR_LEN; ++i) {
+            i32[i] = (int32_t) i - 50;
+            i64[i] = ((int64_t) i - 50) * 0x100000000;
+            f32[i] = (float) i - 50.5f;
+            f64[i] = (double) i - 50.5;
+        }
+
+        cm_clamp_i32(i32, lens[l], -10, 20);
+        cm_clamp_i64(i64, lens[l], -10 * 0x100000000LL, 20 * 0x100000000LL);
+        cm_clamp_f32(f32, lens[l], -10.0f, 20.0f);
+        cm_clamp_f64(f64, lens[l], -10.0, 20.0);
+
+        for (size_t i = 0; i < ARR_LEN; ++i) {
+
+            //elements past the length are untouched
+            if (i >= lens[l]) {
+                ck_assert_int_eq(i32[i], (int32_t) i - 50);
+                ck_assert_int_eq(i64[i], ((int64_t) i - 50) * 0x100000000);
+                ck_assert_float_eq(f32[i], (float) i - 50.5f);
+                ck_assert_double_eq(f64[i], (double) i - 50.5);
+                continue;
+            }
+
+            ck_assert_int_eq(i32[i], cm_clamp((long) i - 50, -10, 20));
+            ck_assert_int_eq(i64[i], 
+                             cm_clamp((long) i - 50, -10, 20) * 0x100000000);
+            ck_assert_float_eq(f32[i], 
+                               fminf(20.0f, fmaxf(-10.0f, (float) i - 50.5f)));
+            ck_assert_double_eq(f64[i], 
+                                fmin(20.0, fmax(-10.0, (double) i - 50.5)));
+        }
+    }
+
+    //second test: NaNs are left unchanged
+    for (size_t i = 0; i < ARR_LEN; ++i) {
+        f32[i] = i % 3 == 0 ? NAN : 100.0f;
+        f64[i] = i % 3 == 0 ? NAN : -100.0;
+    }
+
+    cm_clamp_f32(f32, ARR_LEN, -10.0f, 20.0f);
+    cm_clamp_f64(f64, ARR_LEN, -10.0, 20.0);
+
+    for (size_t i = 0; i < ARR_LEN; ++i) {
+        if (i % 3 == 0) {
+            ck_assert_float_nan(f32[i]);
+            ck_assert_double_nan(f64[i]);
+        } else {
+            ck_assert_float_eq(f32[i], 20.0f);
+            ck_assert_double_eq(f64[i], -10.0);
+        }
+    }
+
+    return;
+}
+
+
+
+static void _assert_minmax_arr() {
+
+    int32_t i32[ARR_LEN], i32_min, i32_max;
+    int64_t i64[ARR_LEN], i64_min, i64_max;
+    float f32[ARR_LEN], f32_min, f32_max;
+    double f64[ARR_LEN], f64_min, f64_max;
+
+
+    //first test: every type & length, extremes at varying positions
+    for (size_t l = 2; l < LENS_NUM; ++l) {
+
+        for (size_t i = 0; i < ARR_LEN; ++i) {
+            i32[i] = 0;
+            i64[i] = 0;
+            f32[i] = 0.0f;
+            f64[i] = 0.0;
+        }
+
+        i32[lens[l] - 1] = -7;
+        i32[lens[l] / 2] = INT32_MAX - 1;
+        i64[lens[l] / 3] = INT64_MIN + 1;
+        i64[lens[l] - 1] = 9;
+        f32[lens[l] - 1] = -2.5f;
+        f32[0] = 1e30f;
+        f64[lens[l] / 2] = -1e300;
+        f64[lens[l] - 1] = 3.5;
+
+        //an element past the length must be ignored
+        if (lens[l] < ARR_LEN) i32[lens[l]] = INT32_MIN;
+
+        cm_minmax_i32(i32, lens[l], &i32_min, &i32_max);
+        cm_minmax_i64(i64, lens[l], &i64_min, &i64_max);
+        cm_minmax_f32(f32, lens[l], &f32_min, &f32_max);
+        cm_minmax_f64(f64, lens[l], &f64_min, &f64_max);
+
+        ck_assert_int_eq(i32_min, -7);
+        ck_assert_int_eq(i32_max, INT32_MAX - 1);
+        ck_assert_int_eq(i64_min, INT64_MIN + 1);
+        ck_assert_int_eq(i64_max, 9);
+        ck_assert_float_eq(f32_min, -2.5f);
+        ck_assert_float_eq(f32_max, 1e30f);
+        ck_assert_double_eq(f64_min, -1e300);
+        ck_assert_double_eq(f64_max, 3.5);
+
+        ck_assert_int_eq(cm_min_i32(i32, lens[l]), i32_min);
+        ck_assert_int_eq(cm_max_i32(i32, lens[l]), i32_max);
+        ck_assert_int_eq(cm_min_i64(i64, lens[l]), i64_min);
+        ck_assert_int_eq(cm_max_i64(i64, lens[l]), i64_max);
+        ck_assert_float_eq(cm_min_f32(f32, lens[l]), f32_min);
+        ck_assert_float_eq(cm_max_f32(f32, lens[l]), f32_max);
+        ck_assert_double_eq(cm_min_f64(f64, lens[l]), f64_min);
+        ck_assert_double_eq(cm_max_f64(f64, lens[l]), f64_max);
+    }
+
+    //second test: single element
+    ck_assert_int_eq(cm_min_i32(i32, 1), i32[0]);
+    ck_assert_int_eq(cm_max_i32(i32, 1), i32[0]);
+
+    //third test: NaNs are skipped
+    for (size_t i = 0; i < ARR_LEN; ++i) {
+        f32[i] = i % 2 == 0 ? NAN : (float) i;
+        f64[i] = i % 2 == 0 ? NAN : (double) i;
+    }
+
+    cm_minmax_f32(f32, ARR_LEN, &f32_min, &f32_max);
+    cm_minmax_f64(f64, ARR_LEN, &f64_min, &f64_max);
+    ck_assert_float_eq(f32_min, 1.0f);
+    ck_assert_float_eq(f32_max, 99.0f);
+    ck_assert_double_eq(f64_min, 1.0);
+    ck_assert_double_eq(f64_max, 99.0);
+
+    //fourth test: empty array
+    cm_minmax_i32(i32, 0, &i32_min, &i32_max);
+    cm_minmax_f64(f64, 0, &f64_min, &f64_max);
+    ck_assert_int_eq(i32_min, INT32_MAX);
+    ck_assert_int_eq(i32_max, INT32_MIN);
+    ck_assert_double_infinite(f64_min);
+    ck_assert_double_infinite(f64_max);
+
+    return;
+}
+
+
+
 /*
  *  --- [UNIT TESTS] ---
  */
@@ -47,6 +214,146 @@ START_TEST(test_clamp) {
 
 
 
+//cm_clamp_*() [no fixture]
+START_TEST(test_clamp_arr) {
+
+    int ret;
+    enum cm_cpu_lvl max_lvl = cm_cpu_get();
+
+
+    //only test: clamp arrays with every instruction set
+    for (int lvl = CM_CPU_SCALAR; lvl <= (int) max_lvl; ++lvl) {
+
+        ret = cm_cpu_set((enum cm_cpu_lvl) lvl);
+        ck_assert_int_eq(ret, 0);
+        _assert_clamp_arr();
+    }
+
+    ret = cm_cpu_set(max_lvl);
+    ck_assert_int_eq(ret, 0);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_min_*(), cm_max_*() & cm_minmax_*() [no fixture]
+START_TEST(test_minmax_arr) {
+
+    int ret;
+    enum cm_cpu_lvl max_lvl = cm_cpu_get();
+
+
+    //only test: find minimums & maximums with every instruction set
+    for (int lvl = CM_CPU_SCALAR; lvl <= (int) max_lvl; ++lvl) {
+
+        ret = cm_cpu_set((enum cm_cpu_lvl) lvl);
+        ck_assert_int_eq(ret, 0);
+        _assert_minmax_arr();
+    }
+
+    ret = cm_cpu_set(max_lvl);
+    ck_assert_int_eq(ret, 0);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_cpu_get() & cm_cpu_set() [no fixture]
+START_TEST(test_cpu) {
+
+    int ret;
+    enum cm_cpu_lvl max_lvl = cm_cpu_get();
+
+
+    //first test: the scalar level is always available
+    ret = cm_cpu_set(CM_CPU_SCALAR);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(cm_cpu_get(), CM_CPU_SCALAR);
+
+    //second test: a level above the CPU's is refused
+    if (max_lvl < CM_CPU_AVX512) {
+        ret = cm_cpu_set(max_lvl + 1);
+        ck_assert_int_eq(ret, -1);
+        ck_assert_int_eq(cm_errno, CM_ERR_USER_CPU);
+        ck_assert_int_eq(cm_cpu_get(), CM_CPU_SCALAR);
+    }
+
+    //third test: restore the detected level
+    ret = cm_cpu_set(max_lvl);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(cm_cpu_get(), max_lvl);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_clamp_vct() & cm_minmax_vct() [no fixture]
+START_TEST(test_alg_vct) {
+
+    int ret;
+    cm_vct v;
+    int32_t i32, lower, upper, min, max;
+    int64_t i64;
+
+
+    ret = cm_new_vct(&v, sizeof(int32_t));
+    ck_assert_int_eq(ret, 0);
+
+    //first test: vector is empty
+    ret = cm_minmax_vct(&v, CM_ALG_I32, &min, &max);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    for (int i = 0; i < ARR_LEN; ++i) {
+        i32 = i - 50;
+        ret = cm_vct_apd(&v, &i32);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    //second test: type does not match the vector
+    lower = -10;
+    upper = 20;
+    i64 = 0;
+    ret = cm_clamp_vct(&v, CM_ALG_I64, &i64, &i64);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_TYPE);
+    ret = cm_minmax_vct(&v, CM_ALG_F64, &min, &max);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_TYPE);
+
+    //third test: minimum & maximum
+    ret = cm_minmax_vct(&v, CM_ALG_I32, &min, &max);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(min, -50);
+    ck_assert_int_eq(max, 49);
+
+    //fourth test: clamp, then fetch only the maximum
+    ret = cm_clamp_vct(&v, CM_ALG_I32, &lower, &upper);
+    ck_assert_int_eq(ret, 0);
+    ret = cm_minmax_vct(&v, CM_ALG_I32, NULL, &max);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(max, upper);
+
+    for (int i = 0; i < ARR_LEN; ++i) {
+        ret = cm_vct_get(&v, i, &i32);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(i32, cm_clamp(i - 50, lower, upper));
+    }
+
+    cm_del_vct(&v);
+
+    return;
+
+} END_TEST
+
+
+
 /*
  *  --- [SUITE] ---
  */
@@ -55,6 +362,10 @@ Suite * alg_suite() {
 
     //test cases
     TCase * tc_clamp;
+    TCase * tc_clamp_arr;
+    TCase * tc_minmax_arr;
+    TCase * tc_alg_vct;
+    TCase * tc_cpu;
 
     Suite * s = suite_create("algorithm");
 
@@ -63,9 +374,29 @@ Suite * alg_suite() {
     tc_clamp = tcase_create("clamp");
     tcase_add_test(tc_clamp, test_clamp);
 
+    //cm_clamp_*()
+    tc_clamp_arr = tcase_create("clamp_arr");
+    tcase_add_test(tc_clamp_arr, test_clamp_arr);
+
+    //cm_minmax_*()
+    tc_minmax_arr = tcase_create("minmax_arr");
+    tcase_add_test(tc_minmax_arr, test_minmax_arr);
+
+    //cm_*_vct()
+    tc_alg_vct = tcase_create("alg_vct");
+    tcase_add_test(tc_alg_vct, test_alg_vct);
+
+    //cm_cpu_*()
+    tc_cpu = tcase_create("cpu");
+    tcase_add_test(tc_cpu, test_cpu);
+
 
     //add test cases to algorithm suite
     suite_add_tcase(s, tc_clamp);
+    suite_add_tcase(s, tc_clamp_arr);
+    suite_add_tcase(s, tc_minmax_arr);
+    suite_add_tcase(s, tc_alg_vct);
+    suite_add_tcase(s, tc_cpu);
 
     return s;
 }
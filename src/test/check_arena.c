@@ -0,0 +1,196 @@
+//standard library
+#include <stdint.h>
+#include <string.h>
+
+//external libraries
+#include <check.h>
+
+//local headers
+#include "suites.h"
+
+//test target headers
+#include "../lib/cmore.h"
+#include "../lib/arena.h"
+
+
+
+/*
+ *  [BASIC TEST]
+ *
+ *     Arenas are simple; internal functions 
+ *     are tested through exported functions.
+ */
+
+
+
+//globals
+static cm_arena a;
+
+
+
+/*
+ *  --- [FIXTURES] ---
+ */
+
+//'arena' fixture
+static void _setup_arena() {
+
+    int ret;
+
+
+    ret = cm_new_arena(&a, 64);
+
+    return;
+}
+
+
+
+static void _teardown_arena() {
+
+    cm_del_arena(&a);
+
+    return;
+}
+
+
+
+/*
+ *  --- [UNIT TESTS] ---
+ */
+
+//cm_new_arena() & cm_del_arena() [no fixture]
+START_TEST(test_new_del_arena) {
+
+    int ret;
+
+
+    //only test: create & destroy an arena
+    ret = cm_new_arena(&a, 100);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(a.blk_sz, 112);
+    ck_assert_int_eq(a.off, 0);
+    ck_assert_ptr_eq(a.cur, a.head);
+    ck_assert_ptr_null(a.head->next);
+    ck_assert_int_eq(a.is_init, true);
+
+    cm_del_arena(&a);
+    ck_assert_ptr_null(a.head);
+    ck_assert_int_eq(a.is_init, false);
+
+    return;
+    
+} END_TEST
+
+
+
+//cm_arena_alloc()
+START_TEST(test_arena_alloc) {
+
+    cm_byte * ptr[4];
+
+
+    //first test: allocations are aligned & do not overlap
+    ptr[0] = cm_arena_alloc(&a, 1);
+    ptr[1] = cm_arena_alloc(&a, 20);
+    ck_assert_ptr_nonnull(ptr[0]);
+    ck_assert_ptr_nonnull(ptr[1]);
+    ck_assert_int_eq((uintptr_t) ptr[0] % ARENA_ALIGN, 0);
+    ck_assert_int_eq((uintptr_t) ptr[1] % ARENA_ALIGN, 0);
+    ck_assert_ptr_eq(ptr[1], ptr[0] + ARENA_ALIGN);
+    ck_assert_int_eq(a.off, 48);
+    memset(ptr[1], 0xff, 20);
+
+    //second test: spill into a new block
+    ptr[2] = cm_arena_alloc(&a, 32);
+    ck_assert_ptr_nonnull(ptr[2]);
+    ck_assert_ptr_ne(a.cur, a.head);
+    ck_assert_ptr_eq(a.head->next, a.cur);
+    ck_assert_int_eq(a.off, 32);
+    ck_assert_int_eq((uintptr_t) ptr[2] % ARENA_ALIGN, 0);
+
+    //third test: allocation larger than a block
+    ptr[3] = cm_arena_alloc(&a, 200);
+    ck_assert_ptr_nonnull(ptr[3]);
+    ck_assert_int_eq(a.cur->sz, 208);
+    ck_assert_int_eq(a.off, 208);
+    memset(ptr[3], 0xff, 200);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_arena_rst()
+START_TEST(test_arena_rst) {
+
+    cm_byte * ptr[3];
+    cm_arena_blk * blk;
+
+
+    ptr[0] = cm_arena_alloc(&a, 48);
+    ptr[1] = cm_arena_alloc(&a, 48);
+    blk = a.cur;
+
+    //first test: reset returns to the first block
+    cm_arena_rst(&a);
+    ck_assert_ptr_eq(a.cur, a.head);
+    ck_assert_int_eq(a.off, 0);
+
+    //second test: allocations reuse existing blocks
+    ptr[2] = cm_arena_alloc(&a, 48);
+    ck_assert_ptr_eq(ptr[2], ptr[0]);
+    ptr[2] = cm_arena_alloc(&a, 48);
+    ck_assert_ptr_eq(ptr[2], ptr[1]);
+    ck_assert_ptr_eq(a.cur, blk);
+
+    //third test: a kept block too small for a request is not reused
+    cm_arena_rst(&a);
+    ptr[2] = cm_arena_alloc(&a, 48);
+    ptr[2] = cm_arena_alloc(&a, 128);
+    ck_assert_ptr_ne(a.cur, blk);
+    ck_assert_ptr_eq(a.cur->next, blk);
+    ck_assert_int_eq(a.cur->sz, 128);
+
+    return;
+
+} END_TEST
+
+
+
+/*
+ *  --- [SUITE] ---
+ */
+
+Suite * arena_suite() {
+
+    //test cases
+    TCase * tc_new_del_arena;
+    TCase * tc_arena_alloc;
+    TCase * tc_arena_rst;
+
+    Suite * s = suite_create("arena");
+
+
+    //cm_new_arena()
+    tc_new_del_arena = tcase_create("new_del_arena");
+    tcase_add_test(tc_new_del_arena, test_new_del_arena);
+
+    //cm_arena_alloc()
+    tc_arena_alloc = tcase_create("arena_alloc");
+    tcase_add_checked_fixture(tc_arena_alloc, _setup_arena, _teardown_arena);
+    tcase_add_test(tc_arena_alloc, test_arena_alloc);
+
+    //cm_arena_rst()
+    tc_arena_rst = tcase_create("arena_rst");
+    tcase_add_checked_fixture(tc_arena_rst, _setup_arena, _teardown_arena);
+    tcase_add_test(tc_arena_rst, test_arena_rst);
+
+
+    //add test cases to arena suite
+    suite_add_tcase(s, tc_new_del_arena);
+    suite_add_tcase(s, tc_arena_alloc);
+    suite_add_tcase(s, tc_arena_rst);
+
+    return s;
+}
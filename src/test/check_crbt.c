@@ -0,0 +1,281 @@
+//standard library
+#include <stdlib.h>
+
+//system headers
+#include <pthread.h>
+#include <sched.h>
+
+//external libraries
+#include <check.h>
+
+//local headers
+#include "suites.h"
+
+//test target headers
+#include "../lib/cmore.h"
+#include "../lib/crbt.h"
+
+
+
+/*
+ *  [BASIC TEST]
+ *
+ *     The wrapped tree is tested by the red-black
+ *     tree suite; these tests cover the wrapper, 
+ *     reclamation & concurrent readers.
+ */
+
+
+
+//globals
+static cm_crbt ct;
+
+#define CRBT_KEYS    512
+#define CRBT_READERS 3
+#define CRBT_ROUNDS  20
+
+
+
+/*
+ *  --- [HELPERS] ---
+ */
+
+static enum cm_rbt_side _compare(const void * a, const void * b) {
+
+    int x = *(int *) a, y = *(int *) b;
+
+    if (x < y) return CM_RBT_LESS;
+    if (x > y) return CM_RBT_MORE;
+    return CM_RBT_EQUAL;
+}
+
+
+
+//look up random keys until told to stop
+struct _reader_arg {
+
+    bool * stop;
+    int hits;
+    bool valid;
+};
+
+static void * _reader(void * arg) {
+
+    int ret, key, value;
+    unsigned int seed;
+    struct _reader_arg * a = arg;
+
+
+    seed = (unsigned int) (uintptr_t) arg;
+    a->hits  = 0;
+    a->valid = true;
+
+    while (!__atomic_load_n(a->stop, __ATOMIC_RELAXED)) {
+
+        key = rand_r(&seed) % CRBT_KEYS;
+        ret = cm_crbt_get(&ct, &key, &value);
+
+        //values are always derived from their key
+        if (ret == 0) {
+            if (value != key * 2) a->valid = false;
+            ++a->hits;
+        }
+        if (ret != 0 && cm_errno != CM_ERR_USER_KEY) a->valid = false;
+    }
+
+    return NULL;
+}
+
+
+
+/*
+ *  --- [FIXTURES] ---
+ */
+
+static void _setup() {
+
+    int ret;
+
+
+    ret = cm_new_crbt(&ct, sizeof(int), sizeof(int), _compare);
+
+    return;
+}
+
+
+
+static void _teardown() {
+
+    cm_del_crbt(&ct);
+
+    return;
+}
+
+
+
+/*
+ *  --- [UNIT TESTS] ---
+ */
+
+//cm_new_crbt() & cm_del_crbt() [no fixture]
+START_TEST(test_new_del_crbt) {
+
+    int ret;
+    cm_crbt u;
+
+
+    //only test: create a concurrent tree & destroy it
+    ret = cm_new_crbt(&u, sizeof(int), sizeof(int), _compare);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(u.seq, 0);
+    ck_assert_int_eq(u.tree.size, 0);
+    ck_assert(u.is_init);
+
+    cm_del_crbt(&u);
+    ck_assert(!u.is_init);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_crbt_get(), cm_crbt_set() & cm_crbt_rmv() [crbt fixture]
+START_TEST(test_crbt_get_set_rmv) {
+
+    int ret, key, value;
+
+
+    //first test: miss on an empty tree
+    key = 1;
+    ret = cm_crbt_get(&ct, &key, &value);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+
+    //second test: set & get, every write moves the sequence by two
+    for (key = 0; key < 100; ++key) {
+        value = key * 2;
+        ret = cm_crbt_set(&ct, &key, &value);
+        ck_assert_int_eq(ret, 0);
+    }
+    ck_assert_int_eq(ct.seq, 200);
+
+    for (key = 0; key < 100; ++key) {
+        ret = cm_crbt_get(&ct, &key, &value);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(value, key * 2);
+    }
+
+    //third test: removed nodes are retired, not freed
+    for (key = 0; key < 10; ++key) {
+        ret = cm_crbt_rmv(&ct, &key);
+        ck_assert_int_eq(ret, 0);
+        ret = cm_crbt_get(&ct, &key, &value);
+        ck_assert_int_eq(ret, -1);
+    }
+    ck_assert_int_eq(ct.retired.len, 10);
+
+    //fourth test: remove a missing key
+    key = 5;
+    ret = cm_crbt_rmv(&ct, &key);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+
+    //fifth test: reclaim on demand
+    cm_crbt_rcl(&ct);
+    ck_assert_int_eq(ct.retired.len, 0);
+    ck_assert_int_eq(ct.parity, 1);
+
+    //sixth test: reclaim automatically once enough nodes are retired
+    for (key = 10; key < 10 + CRBT_RETIRE_MAX; ++key) {
+        ret = cm_crbt_rmv(&ct, &key);
+        ck_assert_int_eq(ret, 0);
+    }
+    ck_assert_int_eq(ct.retired.len, 0);
+    ck_assert_int_eq(ct.tree.size, 100 - 10 - CRBT_RETIRE_MAX);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_crbt_*() with concurrent readers [crbt fixture]
+START_TEST(test_crbt_threads) {
+
+    int ret, value;
+    bool stop;
+    pthread_t readers[CRBT_READERS];
+    struct _reader_arg args[CRBT_READERS];
+
+
+    stop = false;
+    for (int i = 0; i < CRBT_READERS; ++i) {
+        args[i].stop = &stop;
+        ret = pthread_create(&readers[i], NULL, _reader, &args[i]);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    //only test: readers see consistent values while nodes churn
+    for (int r = 0; r < CRBT_ROUNDS; ++r) {
+
+        for (int key = 0; key < CRBT_KEYS; ++key) {
+            value = key * 2;
+            cm_crbt_set(&ct, &key, &value);
+        }
+        sched_yield();
+
+        for (int key = r % 2; key < CRBT_KEYS; key += 2) {
+            cm_crbt_rmv(&ct, &key);
+        }
+        sched_yield();
+    }
+
+    __atomic_store_n(&stop, true, __ATOMIC_RELAXED);
+    for (int i = 0; i < CRBT_READERS; ++i) {
+        pthread_join(readers[i], NULL);
+        ck_assert(args[i].valid);
+    }
+
+    return;
+
+} END_TEST
+
+
+
+/*
+ *  --- [SUITE] ---
+ */
+
+Suite * crbt_suite() {
+
+    //test cases
+    TCase * tc_new_del_crbt;
+    TCase * tc_crbt_get_set_rmv;
+    TCase * tc_crbt_threads;
+
+    Suite * s = suite_create("concurrent rb_tree");
+
+
+    //cm_new_crbt()
+    tc_new_del_crbt = tcase_create("new_del_crbt");
+    tcase_add_test(tc_new_del_crbt, test_new_del_crbt);
+
+    //cm_crbt_get(), cm_crbt_set() & cm_crbt_rmv()
+    tc_crbt_get_set_rmv = tcase_create("crbt_get_set_rmv");
+    tcase_add_checked_fixture(tc_crbt_get_set_rmv, _setup, _teardown);
+    tcase_add_test(tc_crbt_get_set_rmv, test_crbt_get_set_rmv);
+
+    //concurrent readers
+    tc_crbt_threads = tcase_create("crbt_threads");
+    tcase_add_checked_fixture(tc_crbt_threads, _setup, _teardown);
+    tcase_set_timeout(tc_crbt_threads, 60);
+    tcase_add_test(tc_crbt_threads, test_crbt_threads);
+
+    //add test cases to concurrent rb_tree suite
+    suite_add_tcase(s, tc_new_del_crbt);
+    suite_add_tcase(s, tc_crbt_get_set_rmv);
+    suite_add_tcase(s, tc_crbt_threads);
+
+    return s;
+}
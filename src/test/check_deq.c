@@ -0,0 +1,344 @@
+//standard library
+#include <string.h>
+
+//external libraries
+#include <check.h>
+
+//local headers
+#include "suites.h"
+
+//test target headers
+#include "../lib/cmore.h"
+#include "../lib/deq.h"
+
+
+
+/*
+ *  [BASIC TEST]
+ *
+ *     Deques are simple; internal functions 
+ *     are tested through exported functions.
+ */
+
+
+
+//globals
+static cm_deq q;
+
+
+
+/*
+ *  --- [HELPERS] ---
+ */
+
+//assert the deque holds `len` consecutive values starting at `first`
+static void _assert_run(const int first, const int len) {
+
+    int ret, value;
+
+    ck_assert_int_eq(q.len, len);
+
+    for (int i = 0; i < len; ++i) {
+
+        ret = cm_deq_get(&q, i, &value);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(value, first + i);
+
+        //negative indeces count back from the end
+        ret = cm_deq_get(&q, i - len, &value);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(value, first + i);
+    }
+
+    return;
+}
+
+
+
+/*
+ *  --- [FIXTURES] ---
+ */
+
+//empty deque setup
+static void _setup_emp() {
+
+    int ret;
+
+
+    ret = cm_new_deq(&q, sizeof(int));
+
+    return;
+}
+
+
+
+static void _teardown() {
+
+    cm_del_deq(&q);
+
+    return;
+}
+
+
+
+/*
+ *  --- [UNIT TESTS] ---
+ */
+
+//cm_new_deq() & cm_del_deq() [no fixture]
+START_TEST(test_new_del_deq) {
+
+    int ret;
+
+
+    //only test: create & destroy a deque
+    ret = cm_new_deq(&q, sizeof(int));
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(q.len, 0);
+    ck_assert_int_eq(q.sz, DEQUE_DEFAULT_SIZE);
+    ck_assert_int_eq(q.is_init, true);
+
+    cm_del_deq(&q);
+    ck_assert_int_eq(q.is_init, false);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_deq_psh_*() & cm_deq_pop_*() [empty fixture]
+START_TEST(test_deq_psh_pop) {
+
+    int ret, value;
+
+
+    //first test: pop from an empty deque
+    ret = cm_deq_pop_f(&q, &value);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+    ret = cm_deq_pop_b(&q, &value);
+    ck_assert_int_eq(ret, -1);
+
+    //second test: push to both ends, growing while wrapped
+    for (int i = 0; i < 50; ++i) {
+
+        value = 50 + i;
+        ret = cm_deq_psh_b(&q, &value);
+        ck_assert_int_eq(ret, 0);
+
+        value = 49 - i;
+        ret = cm_deq_psh_f(&q, &value);
+        ck_assert_int_eq(ret, 0);
+    }
+    _assert_run(0, 100);
+    ck_assert_int_eq(q.sz, 128);
+
+    //third test: pop from both ends
+    for (int i = 0; i < 20; ++i) {
+
+        ret = cm_deq_pop_f(&q, &value);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(value, i);
+
+        ret = cm_deq_pop_b(&q, &value);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(value, 99 - i);
+    }
+    _assert_run(20, 60);
+
+    //fourth test: cycle as a FIFO without growing
+    for (int i = 0; i < 1000; ++i) {
+
+        value = 80 + i;
+        ret = cm_deq_psh_b(&q, &value);
+        ck_assert_int_eq(ret, 0);
+
+        ret = cm_deq_pop_f(&q, NULL);
+        ck_assert_int_eq(ret, 0);
+    }
+    _assert_run(1020, 60);
+    ck_assert_int_eq(q.sz, 128);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_deq_get(), cm_deq_get_p() & cm_deq_set() [empty fixture]
+START_TEST(test_deq_get_set) {
+
+    int ret, value;
+    int * value_p;
+
+
+    for (int i = 0; i < 6; ++i) {
+        ret = cm_deq_psh_f(&q, &i);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    //first test: out of range indeces
+    ret = cm_deq_get(&q, 6, &value);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+    ret = cm_deq_get(&q, -7, &value);
+    ck_assert_int_eq(ret, -1);
+    value_p = cm_deq_get_p(&q, 6);
+    ck_assert_ptr_null(value_p);
+
+    //second test: set every element through positive & negative indeces
+    for (int i = 0; i < 6; ++i) {
+
+        value = 10 + i;
+        ret = cm_deq_set(&q, i % 2 == 0 ? i : i - 6, &value);
+        ck_assert_int_eq(ret, 0);
+    }
+    _assert_run(10, 6);
+
+    //third test: pointers refer to the element
+    value_p = cm_deq_get_p(&q, -1);
+    ck_assert_int_eq(*value_p, 15);
+    *value_p = 16;
+    ret = cm_deq_pop_b(&q, &value);
+    ck_assert_int_eq(value, 16);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_deq_psh_*_n() & cm_deq_pop_*_n() [empty fixture]
+START_TEST(test_deq_bulk) {
+
+    int ret;
+    int in[100], out[100];
+
+
+    for (int i = 0; i < 100; ++i) in[i] = i;
+
+    //first test: bulk push to both ends, keeping order
+    ret = cm_deq_psh_b_n(&q, in + 50, 3);
+    ck_assert_int_eq(ret, 0);
+    ret = cm_deq_psh_f_n(&q, in + 40, 10);
+    ck_assert_int_eq(ret, 0);
+    ret = cm_deq_psh_b_n(&q, in + 53, 47);
+    ck_assert_int_eq(ret, 0);
+    ret = cm_deq_psh_f_n(&q, in, 40);
+    ck_assert_int_eq(ret, 0);
+    _assert_run(0, 100);
+
+    //second test: bulk pop from both ends
+    ret = cm_deq_pop_f_n(&q, out, 30);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(memcmp(out, in, sizeof(int) * 30), 0);
+
+    ret = cm_deq_pop_b_n(&q, out, 30);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(memcmp(out, in + 70, sizeof(int) * 30), 0);
+    _assert_run(30, 40);
+
+    //third test: wrap bulk operations around the end of the ring
+    for (int i = 0; i < 10; ++i) {
+
+        ret = cm_deq_pop_f_n(&q, out, 25);
+        ck_assert_int_eq(ret, 0);
+        ret = cm_deq_psh_b_n(&q, out, 25);
+        ck_assert_int_eq(ret, 0);
+    }
+    //the 40 elements were rotated left by 250 % 40 = 10
+    for (int i = 0; i < 40; ++i) {
+        ret = cm_deq_get(&q, i, out);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(out[0], 30 + ((i + 10) % 40));
+    }
+
+    //fourth test: pop more elements than are present
+    ret = cm_deq_pop_b_n(&q, out, 41);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    //fifth test: pop everything, discarding it
+    ret = cm_deq_pop_b_n(&q, NULL, 40);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(q.len, 0);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_deq_emp() [empty fixture]
+START_TEST(test_deq_emp) {
+
+    int ret;
+
+
+    for (int i = 0; i < 10; ++i) {
+        ret = cm_deq_psh_f(&q, &i);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    //only test: empty the deque
+    cm_deq_emp(&q);
+    ck_assert_int_eq(q.len, 0);
+    ck_assert_ptr_null(cm_deq_get_p(&q, 0));
+
+    return;
+
+} END_TEST
+
+
+
+/*
+ *  --- [SUITE] ---
+ */
+
+Suite * deq_suite() {
+
+    //test cases
+    TCase * tc_new_del_deq;
+    TCase * tc_deq_psh_pop;
+    TCase * tc_deq_get_set;
+    TCase * tc_deq_bulk;
+    TCase * tc_deq_emp;
+
+    Suite * s = suite_create("deque");
+
+
+    //cm_new_deq()
+    tc_new_del_deq = tcase_create("new_del_deq");
+    tcase_add_test(tc_new_del_deq, test_new_del_deq);
+
+    //cm_deq_psh_*() & cm_deq_pop_*()
+    tc_deq_psh_pop = tcase_create("deq_psh_pop");
+    tcase_add_checked_fixture(tc_deq_psh_pop, _setup_emp, _teardown);
+    tcase_add_test(tc_deq_psh_pop, test_deq_psh_pop);
+
+    //cm_deq_get() & cm_deq_set()
+    tc_deq_get_set = tcase_create("deq_get_set");
+    tcase_add_checked_fixture(tc_deq_get_set, _setup_emp, _teardown);
+    tcase_add_test(tc_deq_get_set, test_deq_get_set);
+
+    //cm_deq_*_n()
+    tc_deq_bulk = tcase_create("deq_bulk");
+    tcase_add_checked_fixture(tc_deq_bulk, _setup_emp, _teardown);
+    tcase_add_test(tc_deq_bulk, test_deq_bulk);
+
+    //cm_deq_emp()
+    tc_deq_emp = tcase_create("deq_emp");
+    tcase_add_checked_fixture(tc_deq_emp, _setup_emp, _teardown);
+    tcase_add_test(tc_deq_emp, test_deq_emp);
+
+
+    //add test cases to deque suite
+    suite_add_tcase(s, tc_new_del_deq);
+    suite_add_tcase(s, tc_deq_psh_pop);
+    suite_add_tcase(s, tc_deq_get_set);
+    suite_add_tcase(s, tc_deq_bulk);
+    suite_add_tcase(s, tc_deq_emp);
+
+    return s;
+}
@@ -0,0 +1,406 @@
+//standard library
+#include <stdlib.h>
+
+//system headers
+#include <pthread.h>
+#include <sched.h>
+
+//external libraries
+#include <check.h>
+
+//local headers
+#include "suites.h"
+
+//test target headers
+#include "../lib/cmore.h"
+#include "../lib/epoch.h"
+
+
+
+/*
+ *  [BASIC TEST]
+ *
+ *     Reclamation is observed through a counting
+ *     destructor; the threaded test relies on the
+ *     address sanitizer of debug builds to catch
+ *     use after free.
+ */
+
+
+
+//globals
+static cm_epoch e;
+static int freed;
+
+#define EPOCH_READERS 3
+#define EPOCH_ROUNDS  2000
+
+
+
+/*
+ *  --- [HELPERS] ---
+ */
+
+static void _count_del(void * ptr) {
+
+    free(ptr);
+    __atomic_add_fetch(&freed, 1, __ATOMIC_RELAXED);
+
+    return;
+}
+
+
+
+static enum cm_rbt_side _compare(const void * a, const void * b) {
+
+    int x = *(int *) a, y = *(int *) b;
+
+    if (x < y) return CM_RBT_LESS;
+    if (x > y) return CM_RBT_MORE;
+    return CM_RBT_EQUAL;
+}
+
+
+
+//read the shared value until told to stop
+struct _reader_arg {
+
+    int ** shared;
+    bool * stop;
+    bool valid;
+};
+
+static void * _reader(void * arg) {
+
+    int * value;
+    cm_epoch_thr thr;
+    struct _reader_arg * a = arg;
+
+
+    a->valid = cm_epoch_reg(&e, &thr) == 0;
+
+    while (!__atomic_load_n(a->stop, __ATOMIC_RELAXED)) {
+
+        cm_epoch_pin(&thr);
+        value = __atomic_load_n(a->shared, __ATOMIC_ACQUIRE);
+        if (*value < 0) a->valid = false;
+        cm_epoch_unpin(&thr);
+
+        sched_yield();
+    }
+
+    cm_epoch_unreg(&thr);
+
+    return NULL;
+}
+
+
+
+/*
+ *  --- [FIXTURES] ---
+ */
+
+static void _setup() {
+
+    int ret;
+
+
+    ret = cm_new_epoch(&e);
+    freed = 0;
+
+    return;
+}
+
+
+
+static void _teardown() {
+
+    cm_del_epoch(&e);
+
+    return;
+}
+
+
+
+/*
+ *  --- [UNIT TESTS] ---
+ */
+
+//cm_new_epoch() & cm_del_epoch() [no fixture]
+START_TEST(test_new_del_epoch) {
+
+    int ret;
+    cm_epoch u;
+
+
+    //only test: create a domain & destroy it
+    ret = cm_new_epoch(&u);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(u.global, 0);
+    ck_assert_ptr_null(u.thrs);
+    ck_assert_ptr_eq(u.hook.ctx, &u);
+    ck_assert(u.is_init);
+
+    cm_del_epoch(&u);
+    ck_assert(!u.is_init);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_epoch_reg(), cm_epoch_pin() & cm_epoch_unpin() [epoch fixture]
+START_TEST(test_epoch_reg_pin) {
+
+    int ret;
+    cm_epoch_thr a, b;
+
+
+    //first test: register two records
+    ret = cm_epoch_reg(&e, &a);
+    ck_assert_int_eq(ret, 0);
+    ret = cm_epoch_reg(&e, &b);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_ptr_eq(e.thrs, &b);
+    ck_assert_ptr_eq(b.next, &a);
+
+    //second test: pins nest
+    cm_epoch_pin(&a);
+    cm_epoch_pin(&a);
+    ck_assert_int_eq(a.local, EPOCH_PINNED);
+    cm_epoch_unpin(&a);
+    ck_assert_int_eq(a.local, EPOCH_PINNED);
+    cm_epoch_unpin(&a);
+    ck_assert_int_eq(a.local, 0);
+
+    //third test: a pin in an old epoch holds the global epoch back
+    cm_epoch_pin(&b);
+    cm_epoch_rcl(&a);
+    ck_assert_int_eq(e.global, 1);
+    cm_epoch_rcl(&a);
+    ck_assert_int_eq(e.global, 1);
+    cm_epoch_unpin(&b);
+    cm_epoch_rcl(&a);
+    ck_assert_int_eq(e.global, 2);
+
+    //fourth test: unregister
+    cm_epoch_unreg(&b);
+    ck_assert_ptr_eq(e.thrs, &a);
+    cm_epoch_unreg(&a);
+    ck_assert_ptr_null(e.thrs);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_epoch_rtr() & cm_epoch_rcl() [epoch fixture]
+START_TEST(test_epoch_rtr_rcl) {
+
+    int ret;
+    cm_epoch_thr a, b;
+
+
+    ret = cm_epoch_reg(&e, &a);
+    ck_assert_int_eq(ret, 0);
+    ret = cm_epoch_reg(&e, &b);
+    ck_assert_int_eq(ret, 0);
+
+    //first test: nothing is freed while another thread is pinned
+    cm_epoch_pin(&b);
+    for (int i = 0; i < 10; ++i) cm_epoch_rtr(&a, malloc(sizeof(int)),
+                                              _count_del);
+    for (int i = 0; i < 4; ++i) cm_epoch_rcl(&a);
+    ck_assert_int_eq(freed, 0);
+    ck_assert_int_eq(a.retired.len, 10);
+
+    //second test: everything is freed two epochs after the retire
+    cm_epoch_unpin(&b);
+    cm_epoch_rcl(&a);
+    ck_assert_int_eq(freed, 10);
+    ck_assert_int_eq(a.retired.len, 0);
+
+    //third test: a full batch reclaims on its own
+    for (int i = 0; i < EPOCH_BATCH * 3; ++i) {
+        cm_epoch_rtr(&a, malloc(sizeof(int)), _count_del);
+    }
+    ck_assert_int_gt(freed, 10);
+    ck_assert_int_le(a.retired.len, EPOCH_BATCH);
+
+    //fourth test: pending pointers move to the domain on unregister
+    ret = a.retired.len;
+    cm_epoch_unreg(&a);
+    ck_assert_int_eq(e.orphans.len, ret);
+    cm_epoch_unreg(&b);
+
+    //fifth test: the domain frees them when destroyed
+    cm_del_epoch(&e);
+    ck_assert_int_eq(freed, 10 + EPOCH_BATCH * 3);
+    cm_new_epoch(&e);
+
+    return;
+
+} END_TEST
+
+
+
+//del_hook of lists & trees [epoch fixture]
+START_TEST(test_epoch_hook) {
+
+    int ret, data;
+    cm_lst l;
+    cm_rbt t;
+    cm_epoch_thr a;
+
+
+    cm_new_lst(&l, sizeof(int));
+    cm_new_rbt(&t, sizeof(int), sizeof(int), _compare);
+    l.del_hook = &e.hook;
+    t.del_hook = &e.hook;
+
+    for (data = 0; data < 8; ++data) {
+        cm_lst_apd(&l, &data);
+        cm_rbt_set(&t, &data, &data);
+    }
+
+    //first test: unregistered threads retire into the domain
+    cm_lst_rmv(&l, 0);
+    data = 0;
+    cm_rbt_rmv(&t, &data);
+    ck_assert_int_eq(e.orphans.len, 2);
+
+    //second test: registered threads retire into their own record
+    ret = cm_epoch_reg(&e, &a);
+    ck_assert_int_eq(ret, 0);
+    cm_lst_rmv(&l, 0);
+    data = 1;
+    cm_rbt_rmv(&t, &data);
+    ck_assert_int_eq(a.retired.len, 2);
+    ck_assert_int_eq(e.orphans.len, 2);
+
+    //third test: reclaim both
+    cm_epoch_rcl(&a);
+    cm_epoch_rcl(&a);
+    ck_assert_int_eq(a.retired.len, 0);
+    ck_assert_int_eq(e.orphans.len, 0);
+
+    //fourth test: destroyed containers retire their remaining nodes
+    cm_del_lst(&l);
+    cm_del_rbt(&t);
+    ck_assert_int_eq(a.retired.len, 6 + 6);
+
+    cm_epoch_unreg(&a);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_epoch_*() with concurrent readers [epoch fixture]
+START_TEST(test_epoch_threads) {
+
+    int ret;
+    int * shared, * old;
+    bool stop;
+    cm_epoch_thr thr;
+    pthread_t readers[EPOCH_READERS];
+    struct _reader_arg args[EPOCH_READERS];
+
+
+    shared = malloc(sizeof(int));
+    *shared = 0;
+    stop = false;
+
+    for (int i = 0; i < EPOCH_READERS; ++i) {
+        args[i].shared = &shared;
+        args[i].stop   = &stop;
+        ret = pthread_create(&readers[i], NULL, _reader, &args[i]);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    ret = cm_epoch_reg(&e, &thr);
+    ck_assert_int_eq(ret, 0);
+
+    //only test: readers never see a freed value
+    for (int r = 1; r <= EPOCH_ROUNDS; ++r) {
+
+        old = malloc(sizeof(int));
+        *old = r;
+        old = __atomic_exchange_n(&shared, old, __ATOMIC_ACQ_REL);
+
+        cm_epoch_rtr(&thr, old, _count_del);
+        if (r % 16 == 0) sched_yield();
+    }
+
+    __atomic_store_n(&stop, true, __ATOMIC_RELAXED);
+    for (int i = 0; i < EPOCH_READERS; ++i) {
+        pthread_join(readers[i], NULL);
+        ck_assert(args[i].valid);
+    }
+
+    cm_epoch_rcl(&thr);
+    cm_epoch_rcl(&thr);
+    ck_assert_int_eq(freed, EPOCH_ROUNDS);
+
+    cm_epoch_unreg(&thr);
+    free(shared);
+
+    return;
+
+} END_TEST
+
+
+
+/*
+ *  --- [SUITE] ---
+ */
+
+Suite * epoch_suite() {
+
+    //test cases
+    TCase * tc_new_del_epoch;
+    TCase * tc_epoch_reg_pin;
+    TCase * tc_epoch_rtr_rcl;
+    TCase * tc_epoch_hook;
+    TCase * tc_epoch_threads;
+
+    Suite * s = suite_create("epoch");
+
+
+    //cm_new_epoch()
+    tc_new_del_epoch = tcase_create("new_del_epoch");
+    tcase_add_test(tc_new_del_epoch, test_new_del_epoch);
+
+    //cm_epoch_reg(), cm_epoch_pin() & cm_epoch_unpin()
+    tc_epoch_reg_pin = tcase_create("epoch_reg_pin");
+    tcase_add_checked_fixture(tc_epoch_reg_pin, _setup, _teardown);
+    tcase_add_test(tc_epoch_reg_pin, test_epoch_reg_pin);
+
+    //cm_epoch_rtr() & cm_epoch_rcl()
+    tc_epoch_rtr_rcl = tcase_create("epoch_rtr_rcl");
+    tcase_add_checked_fixture(tc_epoch_rtr_rcl, _setup, _teardown);
+    tcase_add_test(tc_epoch_rtr_rcl, test_epoch_rtr_rcl);
+
+    //del_hook of lists & trees
+    tc_epoch_hook = tcase_create("epoch_hook");
+    tcase_add_checked_fixture(tc_epoch_hook, _setup, _teardown);
+    tcase_add_test(tc_epoch_hook, test_epoch_hook);
+
+    //concurrent readers
+    tc_epoch_threads = tcase_create("epoch_threads");
+    tcase_add_checked_fixture(tc_epoch_threads, _setup, _teardown);
+    tcase_set_timeout(tc_epoch_threads, 60);
+    tcase_add_test(tc_epoch_threads, test_epoch_threads);
+
+    //add test cases to epoch suite
+    suite_add_tcase(s, tc_new_del_epoch);
+    suite_add_tcase(s, tc_epoch_reg_pin);
+    suite_add_tcase(s, tc_epoch_rtr_rcl);
+    suite_add_tcase(s, tc_epoch_hook);
+    suite_add_tcase(s, tc_epoch_threads);
+
+    return s;
+}
@@ -1,5 +1,9 @@
 //standard library
 #include <stdint.h>
+#include <string.h>
+
+//system headers
+#include <unistd.h>
 
 //external libraries
 #include <check.h>
@@ -32,6 +36,7 @@ enum type_table {
 void * void_ctx = (void *) 0x1337; 
 
 static cm_monad m;
+static int stage_calls;
 
 
 
@@ -86,6 +91,59 @@ static cm_meta_type * _set_type_fail(cm_meta_type * value, void * ctx) {
 
 
 
+static cm_meta_type * _upd_type_b(cm_meta_type * value, void * ctx) {
+
+    int ret;
+    const long primitive_value = 0;
+
+    ret = cm_meta_type_upd(value, TYPE_B,
+                           &primitive_value, sizeof(primitive_value));
+    ck_assert_int_eq(ret, 0);
+    ck_assert_ptr_eq(ctx, void_ctx); /* use ctx to suppress warning */
+
+    return value;
+}
+
+
+
+static cm_meta_type * _count_add_one(cm_meta_type * value, void * ctx) {
+
+    ++stage_calls;
+
+    return _add_one(value, ctx);
+}
+
+
+
+static cm_meta_type * _fail_odd(cm_meta_type * value, void * ctx) {
+
+    if (*(int *) value->data % 2 == 1) value->type_id = CM_MONAD_FAIL_TYPE;
+    ck_assert_ptr_eq(ctx, void_ctx); /* use ctx to suppress warning */
+
+    return value;
+}
+
+
+
+static cm_meta_type * _new_type_b(cm_meta_type * value, void * ctx) {
+
+    long * scratch;
+    cm_meta_type * new_value;
+
+
+    scratch = cm_monad_alloc(sizeof(*scratch));
+    ck_assert_ptr_nonnull(scratch);
+    *scratch = *(int *) value->data + 1;
+
+    new_value = cm_monad_new_meta_type(TYPE_B, scratch, sizeof(*scratch));
+    ck_assert_ptr_nonnull(new_value);
+    ck_assert_ptr_eq(ctx, void_ctx); /* use ctx to suppress warning */
+
+    return new_value;
+}
+
+
+
 /*
  *  --- [FIXTURES] ---
  */
@@ -218,6 +276,41 @@ START_TEST(test_meta_type_cpy) {
 
 
 
+//cm_meta_type_view() [no fixture]
+START_TEST(test_meta_type_view) {
+
+    int ret;
+    int primitive_value = 8086;
+    const long long_value = -1;
+
+
+    //first test: borrow a value
+    cm_meta_type_view(&t, TYPE_A, &primitive_value, sizeof(primitive_value));
+    _assert_meta_type(&t, &primitive_value,
+                      sizeof(primitive_value), (int) TYPE_A, true);
+    ck_assert_ptr_eq(t.data, &primitive_value);
+    ck_assert_int_eq(t.is_view, true);
+
+    //second test: resizing a view allocates storage of its own
+    ret = cm_meta_type_upd(&t, TYPE_B, &long_value, sizeof(long_value));
+    ck_assert_int_eq(ret, 0);
+    ck_assert_ptr_ne(t.data, &primitive_value);
+    ck_assert_int_eq(t.is_view, false);
+    ck_assert_int_eq(primitive_value, 8086);
+
+    cm_del_meta_type(&t);
+
+    //third test: deleting a view leaves the borrowed data alone
+    cm_meta_type_view(&t, TYPE_A, &primitive_value, sizeof(primitive_value));
+    cm_del_meta_type(&t);
+    ck_assert_int_eq(t.is_init, false);
+
+    return;
+
+} END_TEST
+
+
+
 //cm_new_del_monad() [no fixture]
 START_TEST(test_new_del_monad) {
 
@@ -298,6 +391,398 @@ START_TEST(test_monad_eval) {
 
 
 
+//cm_monad_prof_*() [monad fixture]
+START_TEST(test_monad_prof) {
+
+    int ret;
+    int fds[2];
+    char buf[512];
+    const char * json_prefix;
+    cm_monad_stat stat;
+
+
+    //first test: profiling is disabled by default
+    ret = cm_monad_prof_get(&m, 0, &stat);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARG);
+
+    //second test: stages composed before & after enabling are tracked
+    ret = cm_monad_compose(&m, _add_one);
+    ck_assert_int_eq(ret, 0);
+
+    ret = cm_monad_prof_on(&m);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(m.stats.len, 1);
+
+    ret = cm_monad_compose(&m, _upd_type_b);
+    ck_assert_int_eq(ret, 0);
+    ret = cm_monad_compose(&m, _set_type_fail);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(m.stats.len, 3);
+
+    //third test: evaluate twice, failing in the last stage
+    for (int i = 0; i < 2; ++i) {
+        ret = cm_monad_eval(&m, &t, void_ctx);
+        ck_assert_int_eq(ret, -1);
+        t.type_id = TYPE_A;
+    }
+
+    ret = cm_monad_prof_get(&m, 0, &stat);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(stat.calls, 2);
+    ck_assert_int_eq(stat.fails, 0);
+    ck_assert_int_eq(stat.reallocs, 0);
+
+    ret = cm_monad_prof_get(&m, 1, &stat);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(stat.calls, 2);
+    ck_assert_int_eq(stat.fails, 0);
+    ck_assert_int_eq(stat.reallocs, 2);
+
+    ret = cm_monad_prof_get(&m, -1, &stat);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(stat.calls, 2);
+    ck_assert_int_eq(stat.fails, 2);
+
+    //fourth test: dump as JSON
+    ret = pipe(fds);
+    ck_assert_int_eq(ret, 0);
+
+    ret = cm_monad_prof_dump(&m, fds[1], CM_MONAD_FMT_JSON);
+    ck_assert_int_eq(ret, 0);
+
+    memset(buf, 0, sizeof(buf));
+    ret = read(fds[0], buf, sizeof(buf) - 1);
+    ck_assert_int_gt(ret, 0);
+    json_prefix = "{\"stages\": [{\"stage\": 0, \"calls\": 2,";
+    ck_assert(strncmp(buf, json_prefix, strlen(json_prefix)) == 0);
+
+    //fifth test: dump as text, one line per stage plus a header
+    ret = cm_monad_prof_dump(&m, fds[1], CM_MONAD_FMT_TEXT);
+    ck_assert_int_eq(ret, 0);
+
+    memset(buf, 0, sizeof(buf));
+    ret = read(fds[0], buf, sizeof(buf) - 1);
+    ck_assert_int_gt(ret, 0);
+    ret = 0;
+    for (char * c = buf; *c != '\0'; ++c) if (*c == '\n') ++ret;
+    ck_assert_int_eq(ret, 4);
+
+    close(fds[0]);
+    close(fds[1]);
+
+    //sixth test: reset, then disable
+    cm_monad_prof_rst(&m);
+    ret = cm_monad_prof_get(&m, 1, &stat);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(stat.calls, 0);
+    ck_assert_int_eq(stat.reallocs, 0);
+
+    cm_monad_prof_off(&m);
+    ck_assert_int_eq(m.is_prof, false);
+    ret = cm_monad_eval(&m, &t, void_ctx);
+    ck_assert_int_eq(ret, -1);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_monad_cache_*() [monad fixture]
+START_TEST(test_monad_cache) {
+
+    int ret;
+    cm_monad_cache_stat stat;
+
+    const int inputs[6]   = {0, 0, 5, 7, 0, 5};
+    const int hits[6]     = {0, 1, 1, 1, 2, 2};
+    const int evicts[6]   = {0, 0, 0, 1, 1, 2};
+
+
+    //first test: caching is disabled by default
+    ret = cm_monad_cache_get(&m, &stat);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARG);
+
+    //second test: enable a two slot cache
+    ret = cm_monad_compose(&m, _count_add_one);
+    ck_assert_int_eq(ret, 0);
+
+    ret = cm_monad_cache_on(&m, 0);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARG);
+
+    ret = cm_monad_cache_on(&m, 2);
+    ck_assert_int_eq(ret, 0);
+
+    /*
+     *  Third test: evaluate a sequence of inputs. Input 0 is hit, so CLOCK
+     *  gives it a second chance and evicts the other slot instead.
+     */
+
+    stage_calls = 0;
+    for (int i = 0; i < 6; ++i) {
+
+        *(int *) t.data = inputs[i];
+        ret = cm_monad_eval(&m, &t, void_ctx);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(*(int *) t.data, inputs[i] + 1);
+
+        ret = cm_monad_cache_get(&m, &stat);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(stat.hits, hits[i]);
+        ck_assert_int_eq(stat.misses, i + 1 - hits[i]);
+        ck_assert_int_eq(stat.evictions, evicts[i]);
+        ck_assert_int_eq(stage_calls, i + 1 - hits[i]);
+    }
+
+    //fourth test: inputs of a different type do not hit
+    *(int *) t.data = 0;
+    t.type_id = TYPE_B;
+    ret = cm_monad_eval(&m, &t, void_ctx);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(stage_calls, 5);
+    t.type_id = TYPE_A;
+
+    //fifth test: composing invalidates cached results
+    ret = cm_monad_compose(&m, _add_one);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(m.cache.len, 0);
+
+    *(int *) t.data = 0;
+    ret = cm_monad_eval(&m, &t, void_ctx);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(*(int *) t.data, 2);
+    ck_assert_int_eq(stage_calls, 6);
+
+    //sixth test: failed evaluations are cached too
+    ret = cm_monad_compose(&m, _set_type_fail);
+    ck_assert_int_eq(ret, 0);
+
+    for (int i = 0; i < 2; ++i) {
+        *(int *) t.data = 0;
+        t.type_id = TYPE_A;
+        ret = cm_monad_eval(&m, &t, void_ctx);
+        ck_assert_int_eq(ret, -1);
+        ck_assert_int_eq(t.type_id, CM_MONAD_FAIL_TYPE);
+    }
+    ck_assert_int_eq(stage_calls, 7);
+
+    //seventh test: disable
+    cm_monad_cache_off(&m);
+    ck_assert_int_eq(m.is_cache, false);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_monad_eval_fd() [monad fixture]
+START_TEST(test_monad_eval_fd) {
+
+    int ret;
+    ssize_t records;
+    int in_fds[2], out_fds[2];
+    
+    int in[100], out[100];
+    long long_out[100];
+    const char partial[2] = {0, 0};
+
+
+    for (int i = 0; i < 100; ++i) in[i] = i;
+
+    //first test: evaluate every record
+    ret = cm_monad_compose(&m, _add_one);
+    ck_assert_int_eq(ret, 0);
+
+    ret = pipe(in_fds);
+    ck_assert_int_eq(ret, 0);
+    ret = pipe(out_fds);
+    ck_assert_int_eq(ret, 0);
+
+    ret = write(in_fds[1], in, sizeof(in));
+    ck_assert_int_eq(ret, sizeof(in));
+    close(in_fds[1]);
+
+    records = cm_monad_eval_fd(&m, in_fds[0], out_fds[1],
+                               TYPE_A, sizeof(int), void_ctx);
+    ck_assert_int_eq(records, 100);
+    close(in_fds[0]);
+
+    ret = read(out_fds[0], out, sizeof(out));
+    ck_assert_int_eq(ret, sizeof(out));
+    for (int i = 0; i < 100; ++i) ck_assert_int_eq(out[i], i + 1);
+
+    //second test: skip records that fail
+    ret = cm_monad_compose(&m, _fail_odd);
+    ck_assert_int_eq(ret, 0);
+
+    ret = pipe(in_fds);
+    ck_assert_int_eq(ret, 0);
+
+    ret = write(in_fds[1], in, sizeof(in));
+    ck_assert_int_eq(ret, sizeof(in));
+    close(in_fds[1]);
+
+    records = cm_monad_eval_fd(&m, in_fds[0], out_fds[1],
+                               TYPE_A, sizeof(int), void_ctx);
+    ck_assert_int_eq(records, 50);
+    close(in_fds[0]);
+
+    ret = read(out_fds[0], out, sizeof(out));
+    ck_assert_int_eq(ret, sizeof(out) / 2);
+    for (int i = 0; i < 50; ++i) ck_assert_int_eq(out[i], (i * 2) + 2);
+
+    //third test: stages that resize a record
+    ret = cm_monad_compose(&m, _upd_type_b);
+    ck_assert_int_eq(ret, 0);
+
+    ret = pipe(in_fds);
+    ck_assert_int_eq(ret, 0);
+
+    ret = write(in_fds[1], in, sizeof(in));
+    ck_assert_int_eq(ret, sizeof(in));
+    close(in_fds[1]);
+
+    records = cm_monad_eval_fd(&m, in_fds[0], out_fds[1],
+                               TYPE_A, sizeof(int), void_ctx);
+    ck_assert_int_eq(records, 50);
+    close(in_fds[0]);
+
+    ret = read(out_fds[0], long_out, sizeof(long_out));
+    ck_assert_int_eq(ret, sizeof(long_out) / 2);
+    for (int i = 0; i < 50; ++i) ck_assert_int_eq(long_out[i], 0);
+
+    //fourth test: input ends partway through a record
+    ret = pipe(in_fds);
+    ck_assert_int_eq(ret, 0);
+
+    ret = write(in_fds[1], in, sizeof(int) * 2);
+    ck_assert_int_eq(ret, sizeof(int) * 2);
+    ret = write(in_fds[1], partial, sizeof(partial));
+    ck_assert_int_eq(ret, sizeof(partial));
+    close(in_fds[1]);
+
+    records = cm_monad_eval_fd(&m, in_fds[0], out_fds[1],
+                               TYPE_A, sizeof(int), void_ctx);
+    ck_assert_int_eq(records, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_TRUNC);
+    close(in_fds[0]);
+
+    //fifth test: records must have a size
+    records = cm_monad_eval_fd(&m, out_fds[0], out_fds[1],
+                               TYPE_A, 0, void_ctx);
+    ck_assert_int_eq(records, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARG);
+
+    close(out_fds[0]);
+    close(out_fds[1]);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_monad_set_arena(), cm_monad_new_meta_type() & cm_monad_alloc()
+START_TEST(test_monad_arena) {
+
+    int ret;
+    ssize_t records;
+    int in_fds[2], out_fds[2];
+
+    int data, in[10];
+    long long_out[10];
+    cm_arena a;
+    cm_meta_type v;
+    
+
+    ret = cm_new_arena(&a, 64);
+    ck_assert_int_eq(ret, 0);
+
+    //first test: arena allocations outside of an evaluation
+    ck_assert_ptr_null(cm_monad_alloc(sizeof(int)));
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARENA);
+    ck_assert_ptr_null(cm_monad_new_meta_type(TYPE_A, &data, sizeof(data)));
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARENA);
+
+    //second test: a stage returns a new meta type
+    cm_monad_set_arena(&m, &a);
+    ret = cm_monad_compose(&m, _add_one);
+    ck_assert_int_eq(ret, 0);
+    ret = cm_monad_compose(&m, _new_type_b);
+    ck_assert_int_eq(ret, 0);
+
+    ret = cm_monad_eval(&m, &t, void_ctx);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(t.type_id, TYPE_B);
+    ck_assert_int_eq(t.sz, sizeof(long));
+    ck_assert_int_eq(*(long *) t.data, 2);
+    ck_assert_int_eq(t.is_view, false);
+
+    //arena was reset
+    ck_assert_ptr_eq(a.cur, a.head);
+    ck_assert_int_eq(a.off, 0);
+
+    //third test: a view is resized inside the arena
+    cm_del_monad(&m);
+    cm_new_monad(&m);
+    cm_monad_set_arena(&m, &a);
+    ret = cm_monad_compose(&m, _upd_type_b);
+    ck_assert_int_eq(ret, 0);
+
+    data = 5;
+    cm_meta_type_view(&v, TYPE_A, &data, sizeof(data));
+    ret = cm_monad_eval(&m, &v, void_ctx);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(v.type_id, TYPE_B);
+    ck_assert_int_eq(v.sz, sizeof(long));
+    ck_assert_int_eq(*(long *) v.data, 0);
+    ck_assert_int_eq(v.is_view, false);
+    ck_assert_int_eq(data, 5);
+    cm_del_meta_type(&v);
+
+    //fourth test: stream records through arena stages
+    cm_del_monad(&m);
+    cm_new_monad(&m);
+    cm_monad_set_arena(&m, &a);
+    ret = cm_monad_compose(&m, _new_type_b);
+    ck_assert_int_eq(ret, 0);
+
+    for (int i = 0; i < 10; ++i) in[i] = i;
+
+    ret = pipe(in_fds);
+    ck_assert_int_eq(ret, 0);
+    ret = pipe(out_fds);
+    ck_assert_int_eq(ret, 0);
+
+    ret = write(in_fds[1], in, sizeof(in));
+    ck_assert_int_eq(ret, sizeof(in));
+    close(in_fds[1]);
+
+    records = cm_monad_eval_fd(&m, in_fds[0], out_fds[1],
+                               TYPE_A, sizeof(int), void_ctx);
+    ck_assert_int_eq(records, 10);
+    close(in_fds[0]);
+
+    ret = read(out_fds[0], long_out, sizeof(long_out));
+    ck_assert_int_eq(ret, sizeof(long_out));
+    for (int i = 0; i < 10; ++i) ck_assert_int_eq(long_out[i], i + 1);
+    ck_assert_int_eq(a.off, 0);
+
+    close(out_fds[0]);
+    close(out_fds[1]);
+
+    cm_del_arena(&a);
+
+    return;
+
+} END_TEST
+
+
+
 /*
  *  --- [SUITE] ---
  */
@@ -309,10 +794,15 @@ Suite * func_suite() {
     TCase * tc_meta_type_set;
     TCase * tc_meta_type_upd;
     TCase * tc_meta_type_cpy;
+    TCase * tc_meta_type_view;
     
     TCase * tc_new_del_monad;
     TCase * tc_monad_compose;
     TCase * tc_monad_eval;
+    TCase * tc_monad_prof;
+    TCase * tc_monad_cache;
+    TCase * tc_monad_eval_fd;
+    TCase * tc_monad_arena;
 
     Suite * s = suite_create("functional");
 
@@ -339,6 +829,10 @@ Suite * func_suite() {
                               _setup_meta_type, _teardown_meta_type);
     tcase_add_test(tc_meta_type_cpy, test_meta_type_cpy);
 
+    //cm_meta_type_view()
+    tc_meta_type_view = tcase_create("meta_type_view");
+    tcase_add_test(tc_meta_type_view, test_meta_type_view);
+
 
     //cm_new_monad()
     tc_new_del_monad = tcase_create("new_del_monad");
@@ -356,16 +850,45 @@ Suite * func_suite() {
                               _setup_monad, _teardown_monad);
     tcase_add_test(tc_monad_eval, test_monad_eval);
 
+    //cm_monad_prof_*()
+    tc_monad_prof = tcase_create("monad_prof");
+    tcase_add_checked_fixture(tc_monad_prof,
+                              _setup_monad, _teardown_monad);
+    tcase_add_test(tc_monad_prof, test_monad_prof);
+
+    //cm_monad_cache_*()
+    tc_monad_cache = tcase_create("monad_cache");
+    tcase_add_checked_fixture(tc_monad_cache,
+                              _setup_monad, _teardown_monad);
+    tcase_add_test(tc_monad_cache, test_monad_cache);
+
+    //cm_monad_eval_fd()
+    tc_monad_eval_fd = tcase_create("monad_eval_fd");
+    tcase_add_checked_fixture(tc_monad_eval_fd,
+                              _setup_monad, _teardown_monad);
+    tcase_add_test(tc_monad_eval_fd, test_monad_eval_fd);
+
+    //cm_monad_set_arena()
+    tc_monad_arena = tcase_create("monad_arena");
+    tcase_add_checked_fixture(tc_monad_arena,
+                              _setup_monad, _teardown_monad);
+    tcase_add_test(tc_monad_arena, test_monad_arena);
+
 
     //add test cases to functional suite
     suite_add_tcase(s, tc_new_del_meta_type);
     suite_add_tcase(s, tc_meta_type_set);
     suite_add_tcase(s, tc_meta_type_upd);
     suite_add_tcase(s, tc_meta_type_cpy);
+    suite_add_tcase(s, tc_meta_type_view);
 
     suite_add_tcase(s, tc_new_del_monad);
     suite_add_tcase(s, tc_monad_compose);
     suite_add_tcase(s, tc_monad_eval);
+    suite_add_tcase(s, tc_monad_prof);
+    suite_add_tcase(s, tc_monad_cache);
+    suite_add_tcase(s, tc_monad_eval_fd);
+    suite_add_tcase(s, tc_monad_arena);
 
     return s;
 }
@@ -0,0 +1,602 @@
+//standard library
+#include <stdint.h>
+#include <string.h>
+
+//external libraries
+#include <check.h>
+
+//local headers
+#include "suites.h"
+
+//test target headers
+#include "../lib/cmore.h"
+#include "../lib/heap.h"
+
+
+
+/*
+ *  [BASIC TEST]
+ *
+ *     Heaps are simple; internal functions 
+ *     are tested through exported functions.
+ */
+
+
+
+//globals
+static cm_heap h;
+static cm_iheap ih;
+
+//arities to repeat tests with
+static const int arities[] = {2, 3, 4, 8};
+#define ARITIES_NUM (sizeof(arities) / sizeof(arities[0]))
+#define HEAP_LEN 200
+
+
+
+/*
+ *  --- [HELPERS] ---
+ */
+
+static enum cm_rbt_side _compare(const void * key_0, const void * key_1) {
+
+    int a = *(const int *) key_0;
+    int b = *(const int *) key_1;
+
+    if (a < b) return CM_RBT_LESS;
+    if (a > b) return CM_RBT_MORE;
+    return CM_RBT_EQUAL;
+}
+
+
+
+//deterministic pseudo-random values with duplicates
+static int _value(const int i) {
+
+    return (int) (((uint32_t) i * 2654435761u) >> 24) - 128;
+}
+
+
+
+//assert every node is not below its parent
+static void _assert_heap(const cm_heap * heap) {
+
+    int * arr = heap->data.data;
+
+    for (int i = 1; i < heap->data.len; ++i) {
+        ck_assert_int_le(arr[(i - 1) / heap->arity], arr[i]);
+    }
+
+    return;
+}
+
+
+
+//pop every element & assert they come out in order
+static void _assert_drain(cm_heap * heap, const int len) {
+
+    int ret, prev, value;
+
+    ck_assert_int_eq(heap->data.len, len);
+
+    prev = INT32_MIN;
+    for (int i = 0; i < len; ++i) {
+
+        ret = cm_heap_pop(heap, &value);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_le(prev, value);
+        prev = value;
+    }
+
+    ck_assert_int_eq(heap->data.len, 0);
+
+    return;
+}
+
+
+
+//assert the indexed heap's order & that positions match the order
+static void _assert_iheap(const cm_iheap * iheap) {
+
+    int * order = iheap->order.data;
+    int * pos   = iheap->pos.data;
+    int * arr   = iheap->data.data;
+
+    for (int i = 0; i < iheap->order.len; ++i) {
+        ck_assert_int_eq(pos[order[i]], i);
+        if (i > 0) {
+            ck_assert_int_le(arr[order[(i - 1) / iheap->arity]],
+                             arr[order[i]]);
+        }
+    }
+
+    return;
+}
+
+
+
+/*
+ *  --- [UNIT TESTS] ---
+ */
+
+//cm_new_heap() & cm_del_heap() [no fixture]
+START_TEST(test_new_del_heap) {
+
+    int ret;
+
+
+    //first test: create & destroy a heap
+    ret = cm_new_heap(&h, sizeof(int), 4, _compare);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(h.data.len, 0);
+    ck_assert_int_eq(h.arity, 4);
+    ck_assert_int_eq(h.is_init, true);
+
+    cm_del_heap(&h);
+    ck_assert_int_eq(h.is_init, false);
+
+    //second test: arity is too small
+    ret = cm_new_heap(&h, sizeof(int), 1, _compare);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARG);
+
+    return;
+    
+} END_TEST
+
+
+
+//cm_heap_psh() & cm_heap_pop() [no fixture]
+START_TEST(test_heap_psh_pop) {
+
+    int ret, value;
+
+
+    for (size_t a = 0; a < ARITIES_NUM; ++a) {
+
+        ret = cm_new_heap(&h, sizeof(int), arities[a], _compare);
+        ck_assert_int_eq(ret, 0);
+
+        //first test: pop from an empty heap
+        ret = cm_heap_pop(&h, &value);
+        ck_assert_int_eq(ret, -1);
+        ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+        //second test: push, then pop everything in order
+        for (int i = 0; i < HEAP_LEN; ++i) {
+            value = _value(i);
+            ret = cm_heap_psh(&h, &value);
+            ck_assert_int_eq(ret, 0);
+            _assert_heap(&h);
+        }
+        _assert_drain(&h, HEAP_LEN);
+
+        //third test: interleave pushes & pops, discarding popped values
+        for (int i = 0; i < HEAP_LEN; ++i) {
+            value = _value(i);
+            ret = cm_heap_psh(&h, &value);
+            ck_assert_int_eq(ret, 0);
+            if (i % 3 == 0) {
+                ret = cm_heap_pop(&h, NULL);
+                ck_assert_int_eq(ret, 0);
+            }
+            _assert_heap(&h);
+        }
+        _assert_drain(&h, HEAP_LEN - ((HEAP_LEN + 2) / 3));
+
+        cm_del_heap(&h);
+    }
+
+    return;
+
+} END_TEST
+
+
+
+//cm_heap_pek() & cm_heap_pek_p() [no fixture]
+START_TEST(test_heap_pek) {
+
+    int ret, value;
+    int * value_p;
+
+
+    ret = cm_new_heap(&h, sizeof(int), 2, _compare);
+    ck_assert_int_eq(ret, 0);
+
+    //first test: peek into an empty heap
+    ret = cm_heap_pek(&h, &value);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+    value_p = cm_heap_pek_p(&h);
+    ck_assert_ptr_null(value_p);
+
+    //second test: peek at the minimum
+    for (int i = 10; i > 0; --i) {
+        ret = cm_heap_psh(&h, &i);
+        ck_assert_int_eq(ret, 0);
+
+        ret = cm_heap_pek(&h, &value);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(value, i);
+
+        value_p = cm_heap_pek_p(&h);
+        ck_assert_int_eq(*value_p, i);
+    }
+    ck_assert_int_eq(h.data.len, 10);
+
+    cm_del_heap(&h);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_heap_rpl() [no fixture]
+START_TEST(test_heap_rpl) {
+
+    int ret, value, top;
+
+
+    ret = cm_new_heap(&h, sizeof(int), 3, _compare);
+    ck_assert_int_eq(ret, 0);
+
+    //first test: replace in an empty heap
+    value = 0;
+    ret = cm_heap_rpl(&h, &value, &top);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    for (int i = 0; i < HEAP_LEN; ++i) {
+        value = _value(i);
+        ret = cm_heap_psh(&h, &value);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    //second test: replace the top with values that sink & that stay
+    for (int i = 0; i < HEAP_LEN; ++i) {
+
+        value = i % 2 == 0 ? 1000 + i : -1000;
+        ret = cm_heap_rpl(&h, &value, &top);
+        ck_assert_int_eq(ret, 0);
+        _assert_heap(&h);
+
+        //a value that stays on top is returned by the next replace
+        if (i % 2 == 1) ck_assert_int_eq(*(int *) cm_heap_pek_p(&h), -1000);
+    }
+
+    //third test: replace with the heap's own top element
+    ret = cm_heap_rpl(&h, cm_heap_pek_p(&h), NULL);
+    ck_assert_int_eq(ret, 0);
+    _assert_drain(&h, HEAP_LEN);
+
+    cm_del_heap(&h);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_new_heap_vct() [no fixture]
+START_TEST(test_new_heap_vct) {
+
+    int ret, value;
+    cm_vct v;
+
+
+    for (size_t a = 0; a < ARITIES_NUM; ++a) {
+
+        ret = cm_new_vct(&v, sizeof(int));
+        ck_assert_int_eq(ret, 0);
+        for (int i = 0; i < HEAP_LEN; ++i) {
+            value = _value(i);
+            ret = cm_vct_apd(&v, &value);
+            ck_assert_int_eq(ret, 0);
+        }
+
+        //first test: heapify a vector
+        ret = cm_new_heap_vct(&h, &v, arities[a], _compare);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(v.is_init, false);
+        _assert_heap(&h);
+        _assert_drain(&h, HEAP_LEN);
+
+        cm_del_heap(&h);
+    }
+
+    //second test: arity is too small, the vector is left intact
+    ret = cm_new_vct(&v, sizeof(int));
+    ck_assert_int_eq(ret, 0);
+
+    ret = cm_new_heap_vct(&h, &v, 0, _compare);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARG);
+    ck_assert_int_eq(v.is_init, true);
+
+    cm_del_vct(&v);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_heap_emp() [no fixture]
+START_TEST(test_heap_emp) {
+
+    int ret;
+
+
+    ret = cm_new_heap(&h, sizeof(int), 2, _compare);
+    ck_assert_int_eq(ret, 0);
+
+    for (int i = 0; i < 10; ++i) {
+        ret = cm_heap_psh(&h, &i);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    //only test: empty the heap
+    cm_heap_emp(&h);
+    ck_assert_int_eq(h.data.len, 0);
+    ck_assert_ptr_null(cm_heap_pek_p(&h));
+
+    cm_del_heap(&h);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_new_iheap() & cm_del_iheap() [no fixture]
+START_TEST(test_new_del_iheap) {
+
+    int ret;
+
+
+    //first test: create & destroy an indexed heap
+    ret = cm_new_iheap(&ih, sizeof(int), 2, _compare);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(ih.order.len, 0);
+    ck_assert_int_eq(ih.is_init, true);
+
+    cm_del_iheap(&ih);
+    ck_assert_int_eq(ih.is_init, false);
+
+    //second test: arity is too small
+    ret = cm_new_iheap(&ih, sizeof(int), 1, _compare);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARG);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_iheap_psh(), cm_iheap_pop(), cm_iheap_pek() & cm_iheap_get() [no fixture]
+START_TEST(test_iheap_psh_pop) {
+
+    int ret, value, handle, prev;
+    int handles[HEAP_LEN];
+
+
+    for (size_t a = 0; a < ARITIES_NUM; ++a) {
+
+        ret = cm_new_iheap(&ih, sizeof(int), arities[a], _compare);
+        ck_assert_int_eq(ret, 0);
+
+        //first test: pop & peek an empty heap
+        ck_assert_int_eq(cm_iheap_pop(&ih, &value), -1);
+        ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+        ck_assert_int_eq(cm_iheap_pek(&ih, &value), -1);
+
+        //second test: every push returns a distinct handle to its value
+        for (int i = 0; i < HEAP_LEN; ++i) {
+            value = _value(i);
+            handles[i] = cm_iheap_psh(&ih, &value);
+            ck_assert_int_eq(handles[i], i);
+            _assert_iheap(&ih);
+        }
+
+        for (int i = 0; i < HEAP_LEN; ++i) {
+            ret = cm_iheap_get(&ih, handles[i], &value);
+            ck_assert_int_eq(ret, 0);
+            ck_assert_int_eq(value, _value(i));
+            ck_assert_int_eq(*(int *) cm_iheap_get_p(&ih, handles[i]), 
+                             _value(i));
+        }
+
+        //third test: pop in order, popped handles become invalid
+        prev = INT32_MIN;
+        for (int i = 0; i < HEAP_LEN; ++i) {
+
+            handle = cm_iheap_pek(&ih, NULL);
+            ret = cm_iheap_pop(&ih, &value);
+            ck_assert_int_eq(ret, handle);
+            ck_assert_int_eq(value, _value(handle));
+            ck_assert_int_le(prev, value);
+            prev = value;
+
+            ck_assert_ptr_null(cm_iheap_get_p(&ih, handle));
+            ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+            _assert_iheap(&ih);
+        }
+
+        //fourth test: released handles are reused
+        value = 0;
+        handle = cm_iheap_psh(&ih, &value);
+        ck_assert_int_ge(handle, 0);
+        ck_assert_int_lt(handle, HEAP_LEN);
+        ck_assert_int_eq(ih.data.len, HEAP_LEN);
+
+        //fifth test: push an element's own storage while the heap grows
+        for (int i = 0; i < HEAP_LEN * 2; ++i) {
+            ret = cm_iheap_psh(&ih, cm_iheap_get_p(&ih, handle));
+            ck_assert_int_ge(ret, 0);
+            ck_assert_int_eq(*(int *) cm_iheap_get_p(&ih, ret), 0);
+        }
+        _assert_iheap(&ih);
+
+        cm_del_iheap(&ih);
+    }
+
+    return;
+
+} END_TEST
+
+
+
+//cm_iheap_upd() & cm_iheap_rmv() [no fixture]
+START_TEST(test_iheap_upd_rmv) {
+
+    int ret, value, handle, min;
+    int values[HEAP_LEN];
+    bool is_used[HEAP_LEN];
+
+
+    ret = cm_new_iheap(&ih, sizeof(int), 4, _compare);
+    ck_assert_int_eq(ret, 0);
+
+    for (int i = 0; i < HEAP_LEN; ++i) {
+        values[i] = _value(i);
+        is_used[i] = true;
+        handle = cm_iheap_psh(&ih, &values[i]);
+        ck_assert_int_eq(handle, i);
+    }
+
+    //first test: invalid handles
+    value = 0;
+    ck_assert_int_eq(cm_iheap_upd(&ih, -1, &value), -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+    ck_assert_int_eq(cm_iheap_upd(&ih, HEAP_LEN, &value), -1);
+    ck_assert_int_eq(cm_iheap_rmv(&ih, HEAP_LEN), -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    //second test: decrease, increase & remove against a model
+    for (int i = 0; i < HEAP_LEN * 4; ++i) {
+
+        handle = (i * 37) % HEAP_LEN;
+
+        if (!is_used[handle]) {
+            ck_assert_int_eq(cm_iheap_rmv(&ih, handle), -1);
+            continue;
+        }
+
+        if (i % 5 == 4) {
+            ret = cm_iheap_rmv(&ih, handle);
+            ck_assert_int_eq(ret, 0);
+            is_used[handle] = false;
+        } else {
+            values[handle] += i % 2 == 0 ? -_value(i) - 200 : _value(i) + 200;
+            ret = cm_iheap_upd(&ih, handle, &values[handle]);
+            ck_assert_int_eq(ret, 0);
+        }
+        _assert_iheap(&ih);
+
+        //the top must be the model's minimum
+        min = INT32_MAX;
+        for (int j = 0; j < HEAP_LEN; ++j) {
+            if (is_used[j] && values[j] < min) min = values[j];
+        }
+        if (ih.order.len > 0) {
+            ret = cm_iheap_pek(&ih, &value);
+            ck_assert_int_ge(ret, 0);
+            ck_assert_int_eq(value, min);
+        }
+    }
+
+    //third test: update with the element's own storage
+    handle = cm_iheap_pek(&ih, NULL);
+    ret = cm_iheap_upd(&ih, handle, cm_iheap_get_p(&ih, handle));
+    ck_assert_int_eq(ret, 0);
+    _assert_iheap(&ih);
+
+    //fourth test: empty the heap
+    cm_iheap_emp(&ih);
+    ck_assert_int_eq(ih.order.len, 0);
+    ck_assert_ptr_null(cm_iheap_get_p(&ih, 0));
+    ck_assert_int_eq(cm_iheap_psh(&ih, &value), 0);
+
+    cm_del_iheap(&ih);
+
+    return;
+
+} END_TEST
+
+
+
+/*
+ *  --- [SUITE] ---
+ */
+
+Suite * heap_suite() {
+
+    //test cases
+    TCase * tc_new_del_heap;
+    TCase * tc_heap_psh_pop;
+    TCase * tc_heap_pek;
+    TCase * tc_heap_rpl;
+    TCase * tc_new_heap_vct;
+    TCase * tc_heap_emp;
+
+    TCase * tc_new_del_iheap;
+    TCase * tc_iheap_psh_pop;
+    TCase * tc_iheap_upd_rmv;
+
+    Suite * s = suite_create("heap");
+
+
+    //cm_new_heap()
+    tc_new_del_heap = tcase_create("new_del_heap");
+    tcase_add_test(tc_new_del_heap, test_new_del_heap);
+
+    //cm_heap_psh() & cm_heap_pop()
+    tc_heap_psh_pop = tcase_create("heap_psh_pop");
+    tcase_add_test(tc_heap_psh_pop, test_heap_psh_pop);
+
+    //cm_heap_pek()
+    tc_heap_pek = tcase_create("heap_pek");
+    tcase_add_test(tc_heap_pek, test_heap_pek);
+
+    //cm_heap_rpl()
+    tc_heap_rpl = tcase_create("heap_rpl");
+    tcase_add_test(tc_heap_rpl, test_heap_rpl);
+
+    //cm_new_heap_vct()
+    tc_new_heap_vct = tcase_create("new_heap_vct");
+    tcase_add_test(tc_new_heap_vct, test_new_heap_vct);
+
+    //cm_heap_emp()
+    tc_heap_emp = tcase_create("heap_emp");
+    tcase_add_test(tc_heap_emp, test_heap_emp);
+
+
+    //cm_new_iheap()
+    tc_new_del_iheap = tcase_create("new_del_iheap");
+    tcase_add_test(tc_new_del_iheap, test_new_del_iheap);
+
+    //cm_iheap_psh() & cm_iheap_pop()
+    tc_iheap_psh_pop = tcase_create("iheap_psh_pop");
+    tcase_add_test(tc_iheap_psh_pop, test_iheap_psh_pop);
+
+    //cm_iheap_upd() & cm_iheap_rmv()
+    tc_iheap_upd_rmv = tcase_create("iheap_upd_rmv");
+    tcase_add_test(tc_iheap_upd_rmv, test_iheap_upd_rmv);
+
+
+    //add test cases to heap suite
+    suite_add_tcase(s, tc_new_del_heap);
+    suite_add_tcase(s, tc_heap_psh_pop);
+    suite_add_tcase(s, tc_heap_pek);
+    suite_add_tcase(s, tc_heap_rpl);
+    suite_add_tcase(s, tc_new_heap_vct);
+    suite_add_tcase(s, tc_heap_emp);
+
+    suite_add_tcase(s, tc_new_del_iheap);
+    suite_add_tcase(s, tc_iheap_psh_pop);
+    suite_add_tcase(s, tc_iheap_upd_rmv);
+
+    return s;
+}
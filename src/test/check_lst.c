@@ -112,6 +112,30 @@ static int _assert_callback(const cm_lst_node * node, void * ctx) {
 
 
 
+//assert batches arrive in order & record their lengths
+struct _assert_batch_ctx {
+
+    int next;
+    int calls;
+    int lens[16];
+};
+
+static int _assert_batch(void * const * data, const int len, void * ctx) {
+
+    struct _assert_batch_ctx * real_ctx = ctx;
+
+
+    for (int i = 0; i < len; ++i) {
+        ck_assert_int_eq(*(int *) data[i], real_ctx->next);
+        real_ctx->next += 1;
+    }
+    real_ctx->lens[real_ctx->calls++] = len;
+
+    return 0;
+}
+
+
+
 /*
  *  --- [FIXTURES] ---
  */
@@ -376,6 +400,37 @@ START_TEST(test_lst_get_n) {
 
 
 
+//cm_lst_nxt() & cm_lst_prv() [full fixture]
+START_TEST(test_lst_nxt_prv) {
+
+    cm_lst_node * n;
+
+
+    //first test: walk forwards
+    n = l.head;
+    for (int i = 0; i < TEST_LEN_FULL; ++i) {
+
+        ck_assert_ptr_eq(n, cm_lst_get_n(&l, i));
+        n = cm_lst_nxt(n);
+
+    } //end for
+    ck_assert_ptr_eq(n, l.head);
+
+
+    //second test: walk backwards
+    for (int i = TEST_LEN_FULL - 1; i >= 0; --i) {
+
+        n = cm_lst_prv(n);
+        ck_assert_int_eq(GET_NODE_DATA(n)->x, i);
+
+    } //end for
+
+    return;
+
+} END_TEST
+
+
+
 //cm_lst_set [full fixture]
 START_TEST(test_lst_set) {
 
@@ -1168,6 +1223,40 @@ START_TEST(test_lst_iter) {
 
 
 
+//cm_lst_iter_bat() [full fixture]
+START_TEST(test_lst_iter_bat) {
+
+    int ret;
+    struct _assert_batch_ctx ctx;
+
+
+    //first test: a short list fits in one batch
+    ctx = (struct _assert_batch_ctx) {0};
+    ret = cm_lst_iter_bat(&l, _assert_batch, &ctx);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(ctx.calls, 1);
+    ck_assert_int_eq(ctx.lens[0], 10);
+
+    //second test: a longer list is split into full batches & a remainder
+    for (int i = 0; i < (CM_ITER_BATCH * 3) - 6; ++i) {
+        cm_lst_apd(&l, &d);
+        d.x++;
+    }
+
+    ctx = (struct _assert_batch_ctx) {0};
+    ret = cm_lst_iter_bat(&l, _assert_batch, &ctx);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(ctx.calls, 4);
+    ck_assert_int_eq(ctx.lens[0], CM_ITER_BATCH);
+    ck_assert_int_eq(ctx.lens[3], 4);
+    ck_assert_int_eq(ctx.next, l.len);
+
+    return;
+
+} END_TEST
+
+
+
 /*
  *  --- [SUITE] ---
  */
@@ -1180,6 +1269,7 @@ Suite * lst_suite() {
     TCase * tc_lst_get;
     TCase * tc_lst_get_p;
     TCase * tc_lst_get_n;
+    TCase * tc_lst_nxt_prv;
     TCase * tc_lst_set;
     TCase * tc_lst_set_n;
     TCase * tc_lst_ins;
@@ -1193,6 +1283,7 @@ Suite * lst_suite() {
     TCase * tc_lst_cpy;
     TCase * tc_lst_mov;
     TCase * tc_lst_iter;
+    TCase * tc_lst_iter_bat;
 
     Suite * s = suite_create("list");
     
@@ -1221,6 +1312,11 @@ Suite * lst_suite() {
     tcase_add_checked_fixture(tc_lst_get_n, _setup_full, teardown);
     tcase_add_test(tc_lst_get_n, test_lst_get_n);
 
+    //cm_lst_nxt() & cm_lst_prv()
+    tc_lst_nxt_prv = tcase_create("list_nxt_prv");
+    tcase_add_checked_fixture(tc_lst_nxt_prv, _setup_full, teardown);
+    tcase_add_test(tc_lst_nxt_prv, test_lst_nxt_prv);
+
     //cm_lst_set()
     tc_lst_set = tcase_create("list_set");
     tcase_add_checked_fixture(tc_lst_set, _setup_full, teardown);
@@ -1286,6 +1382,11 @@ Suite * lst_suite() {
     tcase_add_checked_fixture(tc_lst_iter, _setup_full, teardown);
     tcase_add_test(tc_lst_iter, test_lst_iter);
 
+    //cm_lst_iter_bat()
+    tc_lst_iter_bat = tcase_create("list_iter_bat");
+    tcase_add_checked_fixture(tc_lst_iter_bat, _setup_full, teardown);
+    tcase_add_test(tc_lst_iter_bat, test_lst_iter_bat);
+
 
     //add test cases to list suite
     suite_add_tcase(s, tc_new_del_lst);
@@ -1293,6 +1394,7 @@ Suite * lst_suite() {
     suite_add_tcase(s, tc_lst_get);
     suite_add_tcase(s, tc_lst_get_p);
     suite_add_tcase(s, tc_lst_get_n);
+    suite_add_tcase(s, tc_lst_nxt_prv);
     suite_add_tcase(s, tc_lst_set);
     suite_add_tcase(s, tc_lst_set_n);
     suite_add_tcase(s, tc_lst_ins);
@@ -1306,6 +1408,7 @@ Suite * lst_suite() {
     suite_add_tcase(s, tc_lst_cpy);
     suite_add_tcase(s, tc_lst_mov);
     suite_add_tcase(s, tc_lst_iter);
+    suite_add_tcase(s, tc_lst_iter_bat);
 
     return s;
 }
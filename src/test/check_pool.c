@@ -0,0 +1,287 @@
+//standard library
+#include <stdlib.h>
+
+//external libraries
+#include <check.h>
+
+//local headers
+#include "suites.h"
+
+//test target headers
+#include "../lib/cmore.h"
+#include "../lib/pool.h"
+
+
+
+/*
+ *  [BASIC TEST]
+ *
+ *     Deque & scheduling internals are exercised 
+ *     through spawn & sync; tests check results, 
+ *     not which thread ran what.
+ */
+
+
+
+//globals
+static cm_pool p;
+
+#define POOL_WORKERS 4
+#define FLAT_N       5000
+#define FIB_N        18
+
+
+
+/*
+ *  --- [HELPERS] ---
+ */
+
+static int _count(void * ctx) {
+
+    __atomic_add_fetch((int *) ctx, 1, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+
+
+static int _fail_odd(void * ctx) {
+
+    return (int) (__atomic_add_fetch((int *) ctx, 1, __ATOMIC_RELAXED) % 2);
+}
+
+
+
+struct _fib_arg {
+
+    int n;
+    int result;
+};
+
+//recursive fork/join
+static int _fib(void * ctx) {
+
+    int ret;
+    struct _fib_arg * arg = ctx;
+    struct _fib_arg left, right;
+    cm_pool_task task;
+    cm_pool_grp grp;
+
+
+    if (arg->n < 2) {
+        arg->result = arg->n;
+        return 0;
+    }
+
+    left.n  = arg->n - 1;
+    right.n = arg->n - 2;
+
+    cm_new_pool_grp(&grp);
+    cm_pool_spawn(&p, &grp, &task, _fib, &left);
+    _fib(&right);
+    ret = cm_pool_sync(&p, &grp);
+
+    arg->result = left.result + right.result;
+
+    return ret;
+}
+
+
+
+//spawn FLAT_N tasks from inside a worker, overflowing its deque
+static int _spawn_many(void * ctx) {
+
+    int ret;
+    cm_pool_grp grp;
+    cm_pool_task * tasks;
+
+
+    tasks = malloc(sizeof(*tasks) * FLAT_N);
+    cm_new_pool_grp(&grp);
+
+    for (int i = 0; i < FLAT_N; ++i) {
+        cm_pool_spawn(&p, &grp, &tasks[i], _count, ctx);
+    }
+    ret = cm_pool_sync(&p, &grp);
+
+    free(tasks);
+
+    return ret;
+}
+
+
+
+/*
+ *  --- [FIXTURES] ---
+ */
+
+static void _setup() {
+
+    int ret;
+
+
+    ret = cm_new_pool(&p, POOL_WORKERS);
+
+    return;
+}
+
+
+
+static void _teardown() {
+
+    cm_del_pool(&p);
+
+    return;
+}
+
+
+
+/*
+ *  --- [UNIT TESTS] ---
+ */
+
+//cm_new_pool() & cm_del_pool() [no fixture]
+START_TEST(test_new_del_pool) {
+
+    int ret;
+    cm_pool q;
+
+
+    //first test: explicit worker count
+    ret = cm_new_pool(&q, 2);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(q.workers_n, 2);
+    ck_assert(q.is_init);
+    cm_del_pool(&q);
+    ck_assert(!q.is_init);
+
+    //second test: size to the CPUs available
+    ck_assert_int_ge(cm_pool_cpus(), 1);
+    ret = cm_new_pool(&q, 0);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(q.workers_n, cm_pool_cpus());
+    cm_del_pool(&q);
+
+    //third test: the shared pool is created once
+    ck_assert_ptr_nonnull(cm_pool_def());
+    ck_assert_ptr_eq(cm_pool_def(), cm_pool_def());
+    ck_assert_int_eq(cm_pool_def()->workers_n, cm_pool_cpus());
+
+    return;
+
+} END_TEST
+
+
+
+//cm_pool_spawn() & cm_pool_sync() [pool fixture]
+START_TEST(test_pool_spawn_sync) {
+
+    int ret, count;
+    cm_pool_grp grp;
+    cm_pool_task * tasks;
+
+
+    tasks = malloc(sizeof(*tasks) * FLAT_N);
+    cm_new_pool_grp(&grp);
+
+    //first test: sync an empty group
+    ret = cm_pool_sync(&p, &grp);
+    ck_assert_int_eq(ret, 0);
+
+    //second test: spawn from outside the pool, overflowing injection
+    count = 0;
+    for (int i = 0; i < FLAT_N; ++i) {
+        cm_pool_spawn(&p, &grp, &tasks[i], _count, &count);
+    }
+    ret = cm_pool_sync(&p, &grp);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(count, FLAT_N);
+
+    //third test: spawn from inside a worker, overflowing its deque
+    count = 0;
+    cm_pool_spawn(&p, &grp, &tasks[0], _spawn_many, &count);
+    ret = cm_pool_sync(&p, &grp);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(count, FLAT_N);
+
+    //fourth test: failing tasks fail the sync once
+    count = 0;
+    for (int i = 0; i < 16; ++i) {
+        cm_pool_spawn(&p, &grp, &tasks[i], _fail_odd, &count);
+    }
+    ret = cm_pool_sync(&p, &grp);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_CALLBACK);
+    ck_assert_int_eq(count, 16);
+
+    ret = cm_pool_sync(&p, &grp);
+    ck_assert_int_eq(ret, 0);
+
+    free(tasks);
+
+    return;
+
+} END_TEST
+
+
+
+//nested cm_pool_spawn() & cm_pool_sync() [pool fixture]
+START_TEST(test_pool_nested) {
+
+    int ret;
+    struct _fib_arg arg;
+    cm_pool_grp grp;
+    cm_pool_task task;
+
+
+    //only test: recursive fork/join computes the right result
+    arg.n = FIB_N;
+    cm_new_pool_grp(&grp);
+    cm_pool_spawn(&p, &grp, &task, _fib, &arg);
+    ret = cm_pool_sync(&p, &grp);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(arg.result, 2584);
+
+    return;
+
+} END_TEST
+
+
+
+/*
+ *  --- [SUITE] ---
+ */
+
+Suite * pool_suite() {
+
+    //test cases
+    TCase * tc_new_del_pool;
+    TCase * tc_pool_spawn_sync;
+    TCase * tc_pool_nested;
+
+    Suite * s = suite_create("pool");
+
+
+    //cm_new_pool()
+    tc_new_del_pool = tcase_create("new_del_pool");
+    tcase_add_test(tc_new_del_pool, test_new_del_pool);
+
+    //cm_pool_spawn() & cm_pool_sync()
+    tc_pool_spawn_sync = tcase_create("pool_spawn_sync");
+    tcase_add_checked_fixture(tc_pool_spawn_sync, _setup, _teardown);
+    tcase_set_timeout(tc_pool_spawn_sync, 30);
+    tcase_add_test(tc_pool_spawn_sync, test_pool_spawn_sync);
+
+    //nested spawn & sync
+    tc_pool_nested = tcase_create("pool_nested");
+    tcase_add_checked_fixture(tc_pool_nested, _setup, _teardown);
+    tcase_set_timeout(tc_pool_nested, 30);
+    tcase_add_test(tc_pool_nested, test_pool_nested);
+
+    //add test cases to pool suite
+    suite_add_tcase(s, tc_new_del_pool);
+    suite_add_tcase(s, tc_pool_spawn_sync);
+    suite_add_tcase(s, tc_pool_nested);
+
+    return s;
+}
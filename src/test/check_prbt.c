@@ -0,0 +1,516 @@
+//standard library
+#include <stdlib.h>
+
+//system headers
+#include <pthread.h>
+#include <sched.h>
+
+//external libraries
+#include <check.h>
+
+//local headers
+#include "suites.h"
+
+//test target headers
+#include "../lib/cmore.h"
+#include "../lib/prbt.h"
+
+
+
+/*
+ *  [BASIC TEST]
+ *
+ *     Every version is checked against the
+ *     red-black properties after it is built.
+ */
+
+
+
+//globals
+static cm_prbt pt;
+
+#define PRBT_KEYS    512
+#define PRBT_READERS 3
+#define PRBT_ROUNDS  4000
+
+
+
+/*
+ *  --- [HELPERS] ---
+ */
+
+static enum cm_rbt_side _compare(const void * a, const void * b) {
+
+    int x = *(int *) a, y = *(int *) b;
+
+    if (x < y) return CM_RBT_LESS;
+    if (x > y) return CM_RBT_MORE;
+    return CM_RBT_EQUAL;
+}
+
+
+
+//return the black height of a valid subtree, or -1
+static int _check(const cm_prbt_node * node, const int * min, const int * max,
+                  int * count) {
+
+    int key, left, right;
+
+
+    if (node == NULL) return 1;
+
+    key = *(int *) node->key;
+    if (min != NULL && key <= *min) return -1;
+    if (max != NULL && key >= *max) return -1;
+
+    if (node->colour == CM_RBT_RED) {
+        if (node->left != NULL && node->left->colour == CM_RBT_RED) return -1;
+        if (node->right != NULL && node->right->colour == CM_RBT_RED) return -1;
+    }
+
+    left  = _check(node->left, min, &key, count);
+    right = _check(node->right, &key, max, count);
+    if (left == -1 || left != right) return -1;
+
+    ++*count;
+
+    return left + (node->colour == CM_RBT_BLACK ? 1 : 0);
+}
+
+
+
+static void _assert_ver(const cm_prbt_node * ver, const int len) {
+
+    int count = 0;
+
+
+    if (ver != NULL) ck_assert_int_eq(ver->colour, CM_RBT_BLACK);
+    ck_assert_int_ne(_check(ver, NULL, NULL, &count), -1);
+    ck_assert_int_eq(count, len);
+
+    return;
+}
+
+
+
+//count nodes no other version shares
+static int _count_owned(const cm_prbt_node * node) {
+
+    if (node == NULL || node->refs != 1) return 0;
+
+    return 1 + _count_owned(node->left) + _count_owned(node->right);
+}
+
+
+
+//snapshot the tree until told to stop
+struct _reader_arg {
+
+    bool * stop;
+    int snaps;
+    bool valid;
+};
+
+static void * _reader(void * arg) {
+
+    int count, key, value;
+    cm_prbt_node * ver;
+    struct _reader_arg * a = arg;
+
+
+    a->snaps = 0;
+    a->valid = true;
+
+    while (!__atomic_load_n(a->stop, __ATOMIC_RELAXED)) {
+
+        ver = cm_prbt_snp(&pt);
+
+        //the writer publishes keys in pairs
+        count = 0;
+        if (_check(ver, NULL, NULL, &count) == -1) a->valid = false;
+        if (count % 2 != 0) a->valid = false;
+
+        for (key = 0; key < count; ++key) {
+            if (cm_prbt_get(&pt, ver, &key, &value) != 0) a->valid = false;
+            if (value != key * 2) a->valid = false;
+        }
+
+        cm_prbt_rls(ver);
+        ++a->snaps;
+        sched_yield();
+    }
+
+    return NULL;
+}
+
+
+
+//snapshot the round counter until told to stop
+static void * _snapper(void * arg) {
+
+    int key, value, last;
+    cm_prbt_node * ver;
+    struct _reader_arg * a = arg;
+
+
+    a->snaps = 0;
+    a->valid = true;
+    last = -1;
+    key = 0;
+
+    while (!__atomic_load_n(a->stop, __ATOMIC_RELAXED)) {
+
+        ver = cm_prbt_snp(&pt);
+
+        //rounds are published in order
+        if (ver != NULL) {
+            if (ver->refs < 1) a->valid = false;
+            if (cm_prbt_get(&pt, ver, &key, &value) != 0) a->valid = false;
+            if (value < last) a->valid = false;
+            last = value;
+        }
+
+        cm_prbt_rls(ver);
+        ++a->snaps;
+    }
+
+    return NULL;
+}
+
+
+
+/*
+ *  --- [FIXTURES] ---
+ */
+
+static void _setup() {
+
+    int ret;
+
+
+    ret = cm_new_prbt(&pt, sizeof(int), sizeof(int), _compare);
+
+    return;
+}
+
+
+
+static void _teardown() {
+
+    cm_del_prbt(&pt);
+
+    return;
+}
+
+
+
+/*
+ *  --- [UNIT TESTS] ---
+ */
+
+//cm_new_prbt() & cm_del_prbt() [no fixture]
+START_TEST(test_new_del_prbt) {
+
+    int ret;
+    cm_prbt u;
+
+
+    //only test: create a persistent tree & destroy it
+    ret = cm_new_prbt(&u, sizeof(int), sizeof(int), _compare);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_ptr_null(u.root);
+    ck_assert_int_eq(u.key_sz, sizeof(int));
+    ck_assert(u.is_init);
+
+    cm_del_prbt(&u);
+    ck_assert(!u.is_init);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_prbt_get(), cm_prbt_set() & cm_prbt_rmv() [prbt fixture]
+START_TEST(test_prbt_get_set_rmv) {
+
+    int ret, key, value;
+    int * value_p;
+    cm_prbt_node * ver, * next, * old;
+
+
+    //first test: miss on the empty version
+    ver = NULL;
+    key = 1;
+    ret = cm_prbt_get(&pt, ver, &key, &value);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+
+    //second test: insert in a scattered order
+    for (int i = 0; i < PRBT_KEYS; ++i) {
+        key = (i * 37) % PRBT_KEYS;
+        value = key * 2;
+        ret = cm_prbt_set(&pt, ver, &key, &value, &next);
+        ck_assert_int_eq(ret, 0);
+        cm_prbt_rls(ver);
+        ver = next;
+    }
+    _assert_ver(ver, PRBT_KEYS);
+
+    for (key = 0; key < PRBT_KEYS; ++key) {
+        value_p = cm_prbt_get_p(&pt, ver, &key);
+        ck_assert_ptr_nonnull(value_p);
+        ck_assert_int_eq(*value_p, key * 2);
+    }
+
+    //third test: a new version copies only its search path
+    old = ver;
+    key = 100;
+    value = -1;
+    ret = cm_prbt_set(&pt, old, &key, &value, &ver);
+    ck_assert_int_eq(ret, 0);
+    _assert_ver(ver, PRBT_KEYS);
+    ck_assert_int_le(_count_owned(ver), 2 * 10);
+
+    ret = cm_prbt_get(&pt, ver, &key, &value);
+    ck_assert_int_eq(value, -1);
+    ret = cm_prbt_get(&pt, old, &key, &value);
+    ck_assert_int_eq(value, 200);
+
+    //fourth test: removals leave the old version intact
+    cm_prbt_rls(old);
+    old = ver;
+    for (key = 0; key < PRBT_KEYS; key += 2) {
+        ret = cm_prbt_rmv(&pt, ver, &key, &next);
+        ck_assert_int_eq(ret, 0);
+        if (ver != old) cm_prbt_rls(ver);
+        ver = next;
+        _assert_ver(ver, PRBT_KEYS - key / 2 - 1);
+    }
+    _assert_ver(old, PRBT_KEYS);
+
+    for (key = 0; key < PRBT_KEYS; ++key) {
+        ret = cm_prbt_get(&pt, ver, &key, &value);
+        ck_assert_int_eq(ret, key % 2 == 0 ? -1 : 0);
+        ret = cm_prbt_get(&pt, old, &key, &value);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    //fifth test: remove a missing key
+    key = 0;
+    ret = cm_prbt_rmv(&pt, ver, &key, &next);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+
+    //sixth test: remove every remaining key
+    for (key = 1; key < PRBT_KEYS; key += 2) {
+        ret = cm_prbt_rmv(&pt, ver, &key, &next);
+        ck_assert_int_eq(ret, 0);
+        cm_prbt_rls(ver);
+        ver = next;
+        _assert_ver(ver, (PRBT_KEYS - key) / 2);
+    }
+    ck_assert_ptr_null(ver);
+
+    cm_prbt_rls(old);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_prbt_snp(), cm_prbt_pub() & cm_prbt_rls() [prbt fixture]
+START_TEST(test_prbt_snp_pub) {
+
+    int ret, key, value;
+    cm_prbt_node * snap, * ver, * next;
+
+
+    //first test: the empty tree publishes the empty version
+    snap = cm_prbt_snp(&pt);
+    ck_assert_ptr_null(snap);
+
+    //second test: a snapshot outlives later publications
+    ver = cm_prbt_snp(&pt);
+    for (key = 0; key < 10; ++key) {
+        value = key * 2;
+        cm_prbt_set(&pt, ver, &key, &value, &next);
+        cm_prbt_rls(ver);
+        ver = next;
+    }
+    cm_prbt_pub(&pt, ver);
+    ck_assert_int_eq(pt.parity, 1);
+
+    snap = cm_prbt_snp(&pt);
+    ck_assert_ptr_eq(snap, pt.root);
+    ck_assert_int_eq(snap->refs, 2);
+
+    ver = cm_prbt_snp(&pt);
+    key = 0;
+    cm_prbt_rmv(&pt, ver, &key, &next);
+    cm_prbt_rls(ver);
+    cm_prbt_pub(&pt, next);
+
+    ck_assert_int_eq(snap->refs, 1);
+    ret = cm_prbt_get(&pt, snap, &key, &value);
+    ck_assert_int_eq(ret, 0);
+    ret = cm_prbt_get(&pt, pt.root, &key, &value);
+    ck_assert_int_eq(ret, -1);
+
+    cm_prbt_rls(snap);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_prbt_*() with concurrent readers [prbt fixture]
+START_TEST(test_prbt_threads) {
+
+    int ret, value;
+    bool stop;
+    cm_prbt_node * ver, * next;
+    pthread_t readers[PRBT_READERS];
+    struct _reader_arg args[PRBT_READERS];
+
+
+    stop = false;
+    for (int i = 0; i < PRBT_READERS; ++i) {
+        args[i].stop = &stop;
+        ret = pthread_create(&readers[i], NULL, _reader, &args[i]);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    //only test: readers only ever see whole batches
+    for (int key = 0; key < PRBT_KEYS; key += 2) {
+
+        ver = cm_prbt_snp(&pt);
+        for (int i = key; i < key + 2; ++i) {
+            value = i * 2;
+            cm_prbt_set(&pt, ver, &i, &value, &next);
+            cm_prbt_rls(ver);
+            ver = next;
+        }
+        cm_prbt_pub(&pt, ver);
+        sched_yield();
+    }
+
+    for (int key = PRBT_KEYS - 1; key >= 0; key -= 2) {
+
+        ver = cm_prbt_snp(&pt);
+        for (int i = key; i > key - 2; --i) {
+            cm_prbt_rmv(&pt, ver, &i, &next);
+            cm_prbt_rls(ver);
+            ver = next;
+        }
+        cm_prbt_pub(&pt, ver);
+        sched_yield();
+    }
+
+    __atomic_store_n(&stop, true, __ATOMIC_RELAXED);
+    for (int i = 0; i < PRBT_READERS; ++i) {
+        pthread_join(readers[i], NULL);
+        ck_assert(args[i].valid);
+    }
+    ck_assert_ptr_null(pt.root);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_prbt_snp() against cm_prbt_pub() [prbt fixture]
+START_TEST(test_prbt_snp_threads) {
+
+    int ret, key;
+    bool stop;
+    cm_prbt_node * ver, * next;
+    pthread_t readers[PRBT_READERS];
+    struct _reader_arg args[PRBT_READERS];
+
+
+    stop = false;
+    for (int i = 0; i < PRBT_READERS; ++i) {
+        args[i].stop = &stop;
+        ret = pthread_create(&readers[i], NULL, _snapper, &args[i]);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    //only test: every publication drops the old root under the readers
+    key = 0;
+    for (int round = 0; round < PRBT_ROUNDS; ++round) {
+
+        ver = cm_prbt_snp(&pt);
+        ret = cm_prbt_set(&pt, ver, &key, &round, &next);
+        ck_assert_int_eq(ret, 0);
+        cm_prbt_rls(ver);
+        cm_prbt_pub(&pt, next);
+    }
+
+    __atomic_store_n(&stop, true, __ATOMIC_RELAXED);
+    for (int i = 0; i < PRBT_READERS; ++i) {
+        pthread_join(readers[i], NULL);
+        ck_assert(args[i].valid);
+    }
+    ck_assert_int_eq(pt.root->refs, 1);
+
+    return;
+
+} END_TEST
+
+
+
+/*
+ *  --- [SUITE] ---
+ */
+
+Suite * prbt_suite() {
+
+    //test cases
+    TCase * tc_new_del_prbt;
+    TCase * tc_prbt_get_set_rmv;
+    TCase * tc_prbt_snp_pub;
+    TCase * tc_prbt_threads;
+    TCase * tc_prbt_snp_threads;
+
+    Suite * s = suite_create("persistent rb_tree");
+
+
+    //cm_new_prbt()
+    tc_new_del_prbt = tcase_create("new_del_prbt");
+    tcase_add_test(tc_new_del_prbt, test_new_del_prbt);
+
+    //cm_prbt_get(), cm_prbt_set() & cm_prbt_rmv()
+    tc_prbt_get_set_rmv = tcase_create("prbt_get_set_rmv");
+    tcase_add_checked_fixture(tc_prbt_get_set_rmv, _setup, _teardown);
+    tcase_add_test(tc_prbt_get_set_rmv, test_prbt_get_set_rmv);
+
+    //cm_prbt_snp(), cm_prbt_pub() & cm_prbt_rls()
+    tc_prbt_snp_pub = tcase_create("prbt_snp_pub");
+    tcase_add_checked_fixture(tc_prbt_snp_pub, _setup, _teardown);
+    tcase_add_test(tc_prbt_snp_pub, test_prbt_snp_pub);
+
+    //concurrent readers
+    tc_prbt_threads = tcase_create("prbt_threads");
+    tcase_add_checked_fixture(tc_prbt_threads, _setup, _teardown);
+    tcase_set_timeout(tc_prbt_threads, 60);
+    tcase_add_test(tc_prbt_threads, test_prbt_threads);
+
+    //concurrent snapshots & publications
+    tc_prbt_snp_threads = tcase_create("prbt_snp_threads");
+    tcase_add_checked_fixture(tc_prbt_snp_threads, _setup, _teardown);
+    tcase_set_timeout(tc_prbt_snp_threads, 60);
+    tcase_add_test(tc_prbt_snp_threads, test_prbt_snp_threads);
+
+    //add test cases to persistent rb_tree suite
+    suite_add_tcase(s, tc_new_del_prbt);
+    suite_add_tcase(s, tc_prbt_get_set_rmv);
+    suite_add_tcase(s, tc_prbt_snp_pub);
+    suite_add_tcase(s, tc_prbt_threads);
+    suite_add_tcase(s, tc_prbt_snp_threads);
+
+    return s;
+}
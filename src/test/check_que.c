@@ -0,0 +1,684 @@
+//standard library
+#include <string.h>
+
+//system headers
+#include <pthread.h>
+#include <sched.h>
+
+//external libraries
+#include <check.h>
+
+//local headers
+#include "suites.h"
+
+//test target headers
+#include "../lib/cmore.h"
+#include "../lib/que.h"
+
+
+
+/*
+ *  [BASIC TEST]
+ *
+ *     Queue internals are small; they are tested 
+ *     through exported functions. Concurrent tests
+ *     check ordering & loss, not timing.
+ */
+
+
+
+//globals
+static cm_spsc sq;
+static cm_mpmc mq;
+
+#define SPSC_SLOTS 16
+#define MPMC_SLOTS 16
+#define STRESS_N   200000
+
+#define MPMC_THREADS 4
+#define MPMC_N       50000
+
+//per-thread arguments & results of the mpmc stress tests
+struct _mpmc_arg {
+
+    int id;
+    bool blocking;
+    long long sum;
+    int count;
+    bool ordered;
+};
+
+
+
+/*
+ *  --- [FIXTURES] ---
+ */
+
+//empty spsc queue setup
+static void _setup_spsc() {
+
+    int ret;
+
+
+    ret = cm_new_spsc(&sq, sizeof(int), SPSC_SLOTS);
+
+    return;
+}
+
+
+
+static void _teardown_spsc() {
+
+    cm_del_spsc(&sq);
+
+    return;
+}
+
+
+
+//empty mpmc queue setup
+static void _setup_mpmc() {
+
+    int ret;
+
+
+    ret = cm_new_mpmc(&mq, sizeof(int), MPMC_SLOTS);
+
+    return;
+}
+
+
+
+static void _teardown_mpmc() {
+
+    cm_del_mpmc(&mq);
+
+    return;
+}
+
+
+
+/*
+ *  --- [THREADS] ---
+ */
+
+//push 0..STRESS_N-1 in bursts of varying size
+static void * _spsc_producer(__attribute__((unused)) void * arg) {
+
+    int ret, next, burst[7];
+
+
+    next = 0;
+    while (next < STRESS_N) {
+
+        //alternate single & bulk enqueues
+        if (next % 3 == 0) {
+            if (cm_spsc_enq(&sq, &next) == 0) ++next;
+            else sched_yield();
+            continue;
+        }
+
+        for (int i = 0; i < 7; ++i) burst[i] = next + i;
+        ret = cm_spsc_enq_n(&sq, burst,
+                            STRESS_N - next < 7 ? STRESS_N - next : 7);
+        next += ret;
+        if (ret == 0) sched_yield();
+    }
+
+    return NULL;
+}
+
+
+
+//push MPMC_N values tagged with the producer's id
+static void * _mpmc_producer(void * arg) {
+
+    int ret, value, burst[3];
+    struct _mpmc_arg * a = arg;
+
+
+    for (int i = 0; i < MPMC_N; ) {
+
+        value = (a->id << 24) | i;
+
+        if (a->blocking) {
+            cm_mpmc_enq_w(&mq, &value);
+            ++i;
+
+        } else if (i % 2 == 0) {
+            if (cm_mpmc_enq(&mq, &value) == 0) ++i;
+            else sched_yield();
+
+        } else {
+            for (int j = 0; j < 3; ++j) burst[j] = value + j;
+            ret = cm_mpmc_enq_n(&mq, burst, MPMC_N - i < 3 ? MPMC_N - i : 3);
+            i += ret;
+            if (ret == 0) sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+
+
+//pop values until `count` reaches MPMC_N
+static void * _mpmc_consumer(void * arg) {
+
+    int ret, value, buf[4], last[MPMC_THREADS];
+    struct _mpmc_arg * a = arg;
+
+
+    for (int i = 0; i < MPMC_THREADS; ++i) last[i] = -1;
+    a->sum     = 0;
+    a->count   = 0;
+    a->ordered = true;
+
+    while (a->count < MPMC_N) {
+
+        if (a->blocking) {
+            cm_mpmc_deq_w(&mq, &buf[0]);
+            ret = 1;
+
+        } else {
+            ret = cm_mpmc_deq_n(&mq, buf, MPMC_N - a->count < 4
+                                          ? MPMC_N - a->count : 4);
+            if (ret == 0) sched_yield();
+        }
+
+        //each producer's values must arrive in order
+        for (int i = 0; i < ret; ++i) {
+
+            value = buf[i] & 0xffffff;
+            if (value <= last[buf[i] >> 24]) a->ordered = false;
+            last[buf[i] >> 24] = value;
+            a->sum += value;
+        }
+        a->count += ret;
+    }
+
+    return NULL;
+}
+
+
+
+//run MPMC_THREADS producers & consumers
+static void _mpmc_stress(const bool blocking) {
+
+    int ret;
+    long long sum;
+
+    pthread_t producers[MPMC_THREADS], consumers[MPMC_THREADS];
+    struct _mpmc_arg p_args[MPMC_THREADS], c_args[MPMC_THREADS];
+
+
+    for (int i = 0; i < MPMC_THREADS; ++i) {
+
+        p_args[i].id = c_args[i].id = i;
+        p_args[i].blocking = c_args[i].blocking = blocking;
+
+        ret = pthread_create(&consumers[i], NULL, _mpmc_consumer, &c_args[i]);
+        ck_assert_int_eq(ret, 0);
+        ret = pthread_create(&producers[i], NULL, _mpmc_producer, &p_args[i]);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    sum = 0;
+    for (int i = 0; i < MPMC_THREADS; ++i) {
+
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+
+        ck_assert(c_args[i].ordered);
+        sum += c_args[i].sum;
+    }
+
+    //every element arrived exactly once
+    ck_assert_int_eq(sum, (long long) MPMC_THREADS
+                          * ((long long) MPMC_N * (MPMC_N - 1) / 2));
+    ret = cm_mpmc_deq(&mq, &ret);
+    ck_assert_int_eq(ret, -1);
+
+    return;
+}
+
+
+
+/*
+ *  --- [UNIT TESTS] ---
+ */
+
+//cm_new_spsc() & cm_del_spsc() [no fixture]
+START_TEST(test_new_del_spsc) {
+
+    int ret;
+    cm_spsc q;
+
+
+    //first test: slot count is rounded up to a power of two
+    ret = cm_new_spsc(&q, sizeof(int), 10);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(q.sz, 16);
+    ck_assert_int_eq(q.data_sz, sizeof(int));
+    ck_assert(q.is_init);
+    cm_del_spsc(&q);
+    ck_assert(!q.is_init);
+
+    //second test: head & tail do not share a cache line
+    ck_assert_int_ge((void *) &q.tail - (void *) &q.head, CM_CACHE_LINE);
+
+    //third test: reject zero slots
+    ret = cm_new_spsc(&q, sizeof(int), 0);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARG);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_spsc_enq() & cm_spsc_deq() [spsc fixture]
+START_TEST(test_spsc_enq_deq) {
+
+    int ret, value;
+
+
+    //first test: dequeue from an empty queue
+    ret = cm_spsc_deq(&sq, &value);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_EMPTY);
+
+    //second test: fill the queue
+    for (int i = 0; i < SPSC_SLOTS; ++i) {
+        ret = cm_spsc_enq(&sq, &i);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    //third test: enqueue onto a full queue
+    ret = cm_spsc_enq(&sq, &value);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_FULL);
+
+    //fourth test: wrap around several times, preserving order
+    for (int i = 0; i < SPSC_SLOTS * 4; ++i) {
+
+        ret = cm_spsc_deq(&sq, &value);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(value, i);
+
+        value = i + SPSC_SLOTS;
+        ret = cm_spsc_enq(&sq, &value);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    return;
+
+} END_TEST
+
+
+
+//cm_spsc_enq_n() & cm_spsc_deq_n() [spsc fixture]
+START_TEST(test_spsc_bulk) {
+
+    int ret, in[SPSC_SLOTS * 2], out[SPSC_SLOTS * 2];
+
+
+    for (int i = 0; i < SPSC_SLOTS * 2; ++i) in[i] = i;
+
+    //offset head & tail so that bulk operations wrap
+    ret = cm_spsc_enq_n(&sq, in, 11);
+    ck_assert_int_eq(ret, 11);
+    ret = cm_spsc_deq_n(&sq, out, 11);
+    ck_assert_int_eq(ret, 11);
+
+    //first test: enqueue more than fits
+    ret = cm_spsc_enq_n(&sq, in, SPSC_SLOTS * 2);
+    ck_assert_int_eq(ret, SPSC_SLOTS);
+
+    //second test: nothing fits
+    ret = cm_spsc_enq_n(&sq, in, 1);
+    ck_assert_int_eq(ret, 0);
+
+    //third test: dequeue across the wrap
+    memset(out, 0, sizeof(out));
+    ret = cm_spsc_deq_n(&sq, out, 10);
+    ck_assert_int_eq(ret, 10);
+    ret = cm_spsc_deq_n(&sq, out + 10, SPSC_SLOTS * 2);
+    ck_assert_int_eq(ret, SPSC_SLOTS - 10);
+    for (int i = 0; i < SPSC_SLOTS; ++i) ck_assert_int_eq(out[i], i);
+
+    //fourth test: dequeue from an empty queue
+    ret = cm_spsc_deq_n(&sq, out, 1);
+    ck_assert_int_eq(ret, 0);
+
+    //fifth test: negative counts move nothing
+    ret = cm_spsc_enq_n(&sq, in, -1);
+    ck_assert_int_eq(ret, 0);
+    ret = cm_spsc_enq_n(&sq, in, 1);
+    ck_assert_int_eq(ret, 1);
+    ret = cm_spsc_deq_n(&sq, out, -1);
+    ck_assert_int_eq(ret, 0);
+    ret = cm_spsc_deq_n(&sq, out, SPSC_SLOTS);
+    ck_assert_int_eq(ret, 1);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_spsc_rsv(), cm_spsc_cmt(), cm_spsc_pek() & cm_spsc_rls() [spsc fixture]
+START_TEST(test_spsc_zero_copy) {
+
+    int ret, value;
+    int * slots;
+
+
+    //offset head & tail so that the run is cut by the end of the ring
+    for (int i = 0; i < 12; ++i) {
+        cm_spsc_enq(&sq, &i);
+        cm_spsc_deq(&sq, &value);
+    }
+
+    //first test: reserve is cut at the end of the ring
+    ret = cm_spsc_rsv(&sq, (void **) &slots, 8);
+    ck_assert_int_eq(ret, 4);
+    for (int i = 0; i < ret; ++i) slots[i] = 100 + i;
+
+    //second test: reserved slots are invisible until committed
+    ret = cm_spsc_pek(&sq, (void **) &slots, 8);
+    ck_assert_int_eq(ret, 0);
+    cm_spsc_rsv(&sq, (void **) &slots, 8);
+    cm_spsc_cmt(&sq, 4);
+
+    //third test: the remainder starts at the front of the ring
+    ret = cm_spsc_rsv(&sq, (void **) &slots, 4);
+    ck_assert_int_eq(ret, 4);
+    ck_assert_ptr_eq(slots, sq.data);
+    for (int i = 0; i < ret; ++i) slots[i] = 104 + i;
+    cm_spsc_cmt(&sq, 4);
+
+    //fourth test: peek in two runs, releasing part of the first
+    ret = cm_spsc_pek(&sq, (void **) &slots, 16);
+    ck_assert_int_eq(ret, 4);
+    for (int i = 0; i < ret; ++i) ck_assert_int_eq(slots[i], 100 + i);
+    cm_spsc_rls(&sq, 2);
+
+    ret = cm_spsc_pek(&sq, (void **) &slots, 16);
+    ck_assert_int_eq(ret, 2);
+    cm_spsc_rls(&sq, 2);
+
+    ret = cm_spsc_pek(&sq, (void **) &slots, 16);
+    ck_assert_int_eq(ret, 4);
+    for (int i = 0; i < ret; ++i) ck_assert_int_eq(slots[i], 104 + i);
+    cm_spsc_rls(&sq, 4);
+
+    //fifth test: the queue is empty again
+    ret = cm_spsc_deq(&sq, &value);
+    ck_assert_int_eq(ret, -1);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_spsc_*() across two threads [spsc fixture]
+START_TEST(test_spsc_threads) {
+
+    int ret, got, expect, buf[5];
+    pthread_t producer;
+
+
+    ret = pthread_create(&producer, NULL, _spsc_producer, NULL);
+    ck_assert_int_eq(ret, 0);
+
+    //only test: every element arrives exactly once, in order
+    expect = 0;
+    while (expect < STRESS_N) {
+
+        if (expect % 2 == 0) {
+            if (cm_spsc_deq(&sq, &got) == 0) {
+                ck_assert_int_eq(got, expect);
+                ++expect;
+            } else {
+                sched_yield();
+            }
+            continue;
+        }
+
+        ret = cm_spsc_deq_n(&sq, buf, 5);
+        for (int i = 0; i < ret; ++i) ck_assert_int_eq(buf[i], expect + i);
+        expect += ret;
+        if (ret == 0) sched_yield();
+    }
+
+    pthread_join(producer, NULL);
+
+    ret = cm_spsc_deq(&sq, &got);
+    ck_assert_int_eq(ret, -1);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_new_mpmc() & cm_del_mpmc() [no fixture]
+START_TEST(test_new_del_mpmc) {
+
+    int ret;
+    cm_mpmc q;
+
+
+    //first test: slot count is rounded up to a power of two
+    ret = cm_new_mpmc(&q, 3, 10);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(q.sz, 16);
+    ck_assert_int_eq(q.data_sz, 3);
+    ck_assert_int_eq(q.slot_sz % sizeof(size_t), 0);
+    ck_assert(q.is_init);
+    cm_del_mpmc(&q);
+    ck_assert(!q.is_init);
+
+    //second test: a single slot is widened to two
+    ret = cm_new_mpmc(&q, sizeof(int), 1);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(q.sz, 2);
+    cm_del_mpmc(&q);
+
+    //third test: reject zero slots
+    ret = cm_new_mpmc(&q, sizeof(int), 0);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARG);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_mpmc_enq() & cm_mpmc_deq() [mpmc fixture]
+START_TEST(test_mpmc_enq_deq) {
+
+    int ret, value;
+
+
+    //first test: dequeue from an empty queue
+    ret = cm_mpmc_deq(&mq, &value);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_EMPTY);
+
+    //second test: fill the queue
+    for (int i = 0; i < MPMC_SLOTS; ++i) {
+        ret = cm_mpmc_enq(&mq, &i);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    //third test: enqueue onto a full queue
+    ret = cm_mpmc_enq(&mq, &value);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_FULL);
+
+    //fourth test: wrap around several times, preserving order
+    for (int i = 0; i < MPMC_SLOTS * 4; ++i) {
+
+        ret = cm_mpmc_deq(&mq, &value);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(value, i);
+
+        value = i + MPMC_SLOTS;
+        cm_mpmc_enq_w(&mq, &value);
+    }
+
+    //fifth test: blocking dequeue of available elements does not sleep
+    for (int i = 0; i < MPMC_SLOTS; ++i) {
+        cm_mpmc_deq_w(&mq, &value);
+        ck_assert_int_eq(value, i + MPMC_SLOTS * 4);
+    }
+
+    return;
+
+} END_TEST
+
+
+
+//cm_mpmc_enq_n() & cm_mpmc_deq_n() [mpmc fixture]
+START_TEST(test_mpmc_bulk) {
+
+    int ret, value, in[MPMC_SLOTS * 2], out[MPMC_SLOTS * 2];
+
+
+    for (int i = 0; i < MPMC_SLOTS * 2; ++i) in[i] = i;
+
+    //offset the positions so that bulk operations wrap
+    ret = cm_mpmc_enq_n(&mq, in, 11);
+    ck_assert_int_eq(ret, 11);
+    ret = cm_mpmc_deq_n(&mq, out, 11);
+    ck_assert_int_eq(ret, 11);
+
+    //first test: enqueue more than fits
+    ret = cm_mpmc_enq_n(&mq, in, MPMC_SLOTS * 2);
+    ck_assert_int_eq(ret, MPMC_SLOTS);
+
+    //second test: nothing fits, in bulk or singly
+    ret = cm_mpmc_enq_n(&mq, in, 1);
+    ck_assert_int_eq(ret, 0);
+    ret = cm_mpmc_enq(&mq, in);
+    ck_assert_int_eq(ret, -1);
+
+    //third test: mix single & bulk dequeues across the wrap
+    memset(out, 0, sizeof(out));
+    ret = cm_mpmc_deq(&mq, &out[0]);
+    ck_assert_int_eq(ret, 0);
+    ret = cm_mpmc_deq_n(&mq, out + 1, MPMC_SLOTS * 2);
+    ck_assert_int_eq(ret, MPMC_SLOTS - 1);
+    for (int i = 0; i < MPMC_SLOTS; ++i) ck_assert_int_eq(out[i], i);
+
+    //fourth test: dequeue from an empty queue
+    ret = cm_mpmc_deq_n(&mq, out, 4);
+    ck_assert_int_eq(ret, 0);
+    ret = cm_mpmc_deq(&mq, &value);
+    ck_assert_int_eq(ret, -1);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_mpmc_*() across many threads [mpmc fixture]
+START_TEST(test_mpmc_threads) {
+
+    //first test: non-blocking single & bulk calls
+    _mpmc_stress(false);
+
+    //second test: blocking calls
+    _mpmc_stress(true);
+
+    return;
+
+} END_TEST
+
+
+
+/*
+ *  --- [SUITE] ---
+ */
+
+Suite * que_suite() {
+
+    //test cases
+    TCase * tc_new_del_spsc;
+    TCase * tc_spsc_enq_deq;
+    TCase * tc_spsc_bulk;
+    TCase * tc_spsc_zero_copy;
+    TCase * tc_spsc_threads;
+    TCase * tc_new_del_mpmc;
+    TCase * tc_mpmc_enq_deq;
+    TCase * tc_mpmc_bulk;
+    TCase * tc_mpmc_threads;
+
+    Suite * s = suite_create("queue");
+
+
+    //cm_new_spsc()
+    tc_new_del_spsc = tcase_create("new_del_spsc");
+    tcase_add_test(tc_new_del_spsc, test_new_del_spsc);
+
+    //cm_spsc_enq() & cm_spsc_deq()
+    tc_spsc_enq_deq = tcase_create("spsc_enq_deq");
+    tcase_add_checked_fixture(tc_spsc_enq_deq, _setup_spsc, _teardown_spsc);
+    tcase_add_test(tc_spsc_enq_deq, test_spsc_enq_deq);
+
+    //cm_spsc_*_n()
+    tc_spsc_bulk = tcase_create("spsc_bulk");
+    tcase_add_checked_fixture(tc_spsc_bulk, _setup_spsc, _teardown_spsc);
+    tcase_add_test(tc_spsc_bulk, test_spsc_bulk);
+
+    //cm_spsc_rsv(), cm_spsc_cmt(), cm_spsc_pek() & cm_spsc_rls()
+    tc_spsc_zero_copy = tcase_create("spsc_zero_copy");
+    tcase_add_checked_fixture(tc_spsc_zero_copy,
+                              _setup_spsc, _teardown_spsc);
+    tcase_add_test(tc_spsc_zero_copy, test_spsc_zero_copy);
+
+    //two threads
+    tc_spsc_threads = tcase_create("spsc_threads");
+    tcase_add_checked_fixture(tc_spsc_threads, _setup_spsc, _teardown_spsc);
+    tcase_set_timeout(tc_spsc_threads, 30);
+    tcase_add_test(tc_spsc_threads, test_spsc_threads);
+
+    //cm_new_mpmc()
+    tc_new_del_mpmc = tcase_create("new_del_mpmc");
+    tcase_add_test(tc_new_del_mpmc, test_new_del_mpmc);
+
+    //cm_mpmc_enq*() & cm_mpmc_deq*()
+    tc_mpmc_enq_deq = tcase_create("mpmc_enq_deq");
+    tcase_add_checked_fixture(tc_mpmc_enq_deq, _setup_mpmc, _teardown_mpmc);
+    tcase_add_test(tc_mpmc_enq_deq, test_mpmc_enq_deq);
+
+    //cm_mpmc_*_n()
+    tc_mpmc_bulk = tcase_create("mpmc_bulk");
+    tcase_add_checked_fixture(tc_mpmc_bulk, _setup_mpmc, _teardown_mpmc);
+    tcase_add_test(tc_mpmc_bulk, test_mpmc_bulk);
+
+    //many threads
+    tc_mpmc_threads = tcase_create("mpmc_threads");
+    tcase_add_checked_fixture(tc_mpmc_threads, _setup_mpmc, _teardown_mpmc);
+    tcase_set_timeout(tc_mpmc_threads, 60);
+    tcase_add_test(tc_mpmc_threads, test_mpmc_threads);
+
+    //add test cases to queue suite
+    suite_add_tcase(s, tc_new_del_spsc);
+    suite_add_tcase(s, tc_spsc_enq_deq);
+    suite_add_tcase(s, tc_spsc_bulk);
+    suite_add_tcase(s, tc_spsc_zero_copy);
+    suite_add_tcase(s, tc_spsc_threads);
+    suite_add_tcase(s, tc_new_del_mpmc);
+    suite_add_tcase(s, tc_mpmc_enq_deq);
+    suite_add_tcase(s, tc_mpmc_bulk);
+    suite_add_tcase(s, tc_mpmc_threads);
+
+    return s;
+}
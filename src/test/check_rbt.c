@@ -65,7 +65,7 @@ static void _assert_node(cm_rbt_node * n, int n_data,
         
         if (left_data != DATA_NULL) {
             ck_assert_ptr_nonnull(n->left);
-            ck_assert(n->left->parent_side == CM_RBT_LESS);
+            ck_assert(CM_RBT_SIDE(n->left) == CM_RBT_LESS);
             temp_data = GET_NODE_DATA(n->left);
             ck_assert_int_eq(temp_data->x, left_data);
     
@@ -79,7 +79,7 @@ static void _assert_node(cm_rbt_node * n, int n_data,
     
         if (right_data != DATA_NULL) {
             ck_assert_ptr_nonnull(n->right);
-            ck_assert(n->right->parent_side == CM_RBT_MORE);
+            ck_assert(CM_RBT_SIDE(n->right) == CM_RBT_MORE);
             temp_data = GET_NODE_DATA(n->right);
             ck_assert_int_eq(temp_data->x, right_data);
     
@@ -92,21 +92,21 @@ static void _assert_node(cm_rbt_node * n, int n_data,
     if (parent_data != DATA_NOCHECK) {
     
         if (parent_data != DATA_NULL) {
-            ck_assert_ptr_nonnull(n->parent);
+            ck_assert_ptr_nonnull(CM_RBT_PARENT(n));
         
-            if (n->parent_side == CM_RBT_LESS) {
-                ck_assert_ptr_eq(n->parent->left, n);
+            if (CM_RBT_SIDE(n) == CM_RBT_LESS) {
+                ck_assert_ptr_eq(CM_RBT_PARENT(n)->left, n);
             }
 
-            if (n->parent_side == CM_RBT_MORE) {
-                ck_assert_ptr_eq(n->parent->right, n);
+            if (CM_RBT_SIDE(n) == CM_RBT_MORE) {
+                ck_assert_ptr_eq(CM_RBT_PARENT(n)->right, n);
             }
 
-            temp_data = GET_NODE_DATA(n->parent);
+            temp_data = GET_NODE_DATA(CM_RBT_PARENT(n));
             ck_assert_int_eq(temp_data->x, parent_data);
     
         } else {
-            ck_assert_ptr_null(n->parent);
+            ck_assert_ptr_null(CM_RBT_PARENT(n));
             ck_assert_ptr_eq(t.root, n);
         }
     }
@@ -145,7 +145,7 @@ static void _assert_fix_data(struct _rbt_fix_data * fix_data,
     ck_assert_ptr_nonnull(n);
     temp_data = GET_NODE_DATA(n);
     ck_assert_int_eq(temp_data->x, n_data); 
-    if (n->parent_side == CM_RBT_ROOT) ck_assert_ptr_eq(t.root, n);
+    if (CM_RBT_SIDE(n) == CM_RBT_ROOT) ck_assert_ptr_eq(t.root, n);
 
     
     //parent
@@ -153,15 +153,15 @@ static void _assert_fix_data(struct _rbt_fix_data * fix_data,
         
         ck_assert_ptr_nonnull(fix_data->parent);
 
-        if (n->parent_side == CM_RBT_LESS) {
+        if (CM_RBT_SIDE(n) == CM_RBT_LESS) {
             ck_assert_ptr_eq(fix_data->parent->left, n);
         }
 
-        if (n->parent_side == CM_RBT_MORE) {
+        if (CM_RBT_SIDE(n) == CM_RBT_MORE) {
             ck_assert_ptr_eq(fix_data->parent->right, n);
         }
 
-        if (fix_data->parent->parent_side == CM_RBT_ROOT) {
+        if (CM_RBT_SIDE(fix_data->parent) == CM_RBT_ROOT) {
             ck_assert_ptr_eq(t.root, fix_data->parent);
             ck_assert_ptr_null(fix_data->grandparent);
             ck_assert_ptr_null(fix_data->uncle);
@@ -185,19 +185,19 @@ static void _assert_fix_data(struct _rbt_fix_data * fix_data,
         ck_assert_ptr_nonnull(fix_data->parent);
         ck_assert_ptr_nonnull(fix_data->grandparent);
 
-        if (fix_data->parent->parent_side == CM_RBT_LESS) {
+        if (CM_RBT_SIDE(fix_data->parent) == CM_RBT_LESS) {
             ck_assert_ptr_eq(fix_data->grandparent->left, fix_data->parent);
         }
 
-        if (fix_data->parent->parent_side == CM_RBT_MORE) {
+        if (CM_RBT_SIDE(fix_data->parent) == CM_RBT_MORE) {
             ck_assert_ptr_eq(fix_data->grandparent->right, fix_data->parent);
         }
 
-        if (fix_data->grandparent->parent_side == CM_RBT_ROOT) {
+        if (CM_RBT_SIDE(fix_data->grandparent) == CM_RBT_ROOT) {
             ck_assert_ptr_eq(t.root, fix_data->grandparent);
         } 
 
-        ck_assert(fix_data->parent->parent_side != CM_RBT_ROOT);
+        ck_assert(CM_RBT_SIDE(fix_data->parent) != CM_RBT_ROOT);
         temp_data = GET_NODE_DATA(fix_data->grandparent);
         ck_assert_int_eq(temp_data->x, grandparent_data);
     
@@ -216,15 +216,15 @@ static void _assert_fix_data(struct _rbt_fix_data * fix_data,
         ck_assert_ptr_nonnull(fix_data->parent);
         ck_assert_ptr_nonnull(fix_data->grandparent);
 
-        if (fix_data->uncle->parent_side == CM_RBT_LESS) {
+        if (CM_RBT_SIDE(fix_data->uncle) == CM_RBT_LESS) {
             ck_assert_ptr_eq(fix_data->grandparent->left, fix_data->uncle);
         }
 
-        if (fix_data->uncle->parent_side == CM_RBT_MORE) {
+        if (CM_RBT_SIDE(fix_data->uncle) == CM_RBT_MORE) {
             ck_assert_ptr_eq(fix_data->grandparent->right, fix_data->uncle);
         }
 
-        ck_assert(fix_data->uncle->parent_side != CM_RBT_ROOT);
+        ck_assert(CM_RBT_SIDE(fix_data->uncle) != CM_RBT_ROOT);
         temp_data = GET_NODE_DATA(fix_data->uncle);
         ck_assert_int_eq(temp_data->x, uncle_data);
 
@@ -240,15 +240,15 @@ static void _assert_fix_data(struct _rbt_fix_data * fix_data,
         ck_assert_ptr_nonnull(fix_data->sibling);
         ck_assert_ptr_nonnull(fix_data->parent);
     
-        if (fix_data->sibling->parent_side == CM_RBT_LESS) {
+        if (CM_RBT_SIDE(fix_data->sibling) == CM_RBT_LESS) {
             ck_assert_ptr_eq(fix_data->parent->left, fix_data->sibling);
         }
 
-        if (fix_data->sibling->parent_side == CM_RBT_MORE) {
+        if (CM_RBT_SIDE(fix_data->sibling) == CM_RBT_MORE) {
             ck_assert_ptr_eq(fix_data->parent->right, fix_data->sibling);
         }
 
-        ck_assert(fix_data->sibling->parent_side != CM_RBT_ROOT);
+        ck_assert(CM_RBT_SIDE(fix_data->sibling) != CM_RBT_ROOT);
         temp_data = GET_NODE_DATA(fix_data->sibling);
         ck_assert_int_eq(temp_data->x, sibling_data);
     
@@ -306,8 +306,8 @@ static void _recurse_compare_trees(cm_rbt_node * node_0,
     //ck_assert_int_eq(data_0->x, data_1->x);
 
     //perform node assertions
-    ck_assert_int_eq(node_0->colour, node_1->colour);
-    ck_assert_int_eq(node_0->parent_side, node_1->parent_side);
+    ck_assert_int_eq(CM_RBT_COLOUR(node_0), CM_RBT_COLOUR(node_1));
+    ck_assert_int_eq(CM_RBT_SIDE(node_0), CM_RBT_SIDE(node_1));
 
     //recurse down
     _recurse_compare_trees(node_0->left, node_1->left);
@@ -346,6 +346,132 @@ static int _assert_callback(const cm_rbt_node * node, void * ctx) {
 
 
 
+//assert batches arrive in key order & record their lengths
+struct _assert_batch_ctx {
+
+    int next;
+    int calls;
+    int lens[16];
+};
+
+static int _assert_batch(void * const * keys, void * const * data,
+                         const int len, void * ctx) {
+
+    struct _assert_batch_ctx * real_ctx = ctx;
+
+
+    for (int i = 0; i < len; ++i) {
+        ck_assert_int_eq(*(int *) keys[i], real_ctx->next);
+        ck_assert_int_eq(*(int *) data[i], real_ctx->next);
+        real_ctx->next += 5;
+    }
+    real_ctx->lens[real_ctx->calls++] = len;
+
+    return 0;
+}
+
+
+
+//return the black height of a valid subtree & count its nodes
+static int _assert_subtree(const cm_rbt_node * node, const int * min,
+                           const int * max, int * count) {
+
+    int key, left, right;
+
+
+    if (node == NULL) return 0;
+
+    key = ((data *) node->key)->x;
+    if (min != NULL) ck_assert_int_gt(key, *min);
+    if (max != NULL) ck_assert_int_lt(key, *max);
+
+    if (CM_RBT_COLOUR(node) == CM_RBT_RED) {
+        if (node->left != NULL)
+            ck_assert_int_eq(CM_RBT_COLOUR(node->left), CM_RBT_BLACK);
+        if (node->right != NULL)
+            ck_assert_int_eq(CM_RBT_COLOUR(node->right), CM_RBT_BLACK);
+    }
+    if (node->left != NULL) {
+        ck_assert_ptr_eq(CM_RBT_PARENT(node->left), node);
+        ck_assert_int_eq(CM_RBT_SIDE(node->left), CM_RBT_LESS);
+    }
+    if (node->right != NULL) {
+        ck_assert_ptr_eq(CM_RBT_PARENT(node->right), node);
+        ck_assert_int_eq(CM_RBT_SIDE(node->right), CM_RBT_MORE);
+    }
+
+    left  = _assert_subtree(node->left, min, &key, count);
+    right = _assert_subtree(node->right, &key, max, count);
+    ck_assert_int_eq(left, right);
+    ++*count;
+
+    return left + (CM_RBT_COLOUR(node) == CM_RBT_BLACK ? 1 : 0);
+}
+
+
+
+//assert the red-black properties of a whole tree
+static void _assert_tree(const cm_rbt * tree) {
+
+    int count = 0;
+
+
+    if (tree->root != NULL) {
+        ck_assert_int_eq(CM_RBT_COLOUR(tree->root), CM_RBT_BLACK);
+        ck_assert_int_eq(CM_RBT_SIDE(tree->root), CM_RBT_ROOT);
+    }
+    _assert_subtree(tree->root, NULL, NULL, &count);
+    ck_assert_int_eq(count, tree->size);
+
+    return;
+}
+
+
+
+//return the leftmost key of a non-empty tree
+static int _min_key(const cm_rbt * tree) {
+
+    cm_rbt_node * node = tree->root;
+
+
+    while (node->left != NULL) node = node->left;
+
+    return ((data *) node->key)->x;
+}
+
+
+
+//return the leftmost or rightmost node of a non-empty tree
+static cm_rbt_node * _edge_node(const cm_rbt * tree, 
+                                const enum cm_rbt_side side) {
+
+    cm_rbt_node * node = tree->root;
+
+
+    if (side == CM_RBT_LESS) while (node->left != NULL) node = node->left;
+    if (side == CM_RBT_MORE) while (node->right != NULL) node = node->right;
+
+    return node;
+}
+
+
+
+//fill an empty tree with keys [from, to) in a scattered order
+static void _fill_tree(cm_rbt * tree, const int from, const int to) {
+
+    data k;
+
+
+    for (int i = 0; i < to - from; ++i) {
+        k.x = from + (i * 37) % (to - from);
+        cm_rbt_set(tree, &k, &k);
+    }
+
+    return;
+}
+
+
+
 /*
  *  --- [FIXTURES] ---
  */
@@ -366,6 +492,18 @@ enum cm_rbt_side compare(const void * b_1, const void * b_2) {
 
 
 
+//counts its calls, for asserting search costs
+static int compares;
+
+static enum cm_rbt_side _count_compare(const void * b_1, const void * b_2) {
+
+    ++compares;
+
+    return compare(b_1, b_2);
+}
+
+
+
 
 //empty red-black tree setup
 static void _setup_emp() {
@@ -378,6 +516,27 @@ static void _setup_emp() {
 
 
 
+//allocate a stub node the way the tree would
+static cm_rbt_node * _new_stub_node() {
+
+    cm_rbt_node * node;
+
+
+#ifdef CM_RBT_COMPACT
+    node = malloc(sizeof(cm_rbt_node) + 2 * sizeof(d));
+    node->key  = (cm_byte *) node + sizeof(cm_rbt_node);
+    node->data = (cm_byte *) node->key + sizeof(d);
+#else
+    node = malloc(sizeof(cm_rbt_node));
+    node->key = malloc(sizeof(d));
+    node->data = malloc(sizeof(d));
+#endif
+
+    return node;
+}
+
+
+
 //initialiser of a stub node
 static void _setup_stub_node(cm_rbt_node * node, cm_rbt_node * left, 
                              cm_rbt_node * right, cm_rbt_node * parent, 
@@ -387,9 +546,15 @@ static void _setup_stub_node(cm_rbt_node * node, cm_rbt_node * left,
     //set relevant fields
     node->left = left;
     node->right = right;
+#ifdef CM_RBT_COMPACT
+    node->parent_bits = (uintptr_t) parent 
+                        | ((uintptr_t) parent_side << CM_RBT_SIDE_SHIFT)
+                        | (uintptr_t) colour;
+#else
     node->parent = parent;
     node->parent_side = parent_side;
     node->colour = colour;
+#endif
 
     return;
 }
@@ -418,9 +583,7 @@ static void _setup_stub() {
     //allocate each node
     for (int i = 0; i < 7; ++i) {
         
-        n[i] = malloc(sizeof(cm_rbt_node));
-        n[i]->key = malloc(sizeof(d));
-        n[i]->data = malloc(sizeof(d));
+        n[i] = _new_stub_node();
     
         *((int *) n[i]->key)  = i;
         *((int *) n[i]->data) = i;
@@ -460,6 +623,7 @@ static void _setup_sorted_stub() {
 
     t.size = 10;
     t.compare = compare;
+    t.key_kind = CM_RBT_KEY_FN;
     t.key_sz  = sizeof(d.x);
     t.data_sz = sizeof(d);
     t.is_init = true;
@@ -470,9 +634,7 @@ static void _setup_sorted_stub() {
     //allocate each node
     for (int i = 0; i < 10; ++i) {
         
-        n[i] = malloc(sizeof(cm_rbt_node));
-        n[i]->key = malloc(sizeof(d));
-        n[i]->data = malloc(sizeof(d));
+        n[i] = _new_stub_node();
     
         *((int *) n[i]->key)  = values[i];
         *((int *) n[i]->data) = values[i];
@@ -549,9 +711,16 @@ START_TEST(test__new_del_node) {
     ck_assert_ptr_nonnull(n);
     ck_assert_ptr_nonnull(n->key);
     ck_assert_ptr_nonnull(n->data);
-    ck_assert(n->colour == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(n) == CM_RBT_RED);
+    ck_assert_ptr_null(CM_RBT_PARENT(n));
 
-    _rbt_del_node(n);
+#ifdef CM_RBT_COMPACT
+    //compact nodes are 5 words, with the key & data inline
+    ck_assert_int_eq(sizeof(cm_rbt_node), 5 * sizeof(void *));
+    ck_assert_ptr_eq(n->key, (cm_byte *) n + sizeof(cm_rbt_node));
+#endif
+
+    _rbt_del_node(&t, n);
 
 } END_TEST
 
@@ -622,13 +791,13 @@ START_TEST(test__transplant) {
     del_node = t.root->left;
     _rbt_transplant(&t, t.root->left, t.root->left->left);
     _assert_node(t.root->left, 3, DATA_NULL, DATA_NULL, 0);
-    _rbt_del_node(del_node);
+    _rbt_del_node(&t, del_node);
 
     //second test: transplant 6 into 4
     del_node = t.root->right->left;
     _rbt_transplant(&t, t.root->right->left, t.root->right->left->right);
     _assert_node(t.root->right->left, 6, DATA_NULL, DATA_NULL, 2);
-    _rbt_del_node(del_node);
+    _rbt_del_node(&t, del_node);
 
     return;
 
@@ -911,9 +1080,9 @@ START_TEST(test__ins_case_1) {
 
     //setup
     node = t.root->right->left->right;
-    t.root->right->colour = CM_RBT_BLACK;
-    t.root->right->left->colour = CM_RBT_RED;
-    t.root->right->right->colour = CM_RBT_RED;
+    _rbt_set_colour(t.root->right, CM_RBT_BLACK);
+    _rbt_set_colour(t.root->right->left, CM_RBT_RED);
+    _rbt_set_colour(t.root->right->right, CM_RBT_RED);
     _set_fix_data(&f_data, t.root->right->left, t.root->right, 
                   t.root->right->right, NULL);
 
@@ -921,9 +1090,9 @@ START_TEST(test__ins_case_1) {
     //only test:
     _rbt_ins_case_1(&t, &node, &f_data);
     
-    ck_assert(t.root->right->colour == CM_RBT_RED);
-    ck_assert(t.root->right->left->colour == CM_RBT_BLACK);
-    ck_assert(t.root->right->right->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->right) == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(t.root->right->left) == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->right->right) == CM_RBT_BLACK);
     
     ck_assert_ptr_eq(node, t.root->right);
 
@@ -941,12 +1110,12 @@ START_TEST(test__ins_case_2) {
 
     //setup
     node = t.root->left;
-    t.root->colour = CM_RBT_RED;
+    _rbt_set_colour(t.root, CM_RBT_RED);
     _set_fix_data(&f_data, t.root, NULL, NULL, NULL);
 
     //only test:
     _rbt_ins_case_2(&t, &node, &f_data);
-    ck_assert(t.root->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root) == CM_RBT_BLACK);
 
     return;
 
@@ -962,9 +1131,9 @@ START_TEST(test__ins_case_3) {
 
     //setup
     node = t.root->right->left->right;
-    t.root->right->left->colour = CM_RBT_RED;
-    t.root->right->colour = CM_RBT_BLACK;
-    t.root->right->right->colour = CM_RBT_BLACK;
+    _rbt_set_colour(t.root->right->left, CM_RBT_RED);
+    _rbt_set_colour(t.root->right, CM_RBT_BLACK);
+    _rbt_set_colour(t.root->right->right, CM_RBT_BLACK);
     _set_fix_data(&f_data, t.root->right->left,
                   t.root->right, t.root->right->right, NULL);
 
@@ -993,10 +1162,10 @@ START_TEST(test__ins_case_4) {
     //setup
     t.root->right->left->left = t.root->right->left->right;
     t.root->right->left->right = NULL;
-    t.root->right->left->left->parent_side = CM_RBT_LESS;
+    _rbt_set_side(t.root->right->left->left, CM_RBT_LESS);
     node = t.root->right->left->left;
-    t.root->right->colour = CM_RBT_BLACK;
-    t.root->right->left->colour = CM_RBT_BLACK;
+    _rbt_set_colour(t.root->right, CM_RBT_BLACK);
+    _rbt_set_colour(t.root->right->left, CM_RBT_BLACK);
     _set_fix_data(&f_data, t.root->right->left, t.root->right,
                   t.root->right->right, NULL);
 
@@ -1010,8 +1179,8 @@ START_TEST(test__ins_case_4) {
     
     ck_assert_ptr_eq(node, t.root->right->left);
     
-    ck_assert(t.root->right->colour == CM_RBT_BLACK);
-    ck_assert(t.root->right->right->colour == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(t.root->right) == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->right->right) == CM_RBT_RED);
 
     return;
 
@@ -1027,9 +1196,9 @@ START_TEST(test__rmv_case_1) {
     
     //setup
     node = t.root->right->right;
-    t.root->right->left->right->colour = CM_RBT_BLACK;
-    t.root->right->left->colour = CM_RBT_RED;
-    t.root->right->colour = CM_RBT_BLACK;
+    _rbt_set_colour(t.root->right->left->right, CM_RBT_BLACK);
+    _rbt_set_colour(t.root->right->left, CM_RBT_RED);
+    _rbt_set_colour(t.root->right, CM_RBT_BLACK);
     _set_fix_data(&f_data, t.root->right, t.root, 
                   t.root->left, t.root->right->left);
     
@@ -1042,8 +1211,8 @@ START_TEST(test__rmv_case_1) {
     _assert_node(t.root->right->right->left, 6, DATA_NULL, DATA_NULL, 2);
     _assert_node(t.root->right->right->right, 5, DATA_NULL, DATA_NULL, 2);
     
-    ck_assert(t.root->right->colour == CM_RBT_BLACK);
-    ck_assert(t.root->right->right->colour == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(t.root->right) == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->right->right) == CM_RBT_RED);
 
     return;
 } END_TEST
@@ -1058,13 +1227,13 @@ START_TEST(test__rmv_case_2) {
 
     //setup
     node = t.root->right->right;
-    t.root->right->left->right->colour = CM_RBT_BLACK;
+    _rbt_set_colour(t.root->right->left->right, CM_RBT_BLACK);
     _set_fix_data(&f_data, t.root->right, t.root,
                   t.root->left, t.root->right->left);    
 
     //only test:
     _rbt_rmv_case_2(&t, &node, &f_data);
-    ck_assert(t.root->right->left->colour == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(t.root->right->left) == CM_RBT_RED);
 
     return;
 
@@ -1092,8 +1261,8 @@ START_TEST(test__rmv_case_3) {
     _assert_node(t.root->right->left->left, 4, DATA_NULL, DATA_NULL, 6);
 
     ck_assert_ptr_eq(node, t.root->right->right);    
-    ck_assert(t.root->right->left->colour == CM_RBT_BLACK);
-    ck_assert(t.root->right->left->left->colour == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(t.root->right->left) == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->right->left->left) == CM_RBT_RED);
 
     return;
 
@@ -1111,7 +1280,7 @@ START_TEST(test__rmv_case_4) {
     node = t.root->right->right;
     t.root->right->left->left = t.root->right->left->right;
     t.root->right->left->right = NULL;
-    t.root->right->left->left->parent_side = CM_RBT_LESS;
+    _rbt_set_side(t.root->right->left->left, CM_RBT_LESS);
     _set_fix_data(&f_data, t.root->right, t.root,
                   t.root->left, t.root->right->left);
 
@@ -1127,9 +1296,9 @@ START_TEST(test__rmv_case_4) {
 
     ck_assert_ptr_eq(node, t.root);
 
-    ck_assert(t.root->right->colour == CM_RBT_RED);
-    ck_assert(t.root->right->left->colour == CM_RBT_BLACK);
-    ck_assert(t.root->right->right->colour = CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->right) == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(t.root->right->left) == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->right->right) == CM_RBT_BLACK);
 
     return;
 
@@ -1214,7 +1383,7 @@ START_TEST(test_rbt_set) {
     _assert_node_fast(ret, 20);
     
     _assert_node(t.root, 20, DATA_NULL, DATA_NULL, DATA_NULL);
-    ck_assert(t.root->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root) == CM_RBT_BLACK);
 
 
     //second test: case 2
@@ -1223,9 +1392,9 @@ START_TEST(test_rbt_set) {
     _assert_node_fast(ret, 25);
     
     _assert_node(t.root, 20, DATA_NULL, 25, DATA_NULL);
-    ck_assert(t.root->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root) == CM_RBT_BLACK);
     _assert_node(t.root->right, 25, DATA_NULL, DATA_NULL, 20);
-    ck_assert(t.root->right->colour == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(t.root->right) == CM_RBT_RED);
 
     
     //third test: case 4
@@ -1234,11 +1403,11 @@ START_TEST(test_rbt_set) {
     _assert_node_fast(ret, 30);
     
     _assert_node(t.root, 25, 20, 30, DATA_NULL);
-    ck_assert(t.root->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root) == CM_RBT_BLACK);
     _assert_node(t.root->left, 20, DATA_NULL, DATA_NULL, 25);
-    ck_assert(t.root->left->colour == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(t.root->left) == CM_RBT_RED);
     _assert_node(t.root->right, 30, DATA_NULL, DATA_NULL, 25);
-    ck_assert(t.root->right->colour == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(t.root->right) == CM_RBT_RED);
 
 
     //fourth test: case 1
@@ -1247,10 +1416,10 @@ START_TEST(test_rbt_set) {
     _assert_node_fast(ret, 22);
 
     _assert_node(t.root->left, 20, DATA_NULL, 22, 25);
-    ck_assert(t.root->left->colour == CM_RBT_BLACK);
-    ck_assert(t.root->right->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->left) == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->right) == CM_RBT_BLACK);
     _assert_node(t.root->left->right, 22, DATA_NULL, DATA_NULL, 20);
-    ck_assert(t.root->left->right->colour == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(t.root->left->right) == CM_RBT_RED);
 
 
     //fifth test: case 3, case 4
@@ -1259,11 +1428,11 @@ START_TEST(test_rbt_set) {
     _assert_node_fast(ret, 21);
     
     _assert_node(t.root->left, 21, 20, 22, 25);
-    ck_assert(t.root->left->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->left) == CM_RBT_BLACK);
     _assert_node(t.root->left->left, 20, DATA_NULL, DATA_NULL, 21);
-    ck_assert(t.root->left->left->colour == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(t.root->left->left) == CM_RBT_RED);
     _assert_node(t.root->left->right, 22, DATA_NULL, DATA_NULL, 21);
-    ck_assert(t.root->left->right->colour == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(t.root->left->right) == CM_RBT_RED);
 
     return;
     
@@ -1290,11 +1459,11 @@ START_TEST(test_rbt_rmv) {
     ck_assert_int_eq(ret, 0);
 
     _assert_node(t.root->right, 50, 40, 55, 20);
-    ck_assert(t.root->right->colour == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(t.root->right) == CM_RBT_RED);
     _assert_node(t.root->right->left, 40, DATA_NULL, 45, 50);
-    ck_assert(t.root->right->left->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->right->left) == CM_RBT_BLACK);
     _assert_node(t.root->right->right, 55, DATA_NULL, DATA_NULL, 50);
-    ck_assert(t.root->right->right->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->right->right) == CM_RBT_BLACK);
     _assert_node(t.root->right->left->right, 45, DATA_NULL, DATA_NULL, 40);
 
 
@@ -1304,13 +1473,13 @@ START_TEST(test_rbt_rmv) {
     ck_assert_int_eq(ret, 0);
 
     _assert_node(t.root, 20, 10, 45, DATA_NULL);
-    ck_assert(t.root->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root) == CM_RBT_BLACK);
     _assert_node(t.root->right, 45, 40, 50, 20);
-    ck_assert(t.root->right->colour == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(t.root->right) == CM_RBT_RED);
     _assert_node(t.root->right->left, 40, DATA_NULL, DATA_NULL, 45);
-    ck_assert(t.root->right->left->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->right->left) == CM_RBT_BLACK);
     _assert_node(t.root->right->right, 50, DATA_NULL, DATA_NULL, 45);
-    ck_assert(t.root->right->right->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->right->right) == CM_RBT_BLACK);
 
 
     //fourth test: case 1 & 2 (red parent)
@@ -1327,13 +1496,13 @@ START_TEST(test_rbt_rmv) {
     ck_assert_int_eq(ret, 0);
 
     _assert_node(t.root, 45, 20, 50, DATA_NULL);
-    ck_assert(t.root->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root) == CM_RBT_BLACK);
     _assert_node(t.root->left, 20, DATA_NULL, 40, 45);
-    ck_assert(t.root->left->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->left) == CM_RBT_BLACK);
     _assert_node(t.root->right, 50, DATA_NULL, DATA_NULL, 45);
-    ck_assert(t.root->right->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->right) == CM_RBT_BLACK);
     _assert_node(t.root->left->right, 40, DATA_NULL, DATA_NULL, 20);
-    ck_assert(t.root->left->right->colour == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(t.root->left->right) == CM_RBT_RED);
 
 
     //fifth test: 2 children (root, no fixes)
@@ -1348,15 +1517,15 @@ START_TEST(test_rbt_rmv) {
     ck_assert_int_eq(ret, 0);
 
     _assert_node(t.root, 40, 20, 50, DATA_NULL);
-    ck_assert(t.root->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root) == CM_RBT_BLACK);
     _assert_node(t.root->left, 20, 15, 30, 40);
-    ck_assert(t.root->left->colour == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(t.root->left) == CM_RBT_RED);
     _assert_node(t.root->right, 50, DATA_NULL, DATA_NULL, 40);
-    ck_assert(t.root->right->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->right) == CM_RBT_BLACK);
     _assert_node(t.root->left->left, 15, DATA_NULL, DATA_NULL, 20);
-    ck_assert(t.root->left->left->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->left->left) == CM_RBT_BLACK);
     _assert_node(t.root->left->right, 30, DATA_NULL, DATA_NULL, 20);
-    ck_assert(t.root->left->right->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->left->right) == CM_RBT_BLACK);
 
     //sixth test: 2 children (non-root, fixes)
     d.x = 20;
@@ -1365,9 +1534,9 @@ START_TEST(test_rbt_rmv) {
 
     _assert_node(t.root, 40, 15, 50, DATA_NULL);
     _assert_node(t.root->left, 15, DATA_NULL, 30, 40);
-    ck_assert(t.root->left->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->left) == CM_RBT_BLACK);
     _assert_node(t.root->left->right, 30, DATA_NULL, DATA_NULL, 15);
-    ck_assert(t.root->left->right->colour == CM_RBT_RED);
+    ck_assert(CM_RBT_COLOUR(t.root->left->right) == CM_RBT_RED);
 
     //seventh test: 1 child
     d.x = 15;
@@ -1376,7 +1545,19 @@ START_TEST(test_rbt_rmv) {
 
     _assert_node(t.root, 40, 30, 50, DATA_NULL);
     _assert_node(t.root->left, 30, DATA_NULL, DATA_NULL, 40);
-    ck_assert(t.root->left->colour == CM_RBT_BLACK);
+    ck_assert(CM_RBT_COLOUR(t.root->left) == CM_RBT_BLACK);
+
+    //eighth test: 1 child (root)
+    d.x = 50;
+    ret = cm_rbt_rmv(&t, &d.x);
+    ck_assert_int_eq(ret, 0);
+
+    d.x = 40;
+    ret = cm_rbt_rmv(&t, &d.x);
+    ck_assert_int_eq(ret, 0);
+
+    _assert_node(t.root, 30, DATA_NULL, DATA_NULL, DATA_NULL);
+    ck_assert(CM_RBT_COLOUR(t.root) == CM_RBT_BLACK);
     
     return;
     
@@ -1402,13 +1583,11 @@ START_TEST(test_rbt_uln) {
     ret = cm_rbt_uln(&t, &d.x);
     ck_assert_ptr_nonnull(ret);
 
-    ck_assert_ptr_null(ret->parent);
+    ck_assert_ptr_null(CM_RBT_PARENT(ret));
     ck_assert_ptr_null(ret->left);
     ck_assert_ptr_null(ret->right);
 
-    free(ret->key);
-    free(ret->data);
-    free(ret);
+    cm_del_rbt_node(ret);
 
     return;
     
@@ -1497,6 +1676,449 @@ START_TEST(test_rbt_iter) {
 } END_TEST
 
 
+//cm_rbt_iter_bat() [no fixture]
+START_TEST(test_rbt_iter_bat) {
+
+    int ret;
+    struct _assert_batch_ctx ctx;
+
+
+    cm_new_rbt(&t, sizeof(d), sizeof(d), compare);
+
+    //first test: an empty tree makes no calls
+    ctx = (struct _assert_batch_ctx) {0};
+    ret = cm_rbt_iter_bat(&t, _assert_batch, &ctx);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(ctx.calls, 0);
+
+    //second test: full batches & a remainder, in key order
+    for (int i = 0; i < (CM_ITER_BATCH * 3) + 4; ++i) {
+        d.x = ((i * 37) % ((CM_ITER_BATCH * 3) + 4)) * 5;
+        cm_rbt_set(&t, &d, &d);
+    }
+
+    ctx = (struct _assert_batch_ctx) {0};
+    ret = cm_rbt_iter_bat(&t, _assert_batch, &ctx);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(ctx.calls, 4);
+    ck_assert_int_eq(ctx.lens[0], CM_ITER_BATCH);
+    ck_assert_int_eq(ctx.lens[3], 4);
+    ck_assert_int_eq(ctx.next, t.size * 5);
+
+    cm_del_rbt(&t);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_rbt_split() & cm_rbt_join() [no fixture]
+START_TEST(test_rbt_split_join) {
+
+    int ret;
+    data k;
+    cm_rbt l, r;
+    int keys[] = {-5, 0, 1, 37, 100, 255, 256, 300};
+
+
+    //first test: split at keys below, inside & above the range, then rejoin
+    for (int i = 0; i < (int) (sizeof(keys) / sizeof(keys[0])); ++i) {
+
+        cm_new_rbt(&t, sizeof(d), sizeof(d), compare);
+        _fill_tree(&t, 0, 256);
+
+        k.x = keys[i];
+        ret = cm_rbt_split(&t, &k, &l, &r);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(t.size, 0);
+        ck_assert_ptr_null(t.root);
+
+        _assert_tree(&l);
+        _assert_tree(&r);
+        ck_assert_int_eq(l.size, keys[i] < 0 ? 0 : keys[i] > 256 ? 256 : keys[i]);
+        ck_assert_int_eq(l.size + r.size, 256);
+        if (r.size != 0) {
+            ck_assert_int_eq(_min_key(&r), l.size);
+        }
+
+        ret = cm_rbt_join(&l, &r);
+        ck_assert_int_eq(ret, 0);
+        _assert_tree(&l);
+        ck_assert_int_eq(l.size, 256);
+        ck_assert_int_eq(r.size, 0);
+
+        for (int j = 0; j < 256; ++j) {
+            k.x = j;
+            ck_assert_ptr_nonnull(cm_rbt_get_n(&l, &k));
+        }
+
+        cm_del_rbt(&l);
+        cm_del_rbt(&r);
+        cm_del_rbt(&t);
+    }
+
+    //second test: join trees of very different heights
+    for (int i = 0; i < 2; ++i) {
+
+        cm_new_rbt(&l, sizeof(d), sizeof(d), compare);
+        cm_new_rbt(&r, sizeof(d), sizeof(d), compare);
+        _fill_tree(&l, 0, i == 0 ? 1 : 1000);
+        _fill_tree(&r, i == 0 ? 1 : 1000, 1001);
+
+        ret = cm_rbt_join(&l, &r);
+        ck_assert_int_eq(ret, 0);
+        _assert_tree(&l);
+        ck_assert_int_eq(l.size, 1001);
+
+        cm_del_rbt(&l);
+        cm_del_rbt(&r);
+    }
+
+    //third test: refuse to join overlapping trees
+    cm_new_rbt(&l, sizeof(d), sizeof(d), compare);
+    cm_new_rbt(&r, sizeof(d), sizeof(d), compare);
+    _fill_tree(&l, 0, 10);
+    _fill_tree(&r, 9, 20);
+
+    ret = cm_rbt_join(&l, &r);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARG);
+    ck_assert_int_eq(l.size, 10);
+    ck_assert_int_eq(r.size, 11);
+
+    cm_del_rbt(&l);
+    cm_del_rbt(&r);
+
+    //fourth test: refuse trees of different data sizes, even if empty
+    cm_new_rbt(&l, sizeof(d), sizeof(d) * 2, compare);
+    cm_new_rbt(&r, sizeof(d), sizeof(d), compare);
+    _fill_tree(&r, 0, 10);
+
+    ret = cm_rbt_join(&l, &r);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARG);
+    ck_assert_int_eq(l.size, 0);
+    ck_assert_int_eq(r.size, 10);
+
+    cm_del_rbt(&l);
+    cm_del_rbt(&r);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_rbt_uni(), cm_rbt_isc() & cm_rbt_dif() [no fixture]
+START_TEST(test_rbt_set_ops) {
+
+    int ret;
+    data k, v;
+    data * v_p;
+    cm_rbt a, b, c;
+
+
+    //build a = [0, 300) & b = every third key of [150, 600)
+    cm_new_rbt(&a, sizeof(d), sizeof(d), compare);
+    cm_new_rbt(&b, sizeof(d), sizeof(d), compare);
+    _fill_tree(&a, 0, 300);
+    for (k.x = 150; k.x < 600; k.x += 3) {
+        v.x = -k.x;
+        cm_rbt_set(&b, &k, &v);
+    }
+
+    //first test: intersection
+    cm_rbt_cpy(&c, &a);
+    ret = cm_rbt_isc(&c, &b);
+    ck_assert_int_eq(ret, 0);
+    _assert_tree(&c);
+    ck_assert_int_eq(c.size, 50);
+    for (k.x = 0; k.x < 600; ++k.x) {
+        v_p = cm_rbt_get_p(&c, &k);
+        if (k.x >= 150 && k.x < 300 && k.x % 3 == 0) {
+            ck_assert_ptr_nonnull(v_p);
+            ck_assert_int_eq(v_p->x, k.x);
+        } else {
+            ck_assert_ptr_null(v_p);
+        }
+    }
+    ck_assert_int_eq(b.size, 150);
+    cm_del_rbt(&c);
+
+    //second test: difference
+    cm_rbt_cpy(&c, &a);
+    ret = cm_rbt_dif(&c, &b);
+    ck_assert_int_eq(ret, 0);
+    _assert_tree(&c);
+    ck_assert_int_eq(c.size, 250);
+    for (k.x = 0; k.x < 300; ++k.x) {
+        v_p = cm_rbt_get_p(&c, &k);
+        if (k.x >= 150 && k.x % 3 == 0) ck_assert_ptr_null(v_p);
+        else ck_assert_ptr_nonnull(v_p);
+    }
+    cm_del_rbt(&c);
+
+    //third test: union, keeping the other tree's data on equal keys
+    ret = cm_rbt_uni(&a, &b);
+    ck_assert_int_eq(ret, 0);
+    _assert_tree(&a);
+    ck_assert_int_eq(a.size, 300 + 100);
+    ck_assert_int_eq(b.size, 0);
+    ck_assert_ptr_null(b.root);
+
+    k.x = 150;
+    ck_assert_int_eq(((data *) cm_rbt_get_p(&a, &k))->x, -150);
+    k.x = 151;
+    ck_assert_int_eq(((data *) cm_rbt_get_p(&a, &k))->x, 151);
+    k.x = 597;
+    ck_assert_int_eq(((data *) cm_rbt_get_p(&a, &k))->x, -597);
+
+    //fourth test: empty operands
+    ret = cm_rbt_uni(&b, &a);
+    ck_assert_int_eq(ret, 0);
+    _assert_tree(&b);
+    ck_assert_int_eq(b.size, 400);
+    ret = cm_rbt_isc(&b, &a);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(b.size, 0);
+    ck_assert_ptr_null(b.root);
+
+    //fifth test: every size builds a valid tree
+    for (int i = 1; i <= 64; ++i) {
+        cm_new_rbt(&c, sizeof(d), sizeof(d), compare);
+        _fill_tree(&c, 0, i);
+        cm_rbt_uni(&a, &c);
+        _assert_tree(&a);
+        cm_rbt_dif(&a, &a);
+        ck_assert_int_eq(a.size, 0);
+        cm_del_rbt(&c);
+    }
+
+    //sixth test: mismatched trees
+    cm_new_rbt(&c, sizeof(d) * 2, sizeof(d), compare);
+    ret = cm_rbt_uni(&a, &c);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARG);
+    cm_del_rbt(&c);
+
+    cm_new_rbt(&c, sizeof(d), sizeof(d) * 2, compare);
+    ret = cm_rbt_uni(&a, &c);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARG);
+    ret = cm_rbt_isc(&a, &c);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARG);
+
+    cm_del_rbt(&a);
+    cm_del_rbt(&b);
+    cm_del_rbt(&c);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_rbt_set_h() & cm_rbt_set_bat() [no fixture]
+START_TEST(test_rbt_set_hint) {
+
+    int ret;
+    data k, v, keys[1000], vals[1000];
+    data * v_p;
+    cm_rbt_node * node;
+
+
+    cm_new_rbt(&t, sizeof(d), sizeof(d), _count_compare);
+
+    //first test: sequential inserts from the last node
+    compares = 0;
+    node = NULL;
+    for (k.x = 0; k.x < 1000; ++k.x) {
+        node = cm_rbt_set_h(&t, node, &k, &k);
+        ck_assert_ptr_nonnull(node);
+    }
+    _assert_tree(&t);
+    ck_assert_int_eq(t.size, 1000);
+    ck_assert_int_le(compares, 2 * 1000);
+
+    //second test: scattered keys from an unrelated hint
+    cm_rbt_emp(&t);
+    _fill_tree(&t, 0, 500);
+    for (int i = 0; i < 1000; ++i) {
+        k.x = (i * 37) % 1000;
+        v.x = -k.x;
+        node = cm_rbt_set_h(&t, t.root, &k, &v);
+        ck_assert_int_eq(((data *) node->key)->x, k.x);
+        node = cm_rbt_set_h(&t, node, &k, &v);
+        ck_assert_int_eq(((data *) node->key)->x, k.x);
+    }
+    _assert_tree(&t);
+    ck_assert_int_eq(t.size, 1000);
+    for (k.x = 0; k.x < 1000; ++k.x) {
+        v_p = cm_rbt_get_p(&t, &k);
+        ck_assert_int_eq(v_p->x, -k.x);
+    }
+
+    //third test: near-sorted batch
+    cm_rbt_emp(&t);
+    for (int i = 0; i < 1000; ++i) {
+        keys[i].x = i % 100 == 99 ? i - 50 : i;
+        vals[i].x = i;
+    }
+    compares = 0;
+    ret = cm_rbt_set_bat(&t, keys, vals, 1000);
+    ck_assert_int_eq(ret, 0);
+    _assert_tree(&t);
+    ck_assert_int_eq(t.size, 990);
+    ck_assert_int_le(compares, 6 * 1000);
+
+    //equal keys keep the later entry
+    k.x = 49;
+    ck_assert_int_eq(((data *) cm_rbt_get_p(&t, &k))->x, 99);
+    k.x = 99;
+    ck_assert_ptr_null(cm_rbt_get_p(&t, &k));
+    ck_assert_int_eq(keys[99].x, 49);
+
+    //fourth test: shuffled batch into a non-empty tree
+    for (int i = 0; i < 1000; ++i) {
+        keys[i].x = 1000 + (i * 37) % 1000;
+        vals[i].x = -keys[i].x;
+    }
+    ret = cm_rbt_set_bat(&t, keys, vals, 1000);
+    ck_assert_int_eq(ret, 0);
+    _assert_tree(&t);
+    ck_assert_int_eq(t.size, 1990);
+    for (k.x = 1000; k.x < 2000; ++k.x) {
+        ck_assert_int_eq(((data *) cm_rbt_get_p(&t, &k))->x, -k.x);
+    }
+
+    cm_del_rbt(&t);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_new_rbt_k() [no fixture]
+START_TEST(test_new_rbt_k) {
+
+    int ret;
+    int32_t i32;
+    uint32_t u32;
+    int64_t i64;
+    uint64_t u64;
+    double f64;
+    char str[8];
+    cm_rbt u, v, w;
+
+
+    //first test: key sizes must match the kind
+    ret = cm_new_rbt_k(&u, CM_RBT_KEY_I32, sizeof(int64_t), sizeof(int));
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARG);
+    ret = cm_new_rbt_k(&u, CM_RBT_KEY_FN, sizeof(int), sizeof(int));
+    ck_assert_int_eq(ret, -1);
+    ret = cm_new_rbt_k(&u, CM_RBT_KEY_MEM, 0, sizeof(int));
+    ck_assert_int_eq(ret, -1);
+
+    //second test: signed 32-bit keys
+    ret = cm_new_rbt_k(&u, CM_RBT_KEY_I32, sizeof(i32), sizeof(i32));
+    ck_assert_int_eq(ret, 0);
+    ck_assert_ptr_null(u.compare);
+    for (int i = 0; i < 200; ++i) {
+        i32 = (i * 37) % 200 - 100;
+        cm_rbt_set(&u, &i32, &i32);
+    }
+    _assert_tree(&u);
+    ck_assert_int_eq(u.size, 200);
+    ck_assert_int_eq(*(int32_t *) _edge_node(&u, CM_RBT_LESS)->key, -100);
+
+    i32 = -5;
+    ck_assert_int_eq(*(int32_t *) cm_rbt_get_p(&u, &i32), -5);
+    i32 = -100;
+    ret = cm_rbt_rmv(&u, &i32);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(*(int32_t *) _edge_node(&u, CM_RBT_LESS)->key, -99);
+
+    //third test: copies & splits keep the kind, joins check it
+    cm_rbt_cpy(&v, &u);
+    ck_assert_int_eq(v.key_kind, CM_RBT_KEY_I32);
+    _assert_tree(&v);
+    cm_del_rbt(&v);
+
+    i32 = 0;
+    cm_rbt_split(&u, &i32, &v, &w);
+    ck_assert_int_eq(v.key_kind, CM_RBT_KEY_I32);
+    ck_assert_int_eq(w.key_kind, CM_RBT_KEY_I32);
+    ck_assert_int_eq(v.size, 99);
+    ck_assert_int_eq(w.size, 100);
+    cm_del_rbt(&u);
+    cm_rbt_mov(&u, &v);
+    cm_del_rbt(&w);
+
+    cm_new_rbt(&v, sizeof(d), sizeof(d), compare);
+    ret = cm_rbt_join(&u, &v);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ARG);
+    cm_del_rbt(&v);
+    cm_del_rbt(&u);
+
+    //fourth test: unsigned keys order above the signed range
+    cm_new_rbt_k(&u, CM_RBT_KEY_U32, sizeof(u32), sizeof(u32));
+    cm_new_rbt_k(&v, CM_RBT_KEY_U64, sizeof(u64), sizeof(u64));
+    for (uint32_t i = 0; i < 100; ++i) {
+        u32 = i % 2 == 0 ? i : 0x80000000u + i;
+        cm_rbt_set(&u, &u32, &u32);
+        u64 = i % 2 == 0 ? i : (1ull << 63) + i;
+        cm_rbt_set(&v, &u64, &u64);
+    }
+    ck_assert_uint_eq(*(uint32_t *) _edge_node(&u, CM_RBT_LESS)->key, 0);
+    ck_assert_uint_eq(*(uint32_t *) _edge_node(&u, CM_RBT_MORE)->key, 
+                      0x80000000u + 99);
+    ck_assert_uint_eq(*(uint64_t *) _edge_node(&v, CM_RBT_MORE)->key, 
+                      (1ull << 63) + 99);
+    cm_del_rbt(&u);
+    cm_del_rbt(&v);
+
+    //fifth test: signed 64-bit & double keys
+    cm_new_rbt_k(&u, CM_RBT_KEY_I64, sizeof(i64), sizeof(i64));
+    cm_new_rbt_k(&v, CM_RBT_KEY_F64, sizeof(f64), sizeof(f64));
+    for (int i = 0; i < 100; ++i) {
+        i64 = ((i * 37) % 100 - 50) * (1ll << 40);
+        cm_rbt_set(&u, &i64, &i64);
+        f64 = ((i * 37) % 100 - 50) * 0.5;
+        cm_rbt_set(&v, &f64, &f64);
+    }
+    ck_assert(*(int64_t *) _edge_node(&u, CM_RBT_LESS)->key == -50 * (1ll << 40));
+    ck_assert(*(double *) _edge_node(&v, CM_RBT_LESS)->key == -25.0);
+    f64 = 24.5;
+    ck_assert_ptr_nonnull(cm_rbt_get_p(&v, &f64));
+    f64 = 24.25;
+    ck_assert_ptr_null(cm_rbt_get_p(&v, &f64));
+    cm_del_rbt(&u);
+    cm_del_rbt(&v);
+
+    //sixth test: byte string keys
+    cm_new_rbt_k(&u, CM_RBT_KEY_MEM, sizeof(str), sizeof(int));
+    for (int i = 0; i < 100; ++i) {
+        ret = (i * 37) % 100;
+        snprintf(str, sizeof(str), "key%03d", ret);
+        cm_rbt_set(&u, str, &ret);
+    }
+    ck_assert_str_eq((char *) _edge_node(&u, CM_RBT_LESS)->key, "key000");
+    ck_assert_str_eq((char *) _edge_node(&u, CM_RBT_MORE)->key, "key099");
+    snprintf(str, sizeof(str), "key%03d", 42);
+    ck_assert_int_eq(*(int *) cm_rbt_get_p(&u, str), 42);
+    cm_del_rbt(&u);
+
+    return;
+
+} END_TEST
+
+
+
 //cm_del_rbt_node [no fixture]
 START_TEST(test_del_rbt_node) {
 
@@ -1505,9 +2127,7 @@ START_TEST(test_del_rbt_node) {
      */
         
     //setup test
-    cm_rbt_node * n = malloc(sizeof(cm_rbt_node));
-    n->key = malloc(sizeof(d));
-    n->data = malloc(sizeof(d));
+    cm_rbt_node * n = _new_stub_node();
     
     //only test:
     cm_del_rbt_node(n);
@@ -1551,6 +2171,11 @@ Suite * rbt_suite() {
     TCase * tc_rbt_cpy;
     TCase * tc_rbt_mov;
     TCase * tc_rbt_iter;
+    TCase * tc_rbt_iter_bat;
+    TCase * tc_rbt_split_join;
+    TCase * tc_rbt_set_ops;
+    TCase * tc_rbt_set_hint;
+    TCase * tc_new_rbt_k;
     TCase * tc_del_rbt_node;
 
     Suite * s = suite_create("rb_tree");
@@ -1684,6 +2309,26 @@ Suite * rbt_suite() {
     tcase_add_checked_fixture(tc_rbt_iter, _setup_sorted_stub, _teardown);
     tcase_add_test(tc_rbt_iter, test_rbt_iter);
 
+    //tc_rbt_iter_bat
+    tc_rbt_iter_bat = tcase_create("rb_tree_iter_bat");
+    tcase_add_test(tc_rbt_iter_bat, test_rbt_iter_bat);
+
+    //tc_rbt_split_join
+    tc_rbt_split_join = tcase_create("rb_tree_split_join");
+    tcase_add_test(tc_rbt_split_join, test_rbt_split_join);
+
+    //tc_rbt_set_ops
+    tc_rbt_set_ops = tcase_create("rb_tree_set_ops");
+    tcase_add_test(tc_rbt_set_ops, test_rbt_set_ops);
+
+    //tc_rbt_set_hint
+    tc_rbt_set_hint = tcase_create("rb_tree_set_hint");
+    tcase_add_test(tc_rbt_set_hint, test_rbt_set_hint);
+
+    //tc_new_rbt_k
+    tc_new_rbt_k = tcase_create("new_rbt_k");
+    tcase_add_test(tc_new_rbt_k, test_new_rbt_k);
+
     //tc_del_rbt_node
     tc_del_rbt_node = tcase_create("del_rbt_node");
     tcase_add_test(tc_del_rbt_node, test_del_rbt_node);
@@ -1721,6 +2366,11 @@ Suite * rbt_suite() {
     suite_add_tcase(s, tc_rbt_cpy);
     suite_add_tcase(s, tc_rbt_mov);
     suite_add_tcase(s, tc_rbt_iter);
+    suite_add_tcase(s, tc_rbt_iter_bat);
+    suite_add_tcase(s, tc_rbt_split_join);
+    suite_add_tcase(s, tc_rbt_set_ops);
+    suite_add_tcase(s, tc_rbt_set_hint);
+    suite_add_tcase(s, tc_new_rbt_k);
     suite_add_tcase(s, tc_del_rbt_node);
 
     return s;
@@ -0,0 +1,386 @@
+//standard library
+#include <stdint.h>
+
+//external libraries
+#include <check.h>
+
+//local headers
+#include "suites.h"
+
+//test target headers
+#include "../lib/cmore.h"
+#include "../lib/cmore_tmpl.h"
+
+
+
+/*
+ *  [BASIC TEST]
+ *
+ *     Generated types are checked against the
+ *     untyped containers they wrap.
+ */
+
+
+
+//reverse order, to tell the comparator is used
+#define _CMP_DESC(a, b) CM_TMPL_CMP(b, a)
+
+CM_DEFINE_VCT(int, int)
+CM_DEFINE_RBT(u64_int, uint64_t, int, CM_TMPL_CMP)
+CM_DEFINE_RBT(desc, int, int, _CMP_DESC)
+
+//pointer elements, to tell `const` binds to the pointer
+CM_DEFINE_VCT(str, char *)
+CM_DEFINE_RBT(u64_ptr, uint64_t, void *, CM_TMPL_CMP)
+
+//globals
+static cm_vct_int v;
+static cm_rbt_u64_int t;
+
+#define TMPL_KEYS 256
+
+
+
+/*
+ *  --- [HELPERS] ---
+ */
+
+//return the black height of a valid subtree, or -1
+static int _check(const cm_rbt_node * node, const uint64_t * min,
+                  const uint64_t * max, int * count) {
+
+    int left, right;
+    uint64_t key;
+
+
+    if (node == NULL) return 1;
+
+    key = *(uint64_t *) node->key;
+    if (min != NULL && key <= *min) return -1;
+    if (max != NULL && key >= *max) return -1;
+
+    if (CM_RBT_COLOUR(node) == CM_RBT_RED) {
+        if (node->left != NULL
+            && CM_RBT_COLOUR(node->left) == CM_RBT_RED) return -1;
+        if (node->right != NULL
+            && CM_RBT_COLOUR(node->right) == CM_RBT_RED) return -1;
+    }
+
+    left  = _check(node->left, min, &key, count);
+    right = _check(node->right, &key, max, count);
+    if (left == -1 || left != right) return -1;
+
+    ++*count;
+
+    return left + (CM_RBT_COLOUR(node) == CM_RBT_BLACK ? 1 : 0);
+}
+
+
+
+static void _assert_tree(const cm_rbt_u64_int * tree) {
+
+    int count = 0;
+
+
+    ck_assert_int_ne(_check(tree->tree.root, NULL, NULL, &count), -1);
+    ck_assert_int_eq(count, tree->tree.size);
+
+    return;
+}
+
+
+
+/*
+ *  --- [FIXTURES] ---
+ */
+
+static void _setup_vct() {
+
+    int ret;
+
+
+    ret = cm_new_vct_int(&v);
+
+    return;
+}
+
+
+
+static void _teardown_vct() {
+
+    cm_del_vct_int(&v);
+
+    return;
+}
+
+
+
+static void _setup_rbt() {
+
+    cm_new_rbt_u64_int(&t);
+
+    return;
+}
+
+
+
+static void _teardown_rbt() {
+
+    cm_del_rbt_u64_int(&t);
+
+    return;
+}
+
+
+
+/*
+ *  --- [UNIT TESTS] ---
+ */
+
+//CM_DEFINE_VCT() [vector fixture]
+START_TEST(test_tmpl_vct) {
+
+    int ret, x;
+    int * x_p;
+    cm_vct_int u;
+
+
+    //first test: the element size is the type's
+    ck_assert_int_eq(v.vct.data_sz, sizeof(int));
+
+    //second test: append past the first allocation
+    for (x = 0; x < 100; ++x) {
+        ret = cm_vct_int_apd(&v, &x);
+        ck_assert_int_eq(ret, 0);
+    }
+    ck_assert_int_eq(v.vct.len, 100);
+
+    for (int i = 0; i < 100; ++i) {
+        ret = cm_vct_int_get(&v, i, &x);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(x, i);
+        ck_assert_int_eq(*(int *) cm_vct_get_p(&v.vct, i), i);
+    }
+
+    ck_assert_ptr_eq(cm_vct_int_get_u(&v, 7), cm_vct_int_get_p(&v, 7));
+
+    //third test: negative indices count from the end
+    x_p = cm_vct_int_get_p(&v, -1);
+    ck_assert_int_eq(*x_p, 99);
+
+    x = -5;
+    ret = cm_vct_int_set(&v, -2, &x);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(*cm_vct_int_get_p(&v, 98), -5);
+
+    //fourth test: out of range
+    x_p = cm_vct_int_get_p(&v, 100);
+    ck_assert_ptr_null(x_p);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    ret = cm_vct_int_set(&v, -101, &x);
+    ck_assert_int_eq(ret, -1);
+
+    //fifth test: insert & remove go through the library
+    x = -1;
+    ret = cm_vct_int_ins(&v, 0, &x);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(*cm_vct_int_get_p(&v, 0), -1);
+    ck_assert_int_eq(*cm_vct_int_get_p(&v, 1), 0);
+
+    ret = cm_vct_int_rmv(&v, 0);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(*cm_vct_int_get_p(&v, 0), 0);
+
+    //sixth test: copy
+    ret = cm_vct_int_cpy(&u, &v);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(u.vct.len, 100);
+    ck_assert_int_eq(*cm_vct_int_get_p(&u, 50), 50);
+    cm_del_vct_int(&u);
+
+    //seventh test: empty
+    cm_vct_int_emp(&v);
+    ck_assert_int_eq(v.vct.len, 0);
+
+    return;
+
+} END_TEST
+
+
+
+//CM_DEFINE_RBT() [tree fixture]
+START_TEST(test_tmpl_rbt) {
+
+    int ret, x;
+    int * x_p;
+    uint64_t key;
+    cm_rbt_node * node;
+    cm_rbt_desc w;
+
+
+    //first test: insert in a scattered order
+    for (int i = 0; i < TMPL_KEYS; ++i) {
+        key = ((uint64_t) i * 37) % TMPL_KEYS;
+        x = (int) key * 2;
+        node = cm_rbt_u64_int_set(&t, &key, &x);
+        ck_assert_ptr_nonnull(node);
+    }
+    _assert_tree(&t);
+    ck_assert_int_eq(t.tree.size, TMPL_KEYS);
+
+    for (key = 0; key < TMPL_KEYS; ++key) {
+        ret = cm_rbt_u64_int_get(&t, &key, &x);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(x, (int) key * 2);
+    }
+
+    //second test: the untyped functions find the same nodes
+    key = 10;
+    ck_assert_ptr_eq(cm_rbt_get_n(&t.tree, &key),
+                     cm_rbt_u64_int_get_n(&t, &key));
+
+    //third test: set an existing key
+    x = -1;
+    node = cm_rbt_u64_int_set(&t, &key, &x);
+    ck_assert_ptr_eq(node, cm_rbt_u64_int_get_n(&t, &key));
+    ck_assert_int_eq(*cm_rbt_u64_int_get_p(&t, &key), -1);
+    ck_assert_int_eq(t.tree.size, TMPL_KEYS);
+
+    //fourth test: missing key
+    key = TMPL_KEYS;
+    x_p = cm_rbt_u64_int_get_p(&t, &key);
+    ck_assert_ptr_null(x_p);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+
+    //fifth test: remove every other key
+    for (key = 0; key < TMPL_KEYS; key += 2) {
+        ret = cm_rbt_u64_int_rmv(&t, &key);
+        ck_assert_int_eq(ret, 0);
+    }
+    _assert_tree(&t);
+    ck_assert_int_eq(t.tree.size, TMPL_KEYS / 2);
+
+    for (key = 0; key < TMPL_KEYS; ++key) {
+        ret = cm_rbt_u64_int_get(&t, &key, &x);
+        ck_assert_int_eq(ret, key % 2 == 0 ? -1 : 0);
+    }
+
+    //sixth test: the comparator orders the tree
+    cm_new_rbt_desc(&w);
+    for (x = 0; x < 10; ++x) cm_rbt_desc_set(&w, &x, &x);
+
+    ck_assert_int_eq(*(int *) cm_rbt_idx_get_p(&w.tree, 0), 9);
+    ck_assert_int_eq(*(int *) cm_rbt_idx_get_p(&w.tree, 9), 0);
+
+    cm_del_rbt_desc(&w);
+
+    return;
+
+} END_TEST
+
+
+
+//CM_DEFINE_VCT() & CM_DEFINE_RBT() with pointer types [no fixture]
+START_TEST(test_tmpl_ptr) {
+
+    int ret;
+    uint64_t key;
+    char buf[] = "cmore";
+    char * str, * str_out;
+    void * ptr, * ptr_out;
+    cm_vct_str s;
+    cm_rbt_u64_ptr p;
+    cm_rbt_node * node;
+
+
+    //first test: a vector of mutable pointers
+    ret = cm_new_vct_str(&s);
+    ck_assert_int_eq(ret, 0);
+
+    str = buf;
+    ret = cm_vct_str_apd(&s, &str);
+    ck_assert_int_eq(ret, 0);
+    ret = cm_vct_str_ins(&s, 0, &str);
+    ck_assert_int_eq(ret, 0);
+
+    str = buf + 1;
+    ret = cm_vct_str_set(&s, 1, &str);
+    ck_assert_int_eq(ret, 0);
+
+    ret = cm_vct_str_get(&s, 0, &str_out);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_ptr_eq(str_out, buf);
+    ck_assert_ptr_eq(*cm_vct_str_get_p(&s, 1), buf + 1);
+
+    //the element stays writable through the pointer
+    (*cm_vct_str_get_p(&s, 0))[0] = 'C';
+    ck_assert_str_eq(buf, "Cmore");
+
+    cm_del_vct_str(&s);
+
+    //second test: a tree of mutable pointers
+    cm_new_rbt_u64_ptr(&p);
+
+    for (key = 0; key < 10; ++key) {
+        ptr = buf + key % sizeof(buf);
+        node = cm_rbt_u64_ptr_set(&p, &key, &ptr);
+        ck_assert_ptr_nonnull(node);
+    }
+    ck_assert_int_eq(p.tree.size, 10);
+
+    key = 3;
+    ret = cm_rbt_u64_ptr_get(&p, &key, &ptr_out);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_ptr_eq(ptr_out, buf + 3);
+    ck_assert_ptr_eq(*cm_rbt_u64_ptr_get_p(&p, &key), buf + 3);
+    ck_assert_ptr_eq(cm_rbt_u64_ptr_get_n(&p, &key),
+                     cm_rbt_get_n(&p.tree, &key));
+
+    ret = cm_rbt_u64_ptr_rmv(&p, &key);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(p.tree.size, 9);
+
+    cm_del_rbt_u64_ptr(&p);
+
+    return;
+
+} END_TEST
+
+
+
+/*
+ *  --- [SUITE] ---
+ */
+
+Suite * tmpl_suite() {
+
+    //test cases
+    TCase * tc_tmpl_vct;
+    TCase * tc_tmpl_rbt;
+    TCase * tc_tmpl_ptr;
+
+    Suite * s = suite_create("typed containers");
+
+
+    //CM_DEFINE_VCT()
+    tc_tmpl_vct = tcase_create("tmpl_vct");
+    tcase_add_checked_fixture(tc_tmpl_vct, _setup_vct, _teardown_vct);
+    tcase_add_test(tc_tmpl_vct, test_tmpl_vct);
+
+    //CM_DEFINE_RBT()
+    tc_tmpl_rbt = tcase_create("tmpl_rbt");
+    tcase_add_checked_fixture(tc_tmpl_rbt, _setup_rbt, _teardown_rbt);
+    tcase_add_test(tc_tmpl_rbt, test_tmpl_rbt);
+
+    //CM_DEFINE_VCT() & CM_DEFINE_RBT() with pointer types
+    tc_tmpl_ptr = tcase_create("tmpl_ptr");
+    tcase_add_test(tc_tmpl_ptr, test_tmpl_ptr);
+
+    //add test cases to typed container suite
+    suite_add_tcase(s, tc_tmpl_vct);
+    suite_add_tcase(s, tc_tmpl_rbt);
+    suite_add_tcase(s, tc_tmpl_ptr);
+
+    return s;
+}
@@ -2,6 +2,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 //system headers
 #include <unistd.h>
@@ -113,6 +114,99 @@ static int _assert_callback(const void * data, void * ctx) {
 
 
 
+//assert spans arrive in order & record their lengths
+struct _assert_span_ctx {
+
+    int next;
+    int calls;
+    int lens[16];
+};
+
+static int _assert_span(const void * data, const int len, void * ctx) {
+
+    struct _assert_span_ctx * real_ctx = ctx;
+
+
+    for (int i = 0; i < len; ++i) {
+        ck_assert_int_eq(((const int *) data)[i], real_ctx->next);
+        real_ctx->next += 1;
+    }
+    real_ctx->lens[real_ctx->calls++] = len;
+
+    return 0;
+}
+
+
+
+static int _fail_span(__attribute__((unused)) const void * data,
+                      __attribute__((unused)) const int len,
+                      __attribute__((unused)) void * ctx) {
+
+    return -1;
+}
+
+
+
+//count visits of each element of an index-valued vector
+static int _count_callback(const void * data, void * ctx) {
+
+    __atomic_add_fetch(((int *) ctx) + *(int *) data, 1, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+
+
+static int _fail_callback(const void * data,
+                          __attribute__((unused)) void * ctx) {
+
+    return *(int *) data == 5000 ? -1 : 0;
+}
+
+
+
+//contiguous run of an index-valued vector
+struct _run {
+
+    int first;
+    int last;
+    long long sum;
+};
+
+static int _run_map(const void * data, void * partial,
+                    __attribute__((unused)) void * ctx) {
+
+    struct _run * run = partial;
+    int value = *(int *) data;
+
+
+    //elements of a chunk are visited in order
+    if (run->last != -1 && value != run->last + 1) return -1;
+    if (run->first == -1) run->first = value;
+    run->last = value;
+    run->sum += value;
+
+    return 0;
+}
+
+static int _run_combine(void * acc, const void * partial, void * ctx) {
+
+    struct _run * run = acc;
+    const struct _run * part = partial;
+
+
+    //chunks are combined in order
+    if (run->last != -1 && part->first != run->last + 1) return -1;
+    if (run->first == -1) run->first = part->first;
+    run->last = part->last;
+    run->sum += part->sum;
+    ++*(int *) ctx;
+
+    return 0;
+}
+
+
+
 /*
  *  --- [FIXTURES] ---
  */
@@ -339,6 +433,35 @@ START_TEST(test_vct_get_p) {
 
 
 
+//cm_vct_get_u() & cm_vct_dat() [full fixture]
+START_TEST(test_vct_get_u) {
+
+    int len;
+    data * p;
+
+
+    //first test: get every vector entry by address, unchecked
+    for (int i = 0; i < TEST_LEN_FULL; ++i) {
+
+        p = (data *) cm_vct_get_u(&v, i);
+        ck_assert_ptr_eq(p, cm_vct_get_p(&v, i));
+        ck_assert_int_eq(p->x, i);
+
+    } //end for
+
+
+    //second test: get the data pointer & length
+    p = (data *) cm_vct_dat(&v, &len);
+    ck_assert_ptr_eq(p, v.data);
+    ck_assert_int_eq(len, TEST_LEN_FULL);
+    ck_assert_int_eq(p[TEST_LEN_FULL - 1].x, TEST_LEN_FULL - 1);
+
+    return;
+
+} END_TEST
+
+
+
 //cm_vct_set() [full fixture]
 START_TEST(test_vct_set) {
 
@@ -768,6 +891,254 @@ START_TEST(test_vct_iter) {
 
 
 
+//cm_vct_iter_spn() [full fixture]
+START_TEST(test_vct_iter_spn) {
+
+    int ret;
+    struct _assert_span_ctx ctx;
+
+
+    //first test: spans of 3 elements, the last one short
+    ctx = (struct _assert_span_ctx) {0};
+    ret = cm_vct_iter_spn(&v, _assert_span, &ctx, 3);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(ctx.calls, 4);
+    ck_assert_int_eq(ctx.lens[0], 3);
+    ck_assert_int_eq(ctx.lens[3], 1);
+
+    //second test: the whole vector in one span
+    ctx = (struct _assert_span_ctx) {0};
+    ret = cm_vct_iter_spn(&v, _assert_span, &ctx, 0);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(ctx.calls, 1);
+    ck_assert_int_eq(ctx.lens[0], 10);
+
+    //third test: a failing callback fails the call
+    ret = cm_vct_iter_spn(&v, _fail_span, NULL, 3);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_CALLBACK);
+
+    return;
+
+} END_TEST
+
+
+
+#define PAR_LEN 10000
+
+
+
+//cm_vct_iter_par() [no fixture]
+START_TEST(test_vct_iter_par) {
+
+    int ret;
+    int * counts;
+    cm_vct u;
+
+
+    counts = calloc(PAR_LEN, sizeof(int));
+    cm_new_vct(&u, sizeof(int));
+    for (int i = 0; i < PAR_LEN; ++i) cm_vct_apd(&u, &i);
+
+    //first test: every element is visited once
+    ret = cm_vct_iter_par(&u, _count_callback, counts, 64);
+    ck_assert_int_eq(ret, 0);
+    for (int i = 0; i < PAR_LEN; ++i) ck_assert_int_eq(counts[i], 1);
+
+    //second test: a grain larger than the vector runs serially
+    ret = cm_vct_iter_par(&u, _count_callback, counts, PAR_LEN);
+    ck_assert_int_eq(ret, 0);
+    for (int i = 0; i < PAR_LEN; ++i) ck_assert_int_eq(counts[i], 2);
+
+    //third test: a failing callback fails the call
+    ret = cm_vct_iter_par(&u, _fail_callback, NULL, 64);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_CALLBACK);
+
+    cm_del_vct(&u);
+    free(counts);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_vct_rdc_par() [no fixture]
+START_TEST(test_vct_rdc_par) {
+
+    int ret, combines;
+    struct _run acc;
+    cm_vct u;
+
+
+    cm_new_vct(&u, sizeof(int));
+    for (int i = 0; i < PAR_LEN; ++i) cm_vct_apd(&u, &i);
+
+    //first test: chunks are folded & combined in order
+    acc = (struct _run) {-1, -1, 0};
+    combines = 0;
+    ret = cm_vct_rdc_par(&u, &acc, sizeof(acc),
+                         _run_map, _run_combine, &combines, 64);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_gt(combines, 1);
+    ck_assert_int_eq(acc.first, 0);
+    ck_assert_int_eq(acc.last, PAR_LEN - 1);
+    ck_assert_int_eq(acc.sum, (long long) PAR_LEN * (PAR_LEN - 1) / 2);
+
+    //second test: a grain larger than the vector runs serially
+    acc = (struct _run) {-1, -1, 0};
+    combines = 0;
+    ret = cm_vct_rdc_par(&u, &acc, sizeof(acc),
+                         _run_map, _run_combine, &combines, PAR_LEN);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(combines, 0);
+    ck_assert_int_eq(acc.sum, (long long) PAR_LEN * (PAR_LEN - 1) / 2);
+
+    //third test: a non-identity accumulator breaks the map callback
+    acc = (struct _run) {-1, 5, 0};
+    ret = cm_vct_rdc_par(&u, &acc, sizeof(acc),
+                         _run_map, _run_combine, &combines, 64);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_CALLBACK);
+
+    cm_del_vct(&u);
+
+    return;
+
+} END_TEST
+
+
+
+//element sizes with kernels, & one without
+static const size_t kern_szs[] = {1, 2, 4, 8, 12};
+#define KERN_SZS_NUM (sizeof(kern_szs) / sizeof(kern_szs[0]))
+#define KERN_LEN 100
+
+
+
+//cm_vct_fnd() [no fixture]
+START_TEST(test_vct_fnd) {
+
+    int ret;
+    cm_vct w;
+    cm_byte elem[12];
+    enum cm_cpu_lvl max_lvl = cm_cpu_get();
+
+
+    //every test is repeated for every instruction set & element size
+    for (int lvl = CM_CPU_SCALAR; lvl <= (int) max_lvl; ++lvl) {
+
+        ret = cm_cpu_set((enum cm_cpu_lvl) lvl);
+        ck_assert_int_eq(ret, 0);
+
+        for (size_t s = 0; s < KERN_SZS_NUM; ++s) {
+
+            //element i has every byte set to i + 1
+            ret = cm_new_vct(&w, kern_szs[s]);
+            ck_assert_int_eq(ret, 0);
+            for (int i = 0; i < KERN_LEN; ++i) {
+                memset(elem, i + 1, kern_szs[s]);
+                ret = cm_vct_apd(&w, elem);
+                ck_assert_int_eq(ret, 0);
+            }
+
+            //first test: find the first, a middle & the last element
+            memset(elem, 1, kern_szs[s]);
+            ck_assert_int_eq(cm_vct_fnd(&w, elem), 0);
+            memset(elem, 38, kern_szs[s]);
+            ck_assert_int_eq(cm_vct_fnd(&w, elem), 37);
+            memset(elem, KERN_LEN, kern_szs[s]);
+            ck_assert_int_eq(cm_vct_fnd(&w, elem), KERN_LEN - 1);
+
+            //second test: a partial match is not a match
+            memset(elem, 38, kern_szs[s]);
+            elem[kern_szs[s] - 1] = 39;
+            ret = cm_vct_fnd(&w, elem);
+            ck_assert_int_eq(ret, kern_szs[s] == 1 ? 38 : -1);
+
+            //third test: value is not present
+            memset(elem, 0, kern_szs[s]);
+            ret = cm_vct_fnd(&w, elem);
+            ck_assert_int_eq(ret, -1);
+            ck_assert_int_eq(cm_errno, CM_ERR_USER_VALUE);
+
+            //fourth test: return the first of several matches
+            memset(elem, 38, kern_szs[s]);
+            ret = cm_vct_set(&w, 70, elem);
+            ck_assert_int_eq(ret, 0);
+            ck_assert_int_eq(cm_vct_fnd(&w, elem), 37);
+
+            cm_del_vct(&w);
+        }
+    }
+
+    ret = cm_cpu_set(max_lvl);
+    ck_assert_int_eq(ret, 0);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_vct_fil() [no fixture]
+START_TEST(test_vct_fil) {
+
+    int ret;
+    cm_vct w;
+    cm_byte elem[12];
+    enum cm_cpu_lvl max_lvl = cm_cpu_get();
+
+
+    //every test is repeated for every instruction set & element size
+    for (int lvl = CM_CPU_SCALAR; lvl <= (int) max_lvl; ++lvl) {
+
+        ret = cm_cpu_set((enum cm_cpu_lvl) lvl);
+        ck_assert_int_eq(ret, 0);
+
+        for (size_t s = 0; s < KERN_SZS_NUM; ++s) {
+
+            ret = cm_new_vct(&w, kern_szs[s]);
+            ck_assert_int_eq(ret, 0);
+
+            //first test: fill an empty vector
+            for (size_t j = 0; j < kern_szs[s]; ++j) elem[j] = j + 1;
+            cm_vct_fil(&w, elem);
+            ck_assert_int_eq(w.len, 0);
+
+            //second test: fill every element, but not spare capacity
+            memset(elem, 0, kern_szs[s]);
+            for (int i = 0; i < KERN_LEN; ++i) {
+                ret = cm_vct_apd(&w, elem);
+                ck_assert_int_eq(ret, 0);
+            }
+            memset((cm_byte *) w.data + (w.data_sz * w.len), 0xff, 
+                   w.data_sz * (w.sz - w.len));
+
+            for (size_t j = 0; j < kern_szs[s]; ++j) elem[j] = j + 1;
+            cm_vct_fil(&w, elem);
+
+            for (int i = 0; i < KERN_LEN; ++i) {
+                ck_assert_int_eq(memcmp(cm_vct_get_p(&w, i), 
+                                        elem, kern_szs[s]), 0);
+            }
+            ck_assert_int_eq(*((cm_byte *) w.data + (w.data_sz * w.len)),
+                             0xff);
+
+            cm_del_vct(&w);
+        }
+    }
+
+    ret = cm_cpu_set(max_lvl);
+    ck_assert_int_eq(ret, 0);
+
+    return;
+
+} END_TEST
+
+
+
 /*
  *  --- [SUITE] ---
  */
@@ -780,6 +1151,7 @@ Suite * vct_suite() {
     TCase * tc__grow;
     TCase * tc_vct_get;
     TCase * tc_vct_get_p;
+    TCase * tc_vct_get_u;
     TCase * tc_vct_set;
     TCase * tc_vct_ins;
     TCase * tc_vct_rmv;
@@ -789,6 +1161,11 @@ Suite * vct_suite() {
     TCase * tc_vct_cpy;
     TCase * tc_vct_mov;
     TCase * tc_vct_iter;
+    TCase * tc_vct_iter_spn;
+    TCase * tc_vct_iter_par;
+    TCase * tc_vct_rdc_par;
+    TCase * tc_vct_fnd;
+    TCase * tc_vct_fil;
 
     Suite * s = suite_create("vector");
     
@@ -817,6 +1194,11 @@ Suite * vct_suite() {
     tcase_add_checked_fixture(tc_vct_get_p, _setup_full, _teardown);
     tcase_add_test(tc_vct_get_p, test_vct_get_p);
 
+    //cm_vct_get_u()
+    tc_vct_get_u = tcase_create("vector_get_u");
+    tcase_add_checked_fixture(tc_vct_get_u, _setup_full, _teardown);
+    tcase_add_test(tc_vct_get_u, test_vct_get_u);
+
     //cm_vct_set()
     tc_vct_set = tcase_create("vector_set");
     tcase_add_checked_fixture(tc_vct_set, _setup_full, _teardown);
@@ -862,6 +1244,27 @@ Suite * vct_suite() {
     tcase_add_checked_fixture(tc_vct_iter, _setup_full, _teardown);
     tcase_add_test(tc_vct_iter, test_vct_iter);
 
+    //cm_vct_iter_spn()
+    tc_vct_iter_spn = tcase_create("vector_iter_spn");
+    tcase_add_checked_fixture(tc_vct_iter_spn, _setup_full, _teardown);
+    tcase_add_test(tc_vct_iter_spn, test_vct_iter_spn);
+
+    //cm_vct_iter_par()
+    tc_vct_iter_par = tcase_create("vector_iter_par");
+    tcase_add_test(tc_vct_iter_par, test_vct_iter_par);
+
+    //cm_vct_rdc_par()
+    tc_vct_rdc_par = tcase_create("vector_rdc_par");
+    tcase_add_test(tc_vct_rdc_par, test_vct_rdc_par);
+
+    //cm_vct_fnd()
+    tc_vct_fnd = tcase_create("vector_fnd");
+    tcase_add_test(tc_vct_fnd, test_vct_fnd);
+
+    //cm_vct_fil()
+    tc_vct_fil = tcase_create("vector_fil");
+    tcase_add_test(tc_vct_fil, test_vct_fil);
+
 
     //add test cases to vector suite
     suite_add_tcase(s, tc_new_del_vct);
@@ -869,6 +1272,7 @@ Suite * vct_suite() {
     suite_add_tcase(s, tc__grow);
     suite_add_tcase(s, tc_vct_get);
     suite_add_tcase(s, tc_vct_get_p);
+    suite_add_tcase(s, tc_vct_get_u);
     suite_add_tcase(s, tc_vct_set);
     suite_add_tcase(s, tc_vct_ins);
     suite_add_tcase(s, tc_vct_rmv);
@@ -878,6 +1282,11 @@ Suite * vct_suite() {
     suite_add_tcase(s, tc_vct_cpy);
     suite_add_tcase(s, tc_vct_mov);
     suite_add_tcase(s, tc_vct_iter);
+    suite_add_tcase(s, tc_vct_iter_spn);
+    suite_add_tcase(s, tc_vct_iter_par);
+    suite_add_tcase(s, tc_vct_rdc_par);
+    suite_add_tcase(s, tc_vct_fnd);
+    suite_add_tcase(s, tc_vct_fil);
 
     return s;
 }
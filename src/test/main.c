@@ -55,9 +55,18 @@ static void _run_unit_tests() {
 
     Suite * s_vct;
     Suite * s_lst;
+    Suite * s_deq;
     Suite * s_rbt;
+    Suite * s_crbt;
+    Suite * s_prbt;
+    Suite * s_heap;
     Suite * s_alg;
     Suite * s_func;
+    Suite * s_arena;
+    Suite * s_que;
+    Suite * s_pool;
+    Suite * s_epoch;
+    Suite * s_tmpl;
     Suite * s_error;
 
     SRunner * sr;
@@ -65,16 +74,34 @@ static void _run_unit_tests() {
     //initialise test suites
     s_vct  = vct_suite();
     s_lst  = lst_suite();
+    s_deq  = deq_suite();
     s_rbt  = rbt_suite(); 
+    s_crbt = crbt_suite();
+    s_prbt = prbt_suite();
+    s_heap = heap_suite();
     s_alg  = alg_suite();
     s_func = func_suite();
+    s_arena = arena_suite();
+    s_que   = que_suite();
+    s_pool  = pool_suite();
+    s_epoch = epoch_suite();
+    s_tmpl  = tmpl_suite();
 
     //create suite runner
     sr = srunner_create(s_vct);
     srunner_add_suite(sr, s_lst);
+    srunner_add_suite(sr, s_deq);
     srunner_add_suite(sr, s_rbt);
+    srunner_add_suite(sr, s_crbt);
+    srunner_add_suite(sr, s_prbt);
+    srunner_add_suite(sr, s_heap);
     srunner_add_suite(sr, s_alg);
     srunner_add_suite(sr, s_func);
+    srunner_add_suite(sr, s_arena);
+    srunner_add_suite(sr, s_que);
+    srunner_add_suite(sr, s_pool);
+    srunner_add_suite(sr, s_epoch);
+    srunner_add_suite(sr, s_tmpl);
 
     //run tests
     srunner_run_all(sr, CK_VERBOSE);
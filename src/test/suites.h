@@ -8,9 +8,18 @@
 //unit test suites
 Suite * lst_suite();
 Suite * vct_suite();
+Suite * deq_suite();
 Suite * rbt_suite();
+Suite * crbt_suite();
+Suite * prbt_suite();
+Suite * heap_suite();
 Suite * alg_suite();
 Suite * func_suite();
+Suite * arena_suite();
+Suite * que_suite();
+Suite * pool_suite();
+Suite * epoch_suite();
+Suite * tmpl_suite();
 
 //other tests
 void rbt_explore();